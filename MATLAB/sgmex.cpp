@@ -21,8 +21,9 @@
 #include <fstream>
 #include <string>
 #include <cmath>
+#include <chrono>
 #include "sgsolution.hpp"
-#include "sgapprox.hpp"
+#include "sgsolver.hpp"
 #include "sgsimulator.hpp"
 
 SGSolution soln;
@@ -219,38 +220,21 @@ void mexFunction(int nlhs, mxArray *plhs[],
 	    mexErrMsgTxt("Unable to create game.");
 
 	  SGEnv env;
+	  // Progress is printed below with mexPrintf, so the library's
+	  // own printing to cout is off unless asked for.
+	  env.setParam(SG::PRINTTOCOUT,false);
 
 	  vector<bool> unconstrained(2,false);
+	  bool printProgress = true;
+	  double progressInterval = 0;
 
 	  for (int k=5; k<nrhs; k+=2)
 	    {
 	      paramStr = mxArrayToString(prhs[k]);
-	      if (nrhs<k+1)
-		break;
+	      if (nrhs<k+2)
+		mexErrMsgTxt("Each parameter name must be followed by a value.");
 				
-	      if (!strcmp(paramStr,"errorTol"))
-		env.setParam(SG::ERRORTOL,mxGetScalar(prhs[k+1]));
-	      else if (!strcmp(paramStr,"directionTol"))
-		env.setParam(SG::DIRECTIONTOL,mxGetScalar(prhs[k+1]));
-	      else if (!strcmp(paramStr,"pastThreatTol"))
-		env.setParam(SG::PASTTHREATTOL,mxGetScalar(prhs[k+1]));
-	      else if (!strcmp(paramStr,"updatePivotTol"))
-		env.setParam(SG::UPDATEPIVOTTOL,mxGetScalar(prhs[k+1]));
-	      else if (!strcmp(paramStr,"ICTol"))
-		env.setParam(SG::ICTOL,mxGetScalar(prhs[k+1]));
-	      else if (!strcmp(paramStr,"normTol"))
-		env.setParam(SG::NORMTOL,mxGetScalar(prhs[k+1]));
-	      else if (!strcmp(paramStr,"flatTol"))
-		env.setParam(SG::FLATTOL,mxGetScalar(prhs[k+1]));
-	      else if (!strcmp(paramStr,"levelTol"))
-		env.setParam(SG::LEVELTOL,mxGetScalar(prhs[k+1]));
-	      else if (!strcmp(paramStr,"improveTol"))
-		env.setParam(SG::IMPROVETOL,mxGetScalar(prhs[k+1]));
-	      else if (!strcmp(paramStr,"backBendingTol"))
-		env.setParam(SG::BACKBENDINGTOL,mxGetScalar(prhs[k+1]));
-	      else if (!strcmp(paramStr,"movementTol"))
-		env.setParam(SG::MOVEMENTTOL,mxGetScalar(prhs[k+1]));
-	      else if (!strcmp(paramStr,"unconstrained"))
+	      if (!strcmp(paramStr,"unconstrained"))
 		{
 		  mxLogical *unconstrPtr = mxGetLogicals(prhs[k+1]);
 		  if (!mxIsLogical(prhs[k+1]))
@@ -262,29 +246,47 @@ void mexFunction(int nlhs, mxArray *plhs[],
 
 		  game.setConstrained(unconstrained);
 		}
+	      else if (!strcmp(paramStr,"printProgress"))
+		printProgress = (mxGetScalar(prhs[k+1]) != 0);
+	      else if (!strcmp(paramStr,"progressInterval"))
+		progressInterval = mxGetScalar(prhs[k+1]);
+	      else
+		{
+		  try
+		    {
+		      env.setParam(string(paramStr),mxGetScalar(prhs[k+1]));
+		    }
+		  catch (SGException & e)
+		    {
+		      string msg = string("Invalid parameter or value: ")
+			+ string(paramStr);
+		      mexErrMsgTxt(msg.c_str());
+		    }
+		}
 	    }
 
-	  env.setParam(SG::PRINTTOCOUT,true);
-	  env.setParam(SG::STOREITERATIONS,true);
-
-	  soln = SGSolution(game);
-	  SGApprox approx(env,game,soln);
-
-	  approx.initialize();
+	  std::chrono::steady_clock::time_point lastProgress
+	    = std::chrono::steady_clock::now();
+	  auto progress = [&](const SGApprox & approx)
+	    {
+	      std::chrono::steady_clock::time_point now
+		= std::chrono::steady_clock::now();
+	      if (printProgress
+		  && std::chrono::duration<double>(now-lastProgress).count()
+		  >= progressInterval)
+		{
+		  string str = approx.progressString();
+		  mexPrintf("%s\n",str.c_str());
+		  mexEvalString("drawnow;");
+		  lastProgress = now;
+		}
+	      return true;
+	    };
 
+	  SGSolver solver(env,game);
 	  try
 	    {
-	      while (approx.generate() > env.getParam(SG::ERRORTOL)
-		     && approx.getNumIterations() < env.getParam(SG::MAXITERATIONS))
-		{
-		  if (approx.passedNorth())
-		    {
-		      string str = approx.progressString();
-		      mexPrintf(str.c_str());
-		      mexPrintf("\n");
-		      mexEvalString("drawnow;");
-		    }
-		};
+	      solver.solve(progress);
 	    }
 	  catch (SGException & e)
 	    {
@@ -295,28 +297,16 @@ void mexFunction(int nlhs, mxArray *plhs[],
 	      else
 		throw;
 	    }
-
-	  // Add the extreme tuples array to soln.
-	  for (vector<SGTuple>::const_iterator tuple
-		 = approx.getExtremeTuples().begin();
-	       tuple != approx.getExtremeTuples().end();
-	       ++tuple)
-	    soln.push_back(*tuple);
-
-	  approx.end();
-
-	  // SGSolver solver(env,game);
-
-	  // solver.solve();
+	  soln = solver.getSolution();
 	  
 	  mexPrintf("Game solved.\n");
 	  mexEvalString("drawnow;");
 
-	  // soln = solver.getSolution();
 	  solnLoaded = true;
 
 	  currentIteration = soln.getIterations().end();
-	  currentIteration--;
+	  if (!soln.getIterations().empty())
+	    currentIteration--;
 	  currentIterationIndex = soln.getIterations().size()-1;
 	}
       catch (SGException & e)
@@ -340,6 +330,12 @@ void mexFunction(int nlhs, mxArray *plhs[],
     {
       if (!solnLoaded)
 	mexErrMsgTxt("No soln loaded.");
+
+      // The iterator commands need at least one stored iteration.
+      else if (soln.getIterations().empty()
+	       && (!strncmp(optionStr,"Iter",4)
+		   || !strcmp(optionStr,"GetCurrentIteration")))
+	mexErrMsgTxt("No iterations are stored in soln.");
 		
       // GetDelta
       else if (!strcmp(optionStr,"GetDelta"))
@@ -609,28 +605,106 @@ void mexFunction(int nlhs, mxArray *plhs[],
 			
 	} // GetCurentIteration
 		
+      // GetIterations
+      else if (!strcmp(optionStr,"GetIterations"))
+	{
+	  if (nlhs!=1)
+	    mexErrMsgTxt("One output required.");
+
+	  int numStates = soln.getGame().getNumStates();
+	  int numPlayers = soln.getGame().getNumPlayers();
+	  mwSize numIter = soln.getIterations().size();
+	  int nFields = 8;
+
+	  const char *fieldNames[] = {"iteration",
+				      "revolution",
+				      "pivot",
+				      "direction",
+				      "actions",
+				      "nonBinding",
+				      "bestState",
+				      "numExtremeTuples"};
+
+	  plhs[0] = mxCreateStructMatrix(1,1,nFields,fieldNames);
+
+	  // Allocate every field up front, so that they can all be
+	  // filled in with one pass over the iterations.
+	  mwSize pivotDims[3] = {numIter,
+				 static_cast<mwSize>(numStates),
+				 static_cast<mwSize>(numPlayers)};
+	  mxArray * fields[] = {mxCreateDoubleMatrix(numIter,1,mxREAL),
+				mxCreateDoubleMatrix(numIter,1,mxREAL),
+				mxCreateNumericArray(3,pivotDims,
+						     mxDOUBLE_CLASS,mxREAL),
+				mxCreateDoubleMatrix(numIter,numPlayers,mxREAL),
+				mxCreateDoubleMatrix(numIter,numStates,mxREAL),
+				mxCreateDoubleMatrix(numIter,numStates,mxREAL),
+				mxCreateDoubleMatrix(numIter,1,mxREAL),
+				mxCreateDoubleMatrix(numIter,1,mxREAL)};
+	  double * iterationPtr = mxGetPr(fields[0]);
+	  double * revolutionPtr = mxGetPr(fields[1]);
+	  double * pivotPtr = mxGetPr(fields[2]);
+	  double * directionPtr = mxGetPr(fields[3]);
+	  double * actionPtr = mxGetPr(fields[4]);
+	  double * nonBindingPtr = mxGetPr(fields[5]);
+	  double * bestStatePtr = mxGetPr(fields[6]);
+	  double * numExtremeTuplesPtr = mxGetPr(fields[7]);
+
+	  // Arrays are column major, so row k of every field is at
+	  // offset k plus a multiple of numIter.
+	  mwIndex k = 0;
+	  for (list<SGIteration>::const_iterator iter = soln.getIterations().begin();
+	       iter != soln.getIterations().end();
+	       ++iter, ++k)
+	    {
+	      iterationPtr[k] = iter->getIteration();
+	      revolutionPtr[k] = iter->getRevolution();
+	      bestStatePtr[k] = iter->getBestState();
+	      numExtremeTuplesPtr[k] = iter->getNumExtremeTuples();
+
+	      for (player = 0; player < numPlayers; player++)
+		{
+		  directionPtr[k+player*numIter] = iter->getDirection()[player];
+		  for (state = 0; state < numStates; state++)
+		    pivotPtr[k+(state+player*numStates)*numIter]
+		      = iter->getPivot()[state][player];
+		}
+	      for (state = 0; state < numStates; state++)
+		{
+		  actionPtr[k+state*numIter] = iter->getActionTuple()[state];
+		  nonBindingPtr[k+state*numIter]
+		    = static_cast<double>(iter->getRegimeTuple()[state]==SG::NonBinding);
+		}
+	    } // for iter
+
+	  for (int field = 0; field < nFields; field++)
+	    mxSetFieldByNumber(plhs[0],0,field,fields[field]);
+	} // GetIterations
+
       // GetTuples
       else if  (!strcmp(optionStr,"GetTuples"))
 	{
 	  if (nlhs!=1)
 	    mexErrMsgTxt("One output required.");
-			
-	  plhs[0] = mxCreateDoubleMatrix(soln.getExtremeTuples().size(),
-					 soln.getGame().getNumPlayers()
-					 *soln.getGame().getNumStates(),mxREAL);
+
+	  int numStates = soln.getGame().getNumStates();
+	  int numPlayers = soln.getGame().getNumPlayers();
+	  mwSize numTuples = soln.getExtremeTuples().size();
+
+	  plhs[0] = mxCreateDoubleMatrix(numTuples,numPlayers*numStates,mxREAL);
 	  outputPtr = mxGetPr(plhs[0]);
-	  outputCounter=0;
-	  for (state=0; state<soln.getGame().getNumStates(); state++)
+
+	  // Tuple k goes in row k, and column state*numPlayers+player.
+	  mwIndex k = 0;
+	  for (list<SGTuple>::const_iterator tuple = soln.getExtremeTuples().begin();
+	       tuple != soln.getExtremeTuples().end();
+	       ++tuple, ++k)
 	    {
-	      for (player=0; player<soln.getGame().getNumPlayers(); player++)
+	      for (state=0; state<numStates; state++)
 		{
-		  for (list<SGTuple>::const_iterator tuple = soln.getExtremeTuples().begin();
-		       tuple != soln.getExtremeTuples().end();
-		       tuple++)
-		    {
-		      outputPtr[outputCounter] = (*tuple)[state][player];
-		      outputCounter++;
-		    }
+		  for (player=0; player<numPlayers; player++)
+		    outputPtr[k+(state*numPlayers+player)*numTuples]
+		      = (*tuple)[state][player];
 		}
 	    }
 	} // GetTuples
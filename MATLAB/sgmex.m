@@ -25,7 +25,8 @@ function sgmex
 %            See above for arguments. Solves the game described by
 %            delta, p1payoffs, p2payoffs, transitions. Game
 %            arguments can be followed by a sequence of
-%            parameter/value pairs. Possible parameter values are:
+%            parameter/value pairs. Any SGEnv parameter can be set
+%            by name, e.g.
 %                  
 %                  errorTol
 %                  directionTol
@@ -38,7 +39,20 @@ function sgmex
 %                  improveTol
 %                  backBendingTol
 %                  movementTol
-%                  unconstrained
+%                  maxIterations
+%                  storeIterations  (0: none, 1: last revolution,
+%                                    2: all, the default)
+%                  storeActions
+%                  printToCout
+%
+%            In addition, sgmex accepts
+%
+%                  unconstrained     logical array with two elements
+%                  printProgress     print progress after each
+%                                    revolution (default true)
+%                  progressInterval  minimum number of seconds
+%                                    between progress reports
+%                                    (default 0)
 % 
 %            Consult the SGSolve documentation for further details
 %            on these parameters.
@@ -91,8 +105,15 @@ function sgmex
 %            Returns a structure that contains the index, best action,
 %            state, direction, payoffs, startOfW and sizeOfW.
 %
-%       [T0,T1] = sgmex('GetTuples')
-%            Returns the list of extremeTuples. Ti(k,s) is player
-%            i's coordinate in state s at pivot k.
+%       s = sgmex('GetIterations')
+%            Returns every iteration in one call, as a structure
+%            with the same fields as GetCurrentIteration. Row k of
+%            each field belongs to the k-th iteration, and
+%            s.pivot(k,s,p) is player p's payoff in state s. Much
+%            faster than stepping through the solution with Iter++.
+%
+%       T = sgmex('GetTuples')
+%            Returns the list of extremeTuples. T(k,2*(s-1)+i) is
+%            player i's coordinate in state s at pivot k.
 %
 end % sgmex
@@ -0,0 +1,221 @@
+// This file is part of the SGSolve library for stochastic games
+// Copyright (C) 2016 Benjamin A. Brooks
+//
+// SGSolve free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SGSolve is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see
+// <http://www.gnu.org/licenses/>.
+//
+// Benjamin A. Brooks
+// ben@benjaminbrooks.net
+// Chicago, IL
+
+//! One state prisoner's dilemma, solved through the C interface
+//! @example
+
+/* This is the game in pd.cpp, written in plain C against sgcapi.h
+   and linked with libsg.so, the same way that Python or Julia would
+   call the library. It goes through every part of the interface:
+   building and reading back a game, setting parameters, solving with
+   a progress callback, stopping a solve early, and extracting and
+   saving the solution. */
+
+#include "sgcapi.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+//! Prints the error and exits if status is not SG_OK.
+static void check(int status, const char * what)
+{
+  if (status != SG_OK)
+    {
+      fprintf(stderr,"%s failed: %s\n",what,sg_last_error());
+      exit(1);
+    }
+}
+
+//! Prints the error and exits if handle is NULL.
+static void * checkHandle(void * handle, const char * what)
+{
+  if (handle == NULL)
+    {
+      fprintf(stderr,"%s failed: %s\n",what,sg_last_error());
+      exit(1);
+    }
+  return handle;
+}
+
+//! Prints each revolution.
+static int printProgress(int numIterations, int numRevolutions,
+			 double errorLevel, void * userData)
+{
+  int * numCalls = (int *)userData;
+  (*numCalls)++;
+  printf("  Rev: %d, iter: %d, error: %g\n",
+	 numRevolutions,numIterations,errorLevel);
+  return 0;
+}
+
+//! Stops the solve after the first revolution.
+static int stopEarly(int numIterations, int numRevolutions,
+		     double errorLevel, void * userData)
+{
+  return 1;
+}
+
+int main ()
+{
+  const double delta = 0.7;
+  const int numStates = 1;
+  const int numActions[2] = {2,2};
+  // payoffs[2*a+i] is player i's payoff from profile a = a0 + 2*a1.
+  const double payoffs[8] = {0, 0,
+			     -1, 3,
+			     3, -1,
+			     2, 2};
+  const double probabilities[4] = {1, 1, 1, 1};
+
+  int numCalls = 0;
+
+  sg_game * game
+    = (sg_game *)checkHandle(sg_game_create(delta,numStates,numActions,
+					    payoffs,probabilities,NULL),
+			     "sg_game_create");
+
+  // Read the payoffs back to check the array layout.
+  int numProfiles = sg_game_num_profiles(game);
+  double * gamePayoffs = malloc(2*numProfiles*sizeof(double));
+  check(sg_game_get_payoffs(game,gamePayoffs),"sg_game_get_payoffs");
+  for (int k = 0; k < 2*numProfiles; k++)
+    {
+      if (gamePayoffs[k] != payoffs[k])
+	{
+	  fprintf(stderr,"Payoff %d was not stored correctly\n",k);
+	  return 1;
+	}
+    }
+  free(gamePayoffs);
+
+  sg_env * env = (sg_env *)checkHandle(sg_env_create(),"sg_env_create");
+  check(sg_env_set_param(env,"directionTol",1e-12),"sg_env_set_param");
+  check(sg_env_set_param(env,"normTol",1e-12),"sg_env_set_param");
+  check(sg_env_set_param(env,"levelTol",1e-12),"sg_env_set_param");
+  check(sg_env_set_param(env,"improveTol",1e-13),"sg_env_set_param");
+  check(sg_env_set_param(env,"storeIterations",2),"sg_env_set_param");
+  check(sg_env_set_param(env,"printToCout",0),"sg_env_set_param");
+  check(sg_env_set_param(env,"printToLog",0),"sg_env_set_param");
+  if (sg_env_set_param(env,"noSuchParam",1) != SG_ERROR)
+    {
+      fprintf(stderr,"An unknown parameter was accepted\n");
+      return 1;
+    }
+  printf("Unknown parameter: %s\n",sg_last_error());
+
+  // The solver copies the game and the parameters.
+  sg_solver * solver
+    = (sg_solver *)checkHandle(sg_solver_create(env,game),
+			       "sg_solver_create");
+  sg_env_free(env);
+  sg_game_free(game);
+
+  printf("Starting solve routine\n");
+  check(sg_solver_solve(solver,printProgress,&numCalls),"sg_solver_solve");
+
+  // The solution stays valid after the solver solves again and after
+  // it is freed.
+  sg_solution * soln
+    = (sg_solution *)checkHandle(sg_solver_get_solution(solver),
+				 "sg_solver_get_solution");
+  int numTuples = sg_solution_num_tuples(soln);
+  check(sg_solver_solve(solver,NULL,NULL),"sg_solver_solve");
+  sg_solution * secondSoln
+    = (sg_solution *)checkHandle(sg_solver_get_solution(solver),
+				 "sg_solver_get_solution");
+  if (sg_solution_num_tuples(secondSoln) != numTuples
+      || sg_solution_num_tuples(soln) != numTuples)
+    {
+      fprintf(stderr,"Solving again changed the solution\n");
+      return 1;
+    }
+  sg_solution_free(secondSoln);
+  sg_solver_free(solver);
+
+  int numIterations = sg_solution_num_iterations(soln);
+  printf("%d revolutions reported, %d iterations, %d extreme tuples\n",
+	 numCalls,numIterations,numTuples);
+  if (numCalls == 0 || numIterations == 0 || numTuples == 0)
+    {
+      fprintf(stderr,"The solution is empty\n");
+      return 1;
+    }
+
+  double * tuples = malloc(2*numStates*numTuples*sizeof(double));
+  check(sg_solution_get_tuples(soln,tuples),"sg_solution_get_tuples");
+  printf("Last extreme tuple: (%g,%g)\n",
+	 tuples[2*(numTuples-1)],tuples[2*(numTuples-1)+1]);
+  free(tuples);
+
+  int * iteration = malloc(numIterations*sizeof(int));
+  double * directions = malloc(2*numIterations*sizeof(double));
+  check(sg_solution_get_iterations(soln,iteration,NULL,NULL,directions,
+				   NULL,NULL,NULL,NULL),
+	"sg_solution_get_iterations");
+  printf("Last iteration: %d, direction (%g,%g)\n",
+	 iteration[numIterations-1],
+	 directions[2*(numIterations-1)],
+	 directions[2*(numIterations-1)+1]);
+  free(iteration);
+  free(directions);
+
+  check(sg_solution_save(soln,"pd_capi.sln"),"sg_solution_save");
+  sg_solution_free(soln);
+
+  // Load the saved solution and get the game back out of it.
+  soln = (sg_solution *)checkHandle(sg_solution_load("pd_capi.sln"),
+				    "sg_solution_load");
+  if (sg_solution_num_tuples(soln) != numTuples)
+    {
+      fprintf(stderr,"The loaded solution does not match\n");
+      return 1;
+    }
+  game = (sg_game *)checkHandle(sg_solution_get_game(soln),
+				"sg_solution_get_game");
+  printf("Loaded solution for a game with %d state(s) and delta %g\n",
+	 sg_game_num_states(game),sg_game_delta(game));
+
+  // A callback that returns nonzero stops the solve.
+  env = (sg_env *)checkHandle(sg_env_create(),"sg_env_create");
+  check(sg_env_set_param(env,"printToCout",0),"sg_env_set_param");
+  check(sg_env_set_param(env,"printToLog",0),"sg_env_set_param");
+  solver = (sg_solver *)checkHandle(sg_solver_create(env,game),
+				    "sg_solver_create");
+  if (sg_solver_solve(solver,stopEarly,NULL) != SG_ERROR)
+    {
+      fprintf(stderr,"The callback did not stop the solve\n");
+      return 1;
+    }
+  printf("Stopped early: %s\n",sg_last_error());
+
+  sg_solver_free(solver);
+  sg_env_free(env);
+  sg_game_free(game);
+  sg_solution_free(soln);
+
+  if (sg_solution_load("no_such_file.sln") != NULL)
+    {
+      fprintf(stderr,"Loading a missing file succeeded\n");
+      return 1;
+    }
+
+  printf("Done!\n");
+  return 0;
+}
@@ -0,0 +1,529 @@
+// This file is part of the SGSolve library for stochastic games
+// Copyright (C) 2016 Benjamin A. Brooks
+//
+// SGSolve free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SGSolve is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see
+// <http://www.gnu.org/licenses/>.
+//
+// Benjamin A. Brooks
+// ben@benjaminbrooks.net
+// Chicago, IL
+
+//! Benchmarks the solvers on seeded families of random games.
+/*! Usage: sgbenchmark [csv|json] [seed] [trials]
+
+  Two player games are solved with SGSolver, SGSolver_V2 and
+  SGJYCSolver, and three player repeated games with SGSolverND. Game
+  number t of a family is drawn from a generator seeded with seed+t,
+  so runs with the same seed solve the same games. One record is
+  written to cout for each solver and game, with the wall time, the
+  number of iterations and revolutions, the peak resident set size
+  during the solve, and the number of tuples generated per
+  second. The JYC and N-player solvers update the whole set at each
+  iteration, so their revolutions are their iterations, and their
+  tuples are the bounds and payoffs computed. SGJYCSolver is run with
+  both its SG_LINEARPROGRAM and its SG_SWEEP method. The linear
+  programs take about a minute per game on the small families, where
+  the sweep takes a fraction of a second. Every solver stops when its
+  error falls below the same ERRORTOL.
+
+  The lazy families have more states, and their games are generated
+  row by row by an SGAbstractGame. SGSolver solves each of them twice,
+  once as an SGGame that stores every transition probability and once
+  through an SGLazyGame that only keeps lazyCacheSize rows, so that
+  the records compare the time and the peak memory of the two
+  backends. */
+//! @example
+#include "sg.hpp"
+#include "sgapprox_v2.hpp"
+#include "sgjycsolver.hpp"
+#include "sgsolver_nd.hpp"
+#include "sglazygame.hpp"
+#include <random>
+#include <chrono>
+#include <sys/resource.h>
+
+//! A family of random two player games
+struct GameFamily
+{
+  int numStates; /*!< Number of states. */
+  int numActions; /*!< Number of actions of each player in each
+                     state. */
+  double delta; /*!< Discount factor. */
+};
+
+//! A family of random repeated games with more than two players
+struct GameFamilyND
+{
+  int numPlayers; /*!< Number of players. */
+  int numActions; /*!< Number of actions of each player. */
+  double delta; /*!< Discount factor. */
+};
+
+//! Results of one solver on one game
+struct BenchmarkRecord
+{
+  string solver;
+  string family;
+  int trial;
+  unsigned seed;
+  double wallTime; /*!< Seconds. */
+  int iterations;
+  int revolutions;
+  long tuples; /*!< Number of tuples generated. */
+  long peakRSS; /*!< Kilobytes. */
+  string status; /*!< "ok", or the reason that the solve failed. */
+};
+
+const int numDirections = 100; /*!< Directions for SGJYCSolver. */
+const int lazyCacheSize = 64; /*!< Rows cached by SGLazyGame, fewer
+                                   than the lazy families have. */
+
+//! Resets the peak resident set size of the process
+/*! Only supported on Linux. Elsewhere, the peak is the peak since
+    the process started. */
+void resetPeakRSS()
+{
+#ifdef __linux__
+  ofstream ofs("/proc/self/clear_refs");
+  ofs << "5";
+#endif
+}
+
+//! Returns the peak resident set size in kilobytes
+long peakRSS()
+{
+#ifdef __linux__
+  ifstream ifs("/proc/self/status");
+  string line;
+  while (getline(ifs,line))
+    {
+      if (line.compare(0,6,"VmHWM:") == 0)
+	return atol(line.c_str()+6);
+    }
+#endif
+  struct rusage usage;
+  getrusage(RUSAGE_SELF,&usage);
+  return usage.ru_maxrss;
+}
+
+//! Draws a random two player stochastic game
+/*! Payoffs are uniform on [0,10], and the transition probabilities
+    of each action profile are drawn uniformly from the simplex. */
+SGGame randomGame(const GameFamily & family, unsigned seed)
+{
+  std::mt19937 generator(seed);
+  uniform_real_distribution<double> payoffDistr(0.0,10.0);
+  exponential_distribution<double> weightDistr(1.0);
+
+  int numStates = family.numStates;
+  int numActions_total = family.numActions*family.numActions;
+  vector< vector<int> > numActions(numStates,
+				   vector<int>(2,family.numActions));
+  vector< vector< vector<double> > >
+    payoffs(numStates,vector< vector<double> >(numActions_total,
+					       vector<double>(2,0.0)));
+  vector< vector< vector<double> > >
+    probabilities(numStates,
+		  vector< vector<double> >(numActions_total,
+					   vector<double>(numStates,0.0)));
+
+  for (int state = 0; state < numStates; state++)
+    {
+      for (int action = 0; action < numActions_total; action++)
+	{
+	  payoffs[state][action][0] = payoffDistr(generator);
+	  payoffs[state][action][1] = payoffDistr(generator);
+
+	  double total = 0;
+	  for (int sp = 0; sp < numStates; sp++)
+	    {
+	      probabilities[state][action][sp] = weightDistr(generator);
+	      total += probabilities[state][action][sp];
+	    }
+	  for (int sp = 0; sp < numStates; sp++)
+	    probabilities[state][action][sp] /= total;
+	} // action
+    } // state
+
+  return SGGame(family.delta,numStates,numActions,payoffs,probabilities,
+		vector<bool>(2,false));
+}
+
+//! A random two player stochastic game that is generated on demand
+/*! Drawn from the same distribution as randomGame, but the payoffs
+    and the transition probabilities of each action profile come from
+    their own generator, seeded with the game's seed, the state, and
+    the action profile. They can therefore be computed in any order,
+    and SGGame and SGLazyGame see the same game. */
+class RandomAbstractGame : public SGAbstractGame
+{
+private:
+  unsigned seed; /*!< Seed of the game. */
+
+  //! Seeds a generator for one state and action profile
+  void seedGenerator(std::mt19937 & generator, int state,
+		     const vector<int> & actions, int part) const
+  {
+    std::seed_seq seq {seed, static_cast<unsigned>(state),
+	static_cast<unsigned>(actions[0]),
+	static_cast<unsigned>(actions[1]),
+	static_cast<unsigned>(part)};
+    generator.seed(seq);
+  }
+
+public:
+  //! Constructor
+  RandomAbstractGame(const GameFamily & family, unsigned _seed):
+    SGAbstractGame(family.delta,family.numStates,
+		   vector< vector<int> >(family.numStates,
+					 vector<int>(2,family.numActions))),
+    seed(_seed)
+  {}
+
+  //! Payoffs are uniform on [0,10]
+  SGPoint payoffs(int state, const vector<int> & actions) const
+  {
+    std::mt19937 generator;
+    seedGenerator(generator,state,actions,0);
+    uniform_real_distribution<double> payoffDistr(0.0,10.0);
+    double payoff0 = payoffDistr(generator);
+    return SGPoint(payoff0,payoffDistr(generator));
+  }
+
+  //! Returns one element of the row computed by probabilities
+  double probability(int state, const vector<int> & actions,
+		     int statep) const
+  {
+    vector<double> row(numStates);
+    probabilities(state,actions,&row[0]);
+    return row[statep];
+  }
+
+  //! The row is drawn uniformly from the simplex
+  void probabilities(int state, const vector<int> & actions,
+		     double * out) const
+  {
+    std::mt19937 generator;
+    seedGenerator(generator,state,actions,1);
+    exponential_distribution<double> weightDistr(1.0);
+
+    double total = 0;
+    for (int sp = 0; sp < numStates; sp++)
+      {
+	out[sp] = weightDistr(generator);
+	total += out[sp];
+      }
+    for (int sp = 0; sp < numStates; sp++)
+      out[sp] /= total;
+  }
+};
+
+//! Draws the payoffs of a random repeated game, uniform on [0,10]
+vector< vector<double> > randomPayoffsND(const GameFamilyND & family,
+					 unsigned seed)
+{
+  std::mt19937 generator(seed);
+  uniform_real_distribution<double> payoffDistr(0.0,10.0);
+
+  int numActions_total = 1;
+  for (int p = 0; p < family.numPlayers; p++)
+    numActions_total *= family.numActions;
+
+  vector< vector<double> > payoffs(numActions_total,
+				   vector<double>(family.numPlayers,0));
+  for (int a = 0; a < numActions_total; a++)
+    {
+      for (int p = 0; p < family.numPlayers; p++)
+	payoffs[a][p] = payoffDistr(generator);
+    }
+  return payoffs;
+}
+
+string familyName(const GameFamily & family)
+{
+  stringstream ss;
+  ss << "states=" << family.numStates
+     << " actions=" << family.numActions
+     << " delta=" << family.delta;
+  return ss.str();
+}
+
+string familyName(const GameFamilyND & family)
+{
+  stringstream ss;
+  ss << "players=" << family.numPlayers
+     << " actions=" << family.numActions
+     << " delta=" << family.delta;
+  return ss.str();
+}
+
+//! Seconds since start
+double elapsed(const std::chrono::steady_clock::time_point & start)
+{
+  return std::chrono::duration<double>(std::chrono::steady_clock::now()
+				       -start).count();
+}
+
+//! Runs SGApprox to convergence, as in SGSolver::solve
+/*! The game is either an SGGame or an SGLazyGame. Iterations are not
+    stored, so the solution does not need a copy of the game. */
+void runSGSolver(const SGEnv & env, const SGGameAccessor & game,
+		 BenchmarkRecord & record)
+{
+  SGSolution soln;
+  SGApprox approx(env,game,soln);
+
+  approx.initialize();
+  while (approx.generate(false) > env.getParam(SG::ERRORTOL)
+	 && approx.getNumIterations() < env.getParam(SG::MAXITERATIONS))
+    {};
+  approx.end();
+
+  record.iterations = approx.getNumIterations();
+  record.revolutions = approx.getNumRevolutions();
+  record.tuples = approx.getNumIterations();
+}
+
+//! Runs SGApprox_V2 to convergence, as in SGSolver_V2::solve
+void runSGSolver_V2(const SGEnv & env, const SGGame & game,
+		    BenchmarkRecord & record)
+{
+  SGSolution_V2 soln(game);
+  SGApprox_V2 approx(env,game,soln);
+
+  approx.initialize();
+  while (approx.generate(false) > env.getParam(SG::ERRORTOL)
+	 && approx.getNumSteps() < env.getParam(SG::MAXITERATIONS))
+    {};
+  approx.end();
+
+  record.iterations = approx.getNumSteps();
+  record.revolutions = approx.getNumIterations();
+  record.tuples = approx.getNumSteps();
+}
+
+//! Runs SGJYCSolver with the given method until the bounds stop moving
+/*! Same stopping rule as SGJYCSolver::solve, without refinement, but
+    with the ERRORTOL that the other solvers use. */
+void runSGJYCSolver(const SGEnv & env, const SGGame & game,
+		    SGJYCSolver::SGJYCMethod method,
+		    BenchmarkRecord & record)
+{
+  SGJYCSolver solver(game,numDirections);
+  solver.setMethod(method);
+  solver.initialize();
+
+  int numIterations = 0;
+  double error = 1.0;
+  while (error > env.getParam(SG::ERRORTOL)
+	 && numIterations < env.getParam(SG::MAXITERATIONS))
+    {
+      error = solver.iterate();
+      numIterations++;
+    }
+
+  record.iterations = numIterations;
+  record.revolutions = numIterations;
+  record.tuples = static_cast<long>(numIterations)
+    *game.getNumStates()*solver.getNumDirections();
+}
+
+//! Runs SGSolverND to convergence
+void runSGSolverND(const SGEnv & env, const GameFamilyND & family,
+		   const vector< vector<double> > & payoffs,
+		   BenchmarkRecord & record)
+{
+  SGSolverND solver(env,vector<int>(family.numPlayers,family.numActions),
+		    payoffs,family.delta);
+  solver.solve();
+
+  record.iterations = solver.getNumIterations();
+  record.revolutions = solver.getNumIterations();
+  record.tuples = solver.getNumGenerated();
+}
+
+//! Times one solve and fills in the rest of the record
+template<class Run>
+BenchmarkRecord benchmark(const string & solver, const string & family,
+			  int trial, unsigned seed, Run run)
+{
+  BenchmarkRecord record = {solver,family,trial,seed,0,0,0,0,0,"ok"};
+
+  resetPeakRSS();
+  std::chrono::steady_clock::time_point start
+    = std::chrono::steady_clock::now();
+  try
+    {
+      run(record);
+    }
+  catch (SGException e)
+    {
+      record.status = e.what();
+    }
+  catch (std::exception & e)
+    {
+      record.status = e.what();
+    }
+  record.wallTime = elapsed(start);
+  record.peakRSS = peakRSS();
+  return record;
+}
+
+string csvHeader()
+{
+  return "solver,family,trial,seed,wall_time,iterations,revolutions,"
+    "tuples,tuples_per_second,peak_rss_kb,status";
+}
+
+string toCSV(const BenchmarkRecord & record)
+{
+  stringstream ss;
+  ss << quoteCSV(record.solver) << "," << quoteCSV(record.family) << ","
+     << record.trial << "," << record.seed << ","
+     << record.wallTime << "," << record.iterations << ","
+     << record.revolutions << "," << record.tuples << ","
+     << (record.wallTime > 0? record.tuples/record.wallTime: 0) << ","
+     << record.peakRSS << "," << quoteCSV(record.status);
+  return ss.str();
+}
+
+string toJSON(const BenchmarkRecord & record)
+{
+  stringstream ss;
+  ss << "{\"solver\": " << quoteJSON(record.solver)
+     << ", \"family\": " << quoteJSON(record.family)
+     << ", \"trial\": " << record.trial
+     << ", \"seed\": " << record.seed
+     << ", \"wall_time\": " << record.wallTime
+     << ", \"iterations\": " << record.iterations
+     << ", \"revolutions\": " << record.revolutions
+     << ", \"tuples\": " << record.tuples
+     << ", \"tuples_per_second\": "
+     << (record.wallTime > 0? record.tuples/record.wallTime: 0)
+     << ", \"peak_rss_kb\": " << record.peakRSS
+     << ", \"status\": " << quoteJSON(record.status) << "}";
+  return ss.str();
+}
+
+int main (int argc, char ** argv)
+{
+  string format = (argc > 1? argv[1]: "csv");
+  unsigned baseSeed = (argc > 2? atol(argv[2]): 1);
+  int numTrials = (argc > 3? atoi(argv[3]): 3);
+  if ((format != "csv" && format != "json") || numTrials < 1)
+    {
+      cerr << "Usage: sgbenchmark [csv|json] [seed] [trials]" << endl;
+      return 1;
+    }
+
+  const GameFamily families[] = { {1,2,0.7}, {1,4,0.7}, {2,2,0.7},
+				  {2,3,0.9}, {4,2,0.7}, {4,3,0.9} };
+  const GameFamilyND familiesND[] = { {3,2,0.6}, {3,2,0.8},
+				      {3,3,0.8} };
+  const GameFamily lazyFamilies[] = { {10,3,0.7}, {20,3,0.7} };
+
+  SGEnv env;
+  env.setParam(SG::STOREITERATIONS,0);
+  env.setParam(SG::STOREACTIONS,false);
+  env.setParam(SG::PRINTTOCOUT,false);
+  env.setParam(SG::ERRORTOL,1e-8);
+  env.setParam(SG::MAXITERATIONS,1000000);
+
+  // Records are written as soon as they are done, so that partial
+  // results survive an interrupted run.
+  int numRecords = 0;
+  auto write = [&](const BenchmarkRecord & record)
+    {
+      if (format == "csv")
+	cout << toCSV(record) << endl;
+      else
+	cout << (numRecords > 0? ",\n  ": "  ") << toJSON(record) << flush;
+      numRecords++;
+    };
+
+  if (format == "csv")
+    cout << csvHeader() << endl;
+  else
+    cout << "[" << endl;
+
+  for (const GameFamily & family : families)
+    {
+      string name = familyName(family);
+      for (int trial = 0; trial < numTrials; trial++)
+	{
+	  unsigned seed = baseSeed + trial;
+	  SGGame game = randomGame(family,seed);
+
+	  write(benchmark("SGSolver",name,trial,seed,
+			  [&](BenchmarkRecord & record)
+			  { runSGSolver(env,game,record); }));
+	  write(benchmark("SGSolver_V2",name,trial,seed,
+			  [&](BenchmarkRecord & record)
+			  { runSGSolver_V2(env,game,record); }));
+	  write(benchmark("SGJYCSolver_LP",name,trial,seed,
+			  [&](BenchmarkRecord & record)
+			  { runSGJYCSolver(env,game,
+					   SGJYCSolver::SG_LINEARPROGRAM,
+					   record); }));
+	  write(benchmark("SGJYCSolver_Sweep",name,trial,seed,
+			  [&](BenchmarkRecord & record)
+			  { runSGJYCSolver(env,game,SGJYCSolver::SG_SWEEP,
+					   record); }));
+	} // trial
+    } // family
+
+  for (const GameFamily & family : lazyFamilies)
+    {
+      string name = familyName(family);
+      for (int trial = 0; trial < numTrials; trial++)
+	{
+	  unsigned seed = baseSeed + trial;
+	  RandomAbstractGame abstractGame(family,seed);
+
+	  // Building the SGGame is part of the cost of storing the
+	  // game, so it is timed along with the solve.
+	  write(benchmark("SGSolver",name,trial,seed,
+			  [&](BenchmarkRecord & record)
+			  {
+			    SGGame game(abstractGame);
+			    runSGSolver(env,game,record);
+			  }));
+	  write(benchmark("SGSolver_Lazy",name,trial,seed,
+			  [&](BenchmarkRecord & record)
+			  {
+			    SGLazyGame game(abstractGame,lazyCacheSize);
+			    runSGSolver(env,game,record);
+			  }));
+	} // trial
+    } // family
+
+  for (const GameFamilyND & family : familiesND)
+    {
+      string name = familyName(family);
+      for (int trial = 0; trial < numTrials; trial++)
+	{
+	  unsigned seed = baseSeed + trial;
+	  vector< vector<double> > payoffs = randomPayoffsND(family,seed);
+
+	  write(benchmark("SGSolverND",name,trial,seed,
+			  [&](BenchmarkRecord & record)
+			  { runSGSolverND(env,family,payoffs,record); }));
+	} // trial
+    } // family
+
+  if (format == "json")
+    cout << endl << "]" << endl;
+
+  return 0;
+}
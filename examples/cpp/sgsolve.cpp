@@ -0,0 +1,401 @@
+// This file is part of the SGSolve library for stochastic games
+// Copyright (C) 2016 Benjamin A. Brooks
+//
+// SGSolve free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SGSolve is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see
+// <http://www.gnu.org/licenses/>.
+//
+// Benjamin A. Brooks
+// ben@benjaminbrooks.net
+// Chicago, IL
+
+//! Command line batch solver
+/*! Usage:
+
+    sgsolve [options] game [game ...]
+    sgsolve [options] --manifest file
+
+  Loads each game with SGGame::load, solves it with SGSolver, and
+  writes the solution. Games are solved concurrently, and one record
+  per game is written to cout with the wall time, the numbers of
+  iterations and revolutions, the final error level, whether the
+  algorithm converged, and the number of extreme tuples. Diagnostics
+  go to cerr. The exit status is 0 if every game was solved, 1 if any
+  failed, and 2 for a usage error.
+
+  Options:
+
+  - --param name=value: sets an SGEnv parameter by name (see
+    SGEnv::getParamTable). May be repeated.
+
+  - --config file: reads parameters from file, one name=value per
+    line. Blank lines and lines starting with # are ignored. Later
+    options override earlier ones.
+
+  - --manifest file: reads the games from file instead of the command
+    line. Each line has the path of a game and, optionally, the path
+    of its output.
+
+  - --output path: output path, when there is a single game.
+
+  - --output-dir dir: directory for outputs that are not given
+    explicitly. Each output is named after its game, with the
+    extension of the format. Defaults to the game's directory.
+
+  - --format archive|csv|none: archive writes the solution with
+    SGSolution::save, csv writes the extreme tuples with one row per
+    tuple and the columns state0_player0, state0_player1, ..., and
+    none writes nothing. Defaults to archive.
+
+  - --stats csv|json: format of the records on cout. Defaults to csv.
+
+  - --threads n: number of games to solve at the same time. Defaults
+    to the number of hardware threads.
+
+  Unless set otherwise, iterations are not stored (storeIterations=0)
+  and printToCout is false, so that cout only contains the records.
+  printToLog is always false, since the jobs run at the same time and
+  would all write to sg.log. */
+//! @example
+#include "sg.hpp"
+#include <chrono>
+#include <mutex>
+
+//! A game to be solved
+struct Job
+{
+  string game; /*!< Path of the game. */
+  string output; /*!< Path of the output. */
+};
+
+//! Results of one solve
+struct Record
+{
+  string game;
+  string output;
+  double wallTime; /*!< Seconds. */
+  int iterations;
+  int revolutions;
+  double errorLevel;
+  bool converged;
+  long tuples; /*!< Number of extreme tuples. */
+  string status; /*!< "ok", or the reason that the solve failed. */
+};
+
+const char * usage =
+  "Usage: sgsolve [options] game [game ...]\n"
+  "       sgsolve [options] --manifest file\n"
+  "Options: --param name=value, --config file, --output path,\n"
+  "         --output-dir dir, --format archive|csv|none,\n"
+  "         --stats csv|json, --threads n";
+
+//! Removes leading and trailing white space
+string trim(const string & str)
+{
+  size_t first = str.find_first_not_of(" \t\r");
+  if (first == string::npos)
+    return "";
+  size_t last = str.find_last_not_of(" \t\r");
+  return str.substr(first,last-first+1);
+}
+
+//! Splits name=value, checks it against SGEnv, and appends it to params
+bool parseParam(const string & arg, vector< pair<string,double> > & params)
+{
+  size_t eq = arg.find('=');
+  if (eq == string::npos)
+    return false;
+
+  string name = trim(arg.substr(0,eq));
+  string value = trim(arg.substr(eq+1));
+  char * end;
+  double number = strtod(value.c_str(),&end);
+  if (name.empty() || value.empty() || *end != '\0')
+    return false;
+
+  // Check the name and the value now rather than on every thread,
+  // by setting them on a scratch environment.
+  try
+    {
+      SGEnv env;
+      env.setParam(name,number);
+    }
+  catch (SGException & e)
+    {
+      return false;
+    }
+  params.push_back(pair<string,double>(name,number));
+  return true;
+}
+
+//! Reads lines of a file, skipping blank lines and comments
+bool readLines(const string & path, vector<string> & lines)
+{
+  ifstream ifs(path.c_str());
+  if (!ifs.good())
+    return false;
+  string line;
+  while (getline(ifs,line))
+    {
+      line = trim(line);
+      if (!line.empty() && line[0] != '#')
+	lines.push_back(line);
+    }
+  return true;
+}
+
+//! Returns the default output path for game
+string outputPath(const string & game, const string & outputDir,
+		  const string & format)
+{
+  string base = game;
+  size_t dot = base.find_last_of('.');
+  size_t slash = base.find_last_of('/');
+  if (dot != string::npos && (slash == string::npos || dot > slash))
+    base = base.substr(0,dot);
+  if (!outputDir.empty())
+    base = outputDir + "/"
+      + (slash == string::npos? base: base.substr(slash+1));
+  return base + (format == "csv"? ".csv": ".sln");
+}
+
+//! Writes the extreme tuples of soln as CSV
+void writeCSV(const SGSolution & soln, const string & path)
+{
+  ofstream ofs(path.c_str());
+  if (!ofs.good())
+    throw(SGException(SG::FAILED_OPEN));
+  ofs << setprecision(17);
+
+  int numStates = soln.getGame().getNumStates();
+  for (int state = 0; state < numStates; state++)
+    ofs << (state > 0? ",": "") << "state" << state << "_player0,"
+	<< "state" << state << "_player1";
+  ofs << endl;
+
+  for (list<SGTuple>::const_iterator tuple = soln.getExtremeTuples().begin();
+       tuple != soln.getExtremeTuples().end();
+       ++tuple)
+    {
+      for (int state = 0; state < numStates; state++)
+	ofs << (state > 0? ",": "") << (*tuple)[state][0]
+	    << "," << (*tuple)[state][1];
+      ofs << "\n";
+    }
+}
+
+//! Loads, solves, and writes one game
+Record solve(const Job & job, const vector< pair<string,double> > & params,
+	     const string & format)
+{
+  Record record = {job.game, job.output, 0, 0, 0, 0, false, 0, "ok"};
+
+  SGEnv env;
+  try
+    {
+      env.setParam(SG::STOREITERATIONS,0);
+      env.setParam(SG::PRINTTOCOUT,false);
+      for (int k = 0; k < params.size(); k++)
+	env.setParam(params[k].first,params[k].second);
+      // Every job would write to the same sg.log.
+      env.setParam(SG::PRINTTOLOG,false);
+
+      SGGame game;
+      SGGame::load(game,job.game.c_str());
+
+      std::chrono::steady_clock::time_point start
+	= std::chrono::steady_clock::now();
+      SGSolver solver(env,game);
+      solver.solve();
+      record.wallTime = std::chrono::duration<double>
+	(std::chrono::steady_clock::now()-start).count();
+
+      record.iterations = solver.getNumIterations();
+      record.revolutions = solver.getNumRevolutions();
+      record.errorLevel = solver.getErrorLevel();
+      record.converged = (solver.getErrorLevel() <= env.getParam(SG::ERRORTOL));
+      record.tuples = solver.getSolution().getExtremeTuples().size();
+
+      if (format == "archive")
+	SGSolution::save(solver.getSolution(),job.output.c_str());
+      else if (format == "csv")
+	writeCSV(solver.getSolution(),job.output);
+    }
+  catch (std::exception & e)
+    {
+      record.status = e.what();
+    }
+  return record;
+}
+
+string csvHeader()
+{
+  return "game,output,wall_time,iterations,revolutions,error_level,"
+    "converged,tuples,status";
+}
+
+string toCSV(const Record & record)
+{
+  stringstream ss;
+  ss << quoteCSV(record.game) << "," << quoteCSV(record.output) << ","
+     << record.wallTime << "," << record.iterations << ","
+     << record.revolutions << "," << record.errorLevel << ","
+     << record.converged << "," << record.tuples << ","
+     << quoteCSV(record.status);
+  return ss.str();
+}
+
+string toJSON(const Record & record)
+{
+  stringstream ss;
+  ss << "{\"game\": " << quoteJSON(record.game)
+     << ", \"output\": " << quoteJSON(record.output)
+     << ", \"wall_time\": " << record.wallTime
+     << ", \"iterations\": " << record.iterations
+     << ", \"revolutions\": " << record.revolutions
+     << ", \"error_level\": " << record.errorLevel
+     << ", \"converged\": " << (record.converged? "true": "false")
+     << ", \"tuples\": " << record.tuples
+     << ", \"status\": " << quoteJSON(record.status) << "}";
+  return ss.str();
+}
+
+int main (int argc, char ** argv)
+{
+  vector< pair<string,double> > params;
+  vector<string> games;
+  string manifest, output, outputDir;
+  string format = "archive";
+  string stats = "csv";
+  int numThreads = 0;
+
+  for (int k = 1; k < argc; k++)
+    {
+      string arg = argv[k];
+      bool hasValue = (k+1 < argc);
+      if (arg == "--param" && hasValue)
+	{
+	  if (!parseParam(argv[++k],params))
+	    {
+	      cerr << "Invalid parameter: " << argv[k] << endl;
+	      return 2;
+	    }
+	}
+      else if (arg == "--config" && hasValue)
+	{
+	  vector<string> lines;
+	  if (!readLines(argv[++k],lines))
+	    {
+	      cerr << "Could not read config file " << argv[k] << endl;
+	      return 2;
+	    }
+	  for (int l = 0; l < lines.size(); l++)
+	    {
+	      if (!parseParam(lines[l],params))
+		{
+		  cerr << "Invalid parameter in " << argv[k]
+		       << ": " << lines[l] << endl;
+		  return 2;
+		}
+	    }
+	}
+      else if (arg == "--manifest" && hasValue)
+	manifest = argv[++k];
+      else if (arg == "--output" && hasValue)
+	output = argv[++k];
+      else if (arg == "--output-dir" && hasValue)
+	outputDir = argv[++k];
+      else if (arg == "--format" && hasValue)
+	format = argv[++k];
+      else if (arg == "--stats" && hasValue)
+	stats = argv[++k];
+      else if (arg == "--threads" && hasValue)
+	numThreads = atoi(argv[++k]);
+      else if (arg.size() > 0 && arg[0] != '-')
+	games.push_back(arg);
+      else
+	{
+	  cerr << usage << endl;
+	  return 2;
+	}
+    }
+
+  vector<Job> jobs;
+  for (int k = 0; k < games.size(); k++)
+    jobs.push_back(Job{games[k],""});
+  if (!manifest.empty())
+    {
+      vector<string> lines;
+      if (!readLines(manifest,lines))
+	{
+	  cerr << "Could not read manifest " << manifest << endl;
+	  return 2;
+	}
+      for (int l = 0; l < lines.size(); l++)
+	{
+	  stringstream ss(lines[l]);
+	  Job job;
+	  ss >> job.game >> job.output;
+	  jobs.push_back(job);
+	}
+    }
+
+  if (jobs.empty()
+      || (format != "archive" && format != "csv" && format != "none")
+      || (stats != "csv" && stats != "json")
+      || (!output.empty() && jobs.size() > 1))
+    {
+      cerr << usage << endl;
+      return 2;
+    }
+  if (!output.empty())
+    jobs[0].output = output;
+  for (int k = 0; k < jobs.size(); k++)
+    {
+      if (format == "none")
+	jobs[k].output = "";
+      else if (jobs[k].output.empty())
+	jobs[k].output = outputPath(jobs[k].game,outputDir,format);
+    }
+
+  numThreads = numWorkerThreads(numThreads,jobs.size());
+
+  // Records are written as soon as each game is done, so that
+  // partial results survive an interrupted run.
+  std::mutex outputMutex;
+  int numRecords = 0;
+  bool failed = false;
+  if (stats == "csv")
+    cout << csvHeader() << endl;
+  else
+    cout << "[" << endl;
+
+  parallelFor(jobs.size(),numThreads,[&](int job, int thread)
+	      {
+		Record record = solve(jobs[job],params,format);
+
+		std::lock_guard<std::mutex> lock(outputMutex);
+		if (stats == "csv")
+		  cout << toCSV(record) << endl;
+		else
+		  cout << (numRecords > 0? ",\n  ": "  ") << toJSON(record) << flush;
+		numRecords++;
+		if (record.status != "ok")
+		  failed = true;
+	      });
+
+  if (stats == "json")
+    cout << "\n]" << endl;
+
+  return (failed? 1: 0);
+}
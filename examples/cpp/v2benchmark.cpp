@@ -0,0 +1,146 @@
+// This file is part of the SGSolve library for stochastic games
+// Copyright (C) 2016 Benjamin A. Brooks
+// 
+// SGSolve free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// SGSolve is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see
+// <http://www.gnu.org/licenses/>.
+// 
+// Benjamin A. Brooks
+// ben@benjaminbrooks.net
+// Chicago, IL
+
+//! Compares SGSolver_V2 with SGSolver on the example games.
+//! @example
+#include "sg.hpp"
+#include "sgsolver_v2.hpp"
+#include "risksharing.hpp"
+
+//! Prisoners' dilemma from pd.cpp
+SGGame prisonersDilemma()
+{
+  int numStates = 1;
+  vector< vector<int> > numActions(numStates,vector<int>(2,2));
+  vector< vector< vector<double> > > 
+    payoffs(numStates,vector< vector<double> >(4,vector<double>(2,0.0)));
+  payoffs[0][1][0] = -1; payoffs[0][1][1] = 3;
+  payoffs[0][2][0] = 3; payoffs[0][2][1] = -1;
+  payoffs[0][3][0] = 2; payoffs[0][3][1] = 2;
+
+  vector< vector< vector<double> > >
+    probabilities(numStates,vector< vector<double> >(4,vector<double>(numStates,1.0)));
+
+  return SGGame(0.7,numStates,numActions,payoffs,probabilities,
+		vector<bool>(2,false));
+}
+
+//! Two state version of the Abreu and Sannikov example from
+//! as_twostate.cpp
+SGGame abreuSannikovTwoState()
+{
+  int numStates = 2;
+  vector< vector<int> > numActions(numStates,vector<int>(2,3));
+
+  double stagePayoffs[9][2] = { {16,9}, {21,1}, {9,0},
+				{3,13}, {10,4}, {5,-4},
+				{1,3}, {-1,0}, {-5,-10} };
+  vector< vector< vector<double> > > 
+    payoffs(numStates,vector< vector<double> >(9,vector<double>(2,0.0)));
+  vector< vector< vector<double> > >
+    probabilities(numStates,vector< vector<double> >(9,vector<double>(numStates,0.0)));
+  double persistence = 0.3;
+  for (int state = 0; state < numStates; state++)
+    {
+      for (int action = 0; action < 9; action++)
+	{
+	  payoffs[state][action][0] = stagePayoffs[action][0];
+	  payoffs[state][action][1] = stagePayoffs[action][1];
+	  probabilities[state][action][state] = persistence;
+	  probabilities[state][action][1-state] = 1-persistence;
+	} // action
+    } // state
+
+  return SGGame(0.45,numStates,numActions,payoffs,probabilities,
+		vector<bool>(2,false));
+}
+
+//! Largest gap between the final hyperplanes of SGSolver_V2 and the
+//! last revolution of SGSolver.
+double compare(const SGSolution & soln, const SGSolution_V2 & soln_V2)
+{
+  // With SG::STOREITERATIONS equal to 1, only the last revolution is
+  // stored, and its first iteration indicates where it starts.
+  int start = soln.getIterations().front().getNumExtremeTuples();
+  vector<SGTuple> tuples(soln.getExtremeTuples().begin(),
+			 soln.getExtremeTuples().end());
+
+  double gap = 0;
+  const list<SGHyperplane> & hyperplanes
+    = soln_V2.getIterations().back().getHyperplanes();
+  for (auto hp = hyperplanes.begin(); hp != hyperplanes.end(); ++hp)
+    {
+      for (int state = 0; state < hp->size(); state++)
+	{
+	  double level = -numeric_limits<double>::max();
+	  for (int k = start; k < tuples.size(); k++)
+	    level = std::max(level,tuples[k][state]*hp->getNormal());
+	  gap = std::max(gap,abs((*hp)[state]-level));
+	} // state
+    } // hp
+  return gap;
+}
+
+void benchmark(const string & name, const SGGame & game)
+{
+  SGEnv env;
+  env.setParam(SG::STOREITERATIONS,1);
+  env.setParam(SG::STOREACTIONS,false);
+  env.setParam(SG::PRINTTOCOUT,false);
+  env.setParam(SG::ERRORTOL,1e-8);
+
+  SGSolver solver(env,game);
+  std::clock_t start = std::clock();
+  solver.solve();
+  double duration = (std::clock() - start) / (double) CLOCKS_PER_SEC;
+
+  SGSolver_V2 solver_V2(env,game);
+  start = std::clock();
+  solver_V2.solve();
+  double duration_V2 = (std::clock() - start) / (double) CLOCKS_PER_SEC;
+
+  cout << name << ": SGSolver " << duration << "s, SGSolver_V2 "
+       << duration_V2 << "s with "
+       << solver_V2.getSolution().getIterations().back().getIteration()
+       << " revolutions and "
+       << solver_V2.getSolution().getIterations().back().getHyperplanes().size()
+       << " hyperplanes, largest gap "
+       << compare(solver.getSolution(),solver_V2.getSolution()) << endl;
+}
+
+int main ()
+{
+  try
+    {
+      benchmark("Prisoners' dilemma",prisonersDilemma());
+      benchmark("Two state Abreu-Sannikov",abreuSannikovTwoState());
+
+      RiskSharingGame rsg(0.7,5,10,0,RiskSharingGame::Consumption);
+      benchmark("Risk sharing",SGGame(rsg));
+    }
+  catch (SGException e)
+    {
+      cout << "Caught the following exception:" << endl
+	   << e.what() << endl;
+    }
+
+  return 0;
+}
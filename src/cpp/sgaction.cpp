@@ -91,7 +91,6 @@ void SGAction::intersectRaySegment(const SGPoint& normal,
 	{
 	  // Both lie above the ray.
 	  segment.clear();
-	  bndryNormals.clear();
 	}
       else if (l0 < level
 	       && l1 < level)
@@ -130,7 +129,7 @@ void SGAction::intersectRaySegment(const SGPoint& normal,
     }
 }
 
-void SGAction::calculateMinIC(const SGGame & game,
+void SGAction::calculateMinIC(const SGGameAccessor & game,
 			      const vector<bool> & update,
 			      const SGTuple & threatTuple)
 {
@@ -148,7 +147,7 @@ void SGAction::calculateMinIC(const SGGame & game,
 } // calculateMinIC
 
 double SGAction::calculateMinIC(int action,int state,int player,
-				const SGGame & game,
+				const SGGameAccessor & game,
 				const SGTuple & threatTuple)
 {
   vector<int> playersActions, playersDeviations;
@@ -171,9 +170,9 @@ double SGAction::calculateMinIC(int action,int state,int player,
 				     game.getNumActions()[state]);
       currentGains 
 	= (1-game.getDelta())/game.getDelta() 
-	* (game.getPayoffs()[state][deviationIndex][player] 
-	   - game.getPayoffs()[state][action][player])
-	+ threatTuple.expectation(game.getProbabilities()[state][deviationIndex], 
+	* (game.getPayoff(state,deviationIndex)[player] 
+	   - game.getPayoff(state,action)[player])
+	+ threatTuple.expectation(game.getTransitions(state,deviationIndex), 
 				  player);
 
       if (currentGains > minIC)
@@ -183,47 +182,58 @@ double SGAction::calculateMinIC(int action,int state,int player,
   return minIC;
 }
 
-void SGAction::calculateBindingContinuations(const SGGame & game,
-					     const vector<SGHyperplane> & W)
+void SGAction::calculateBindingContinuations(const SGGameAccessor & game,
+					     const vector<SGPoint> & normals,
+					     const double * expLevels)
 {
-  // Version used with SGSolver_V2
-  
-  // Reset the binding continuations and then iteratively trim.
-  SGPoint point = minIC;
-  points[0].clear();
-  points[0].push_back(point);
-  point[1] = numeric_limits<double>::max();
-  points[0].push_back(point);
-  point[1] =  minIC[1];
-  points[1].push_back(point);
-  point[0] = numeric_limits<double>::max();
-  points[1].push_back(point);
-  
-  // cout << points.size() << endl;
-  // cout << points[0].size() << endl;
-  // cout << points[0] << " " << points[1] << endl;
-  
-  for (auto it = W.begin(); it != W.end(); ++it)
+  // Version used with SGSolver_V2. Player i's incentive constraint
+  // binds on the line where player i's continuation value is
+  // minIC[i]. Intersect that line with each of the expected half
+  // planes, and with player j's incentive constraint, to find the
+  // range of player j's continuation values on the line.
+  for (int player = 0; player < game.getNumPlayers(); player++)
     {
-      for (int p = 0; p < game.getNumPlayers(); p++)
-	intersectRaySegment(it->getNormal(),
-			    it->expectation(game.getProbabilities()
-					    [state][action]),
-			    points[p]);
-    }
+      int other = 1-player;
+      points[player].clear();
+      tuples[player].clear();
 
-  if (points[0].size()>0)
-    highestPoint = points[0][1];
-  else if (points[1].size()>0)
-    highestPoint = points[1][0];
-  else
-    highestPoint = -numeric_limits<double>::max();
-  
+      if (game.getConstrained()[player])
+	continue;
+
+      double lowest = minIC[other];
+      double highest = numeric_limits<double>::max();
+      bool empty = false;
+      for (int k = 0; k < normals.size() && !empty; k++)
+	{
+	  const SGPoint & normal = normals[k];
+	  double slack = expLevels[k] - normal[player]*minIC[player];
+	  if (abs(normal[other]) < env.getParam(SG::NORMTOL))
+	    empty = slack < -env.getParam(SG::ICTOL);
+	  else if (normal[other] > 0)
+	    highest = std::min(highest,slack/normal[other]);
+	  else
+	    lowest = std::max(lowest,slack/normal[other]);
+	} // k
+
+      if (empty || lowest > highest + env.getParam(SG::ICTOL)
+	  || highest == numeric_limits<double>::max())
+	continue;
+      highest = std::max(highest,lowest);
+
+      // Northern or eastern point first.
+      SGPoint point = minIC;
+      point[other] = highest;
+      points[player].push_back(point);
+      point[other] = lowest;
+      points[player].push_back(point);
+      tuples[player] = vector<int>(2,-1);
+    } // player
 } // calculateBindingContinuations
 
 void SGAction::calculateBindingContinuations(const vector<bool> & updatedThreatTuple,
-					     const SGGame & game,
+					     const SGGameAccessor & game,
 					     const vector<SGTuple> & extremeTuples,
+					     const SGAngularIndex & angularIndex,
 					     const SGTuple & threatTuple,
 					     const SGTuple & pivot,
 					     const SGPoint & currentDirection,
@@ -232,10 +242,6 @@ void SGAction::calculateBindingContinuations(const vector<bool> & updatedThreatT
   // Calculates the IC intersection points. To be used after updating
   // the threat tuple.
   int numPlayers = 2;
-  int tupleIndex;
-  SGPoint intersection, point, nextPoint;
-
-  reverse_iterator< vector<SGTuple>::const_iterator > tuple, nextTuple;
 	      
   vector<SGTuple> newPoints(2);
   vector< vector<int> > newTuples(2,vector<int>(0,0));
@@ -247,22 +253,31 @@ void SGAction::calculateBindingContinuations(const vector<bool> & updatedThreatT
 
       tuples[player].clear(); 
       points[player].clear();
-      bndryNormals[player].clear();
-	      
-      nextPoint = extremeTuples.back()
-	.expectation(game.getProbabilities()
-		     [state][action]);
-
-      for (tuple = extremeTuples.rbegin(),
-	     nextTuple = tuple+1,
-	     tupleIndex = extremeTuples.size()-1; 
- 	   tupleIndex > oldWest;
-	   // nextTuple != extremeTuples.rend(); 
-	   ++tuple,++nextTuple, --tupleIndex)
+
+      const vector<double> & transitions = game.getTransitions(state,action);
+
+      // The walk back from the last extreme tuple stops at the first
+      // tuple that is below the threat tuple, but within
+      // env.getParam(SG::PASTTHREATTOL)/2.0 of it.
+      auto pastThreat = [&](int tupleIndex)
 	{
-	  point = nextPoint;
-	  nextPoint = nextTuple->expectation(game.getProbabilities()
-					     [state][action]);
+	  return extremeTuples[tupleIndex].strictlyLessThan(threatTuple,player) 
+	    && !threatTuple
+	    .strictlyLessThan(extremeTuples[tupleIndex]
+			      +SGPoint(env.getParam(SG::PASTTHREATTOL)/2.0),
+			      player);
+	};
+      auto expectation = [&](int tupleIndex)
+	{
+	  return extremeTuples[tupleIndex].expectation(transitions)[player];
+	};
+
+      // Compares the segment from tuple tupleIndex to tupleIndex-1
+      // against the minimum IC payoff.
+      auto checkSegment = [&](int tupleIndex)
+	{
+	  SGPoint point = extremeTuples[tupleIndex].expectation(transitions);
+	  SGPoint nextPoint = extremeTuples[tupleIndex-1].expectation(transitions);
 
 	  double gap = point[player] - nextPoint[player];
 	  if ( abs(gap) < env.getParam(SG::FLATTOL)
@@ -284,17 +299,84 @@ void SGAction::calculateBindingContinuations(const vector<bool> & updatedThreatT
 	      newTuples[player].push_back(tupleIndex);
 	      newPoints[player].push_back((1-alpha)*nextPoint + alpha*point);
 	    }
+	};
+
+      int pieceEnd = extremeTuples.size()-1;
+      bool foundThreat = false;
+      while (pieceEnd > oldWest && !foundThreat)
+	{
+	  // This player's payoffs are monotone in every state along
+	  // tuples pieceStart through pieceEnd, so the expected
+	  // payoffs are monotone as well.
+	  int pieceStart = std::max(angularIndex.getPieceStart(player,pieceEnd),
+				    oldWest);
+
+	  // Segments are indexed by the higher of their two tuples. The
+	  // last segment to check is the one at the first tuple past
+	  // the threat tuple.
+	  int lowSegment = pieceStart+1, highSegment = pieceEnd;
+	  if (pastThreat(highSegment))
+	    {
+	      lowSegment = highSegment;
+	      foundThreat = true;
+	    }
+	  else if (pastThreat(lowSegment))
+	    {
+	      int below = lowSegment, above = highSegment;
+	      while (above - below > 1)
+		{
+		  int middle = (below + above)/2;
+		  if (pastThreat(middle))
+		    below = middle;
+		  else
+		    above = middle;
+		}
+	      lowSegment = below;
+	      foundThreat = true;
+	    }
+
+	  // Only segments within env.getParam(SG::FLATTOL) of minIC
+	  // can flank it or form a flat. Orient the expected payoffs so
+	  // that they increase along the piece, and bisect for the
+	  // first and last such segments.
+	  double sign = (expectation(highSegment) >= expectation(lowSegment-1)
+			 ? 1.0 : -1.0);
+	  double lowLevel = sign*minIC[player] - env.getParam(SG::FLATTOL);
+	  double highLevel = sign*minIC[player] + env.getParam(SG::FLATTOL);
+
+	  int first = lowSegment, last = highSegment;
+	  if (sign*expectation(first) < lowLevel)
+	    {
+	      int below = first, above = highSegment+1;
+	      while (above - below > 1)
+		{
+		  int middle = (below + above)/2;
+		  if (sign*expectation(middle) < lowLevel)
+		    below = middle;
+		  else
+		    above = middle;
+		}
+	      first = above;
+	    }
+	  if (sign*expectation(last-1) > highLevel)
+	    {
+	      int below = lowSegment-1, above = last;
+	      while (above - below > 1)
+		{
+		  int middle = (below + above)/2;
+		  if (sign*expectation(middle-1) > highLevel)
+		    above = middle;
+		  else
+		    below = middle;
+		}
+	      last = below;
+	    }
+
+	  for (int tupleIndex = last; tupleIndex >= first; tupleIndex--)
+	    checkSegment(tupleIndex);
 
-	  // Break when the payoff for this player is below
-	  // but within env.getParam(SG::PASTTHREATTOL)/2.0 of the threat
-	  // tuple
-	  if ( tuple->strictlyLessThan(threatTuple,player) 
-	       && !threatTuple
-	       .strictlyLessThan(*tuple
-				 +SGPoint(env.getParam(SG::PASTTHREATTOL)/2.0),
-				 player) )
-	    break;
-	} // for point
+	  pieceEnd = pieceStart;
+	} // while
     } // player
 	
   for (int player = 0; player < numPlayers; player++)
@@ -325,7 +407,7 @@ void SGAction::calculateBindingContinuations(const vector<bool> & updatedThreatT
 		}
 
 	      SGPoint expPivot 
-		= pivot.expectation(game.getProbabilities()[state][getAction()]);
+		= pivot.expectation(game.getTransitions(state,getAction()));
 	      intersectRaySegment(expPivot,currentDirection,player);
 	    }
 	  // Otherwise, not IC.
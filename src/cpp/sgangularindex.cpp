@@ -0,0 +1,133 @@
+// This file is part of the SGSolve library for stochastic games
+// Copyright (C) 2016 Benjamin A. Brooks
+// 
+// SGSolve free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// SGSolve is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see
+// <http://www.gnu.org/licenses/>.
+// 
+// Benjamin A. Brooks
+// ben@benjaminbrooks.net
+// Chicago, IL
+
+#include "sgangularindex.hpp"
+
+double SGAngularIndex::turn(const SGPoint & from, const SGPoint & to)
+{
+  // Clockwise rotation from one direction to the next. Directions
+  // that bend back counterclockwise do not advance the angle.
+  double radians = atan2(from[1],from[0]) - atan2(to[1],to[0]);
+  if (radians < 0)
+    radians += 2*PI;
+  if (radians > PI)
+    radians = 0;
+  return radians;
+} // turn
+
+void SGAngularIndex::clear()
+{
+  angles.clear();
+  directions.clear();
+  for (int player = 0; player < 2; player++)
+    {
+      pieceStarts[player].clear();
+      pieceSigns[player].clear();
+    }
+} // clear
+
+void SGAngularIndex::push_back(const SGPoint & direction)
+{
+  vector<signed char> edgeSigns(2,0);
+
+  if (angles.size() == 0)
+    angles.push_back(0);
+  else
+    {
+      if (directions.size() > 1)
+	angles.push_back(angles.back()+turn(directions.back(),direction));
+      else
+	angles.push_back(0);
+
+      for (int player = 0; player < 2; player++)
+	edgeSigns[player] = (direction[player]>0) - (direction[player]<0);
+    }
+  directions.push_back(direction);
+
+  for (int player = 0; player < 2; player++)
+    {
+      pieceStarts[player].push_back(0);
+      pieceSigns[player].push_back(0);
+    }
+  classifyBack(edgeSigns);
+} // push_back
+
+void SGAngularIndex::mergeBack(const SGPoint & direction)
+{
+  if (angles.size() < 2)
+    return;
+
+  // The merged edge is monotone only if both moves go the same way.
+  vector<signed char> edgeSigns(2,0);
+  for (int player = 0; player < 2; player++)
+    {
+      signed char oldSign = (directions.back()[player]>0)
+	- (directions.back()[player]<0);
+      signed char newSign = (direction[player]>0) - (direction[player]<0);
+      if (oldSign == 0 || oldSign == newSign)
+	edgeSigns[player] = newSign;
+      else if (newSign == 0)
+	edgeSigns[player] = oldSign;
+      else
+	edgeSigns[player] = 2;
+    }
+  directions.back() = direction;
+  if (angles.size() > 2)
+    angles.back() = angles[angles.size()-2]
+      + turn(directions[directions.size()-2],direction);
+  classifyBack(edgeSigns);
+} // mergeBack
+
+void SGAngularIndex::classifyBack(const vector<signed char> & edgeSigns)
+{
+  int k = angles.size()-1;
+  for (int player = 0; player < 2; player++)
+    {
+      if (k == 0)
+	{
+	  pieceStarts[player][k] = 0;
+	  pieceSigns[player][k] = 0;
+	  continue;
+	}
+
+      signed char previous = pieceSigns[player][k-1];
+      signed char edge = edgeSigns[player];
+      if (edge != 2 && previous != 2
+	  && (edge == 0 || previous == 0 || edge == previous))
+	{
+	  // Extends the current piece.
+	  pieceStarts[player][k] = pieceStarts[player][k-1];
+	  pieceSigns[player][k] = (edge == 0? previous : edge);
+	}
+      else
+	{
+	  // Turning point at tuple k-1.
+	  pieceStarts[player][k] = k-1;
+	  pieceSigns[player][k] = edge;
+	}
+    } // player
+} // classifyBack
+
+int SGAngularIndex::findAngle(int k, double angle) const
+{
+  return (upper_bound(angles.begin()+k,angles.end(),angles[k]+angle)
+	  - angles.begin()) - 1;
+} // findAngle
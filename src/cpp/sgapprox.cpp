@@ -34,7 +34,8 @@ void SGApprox::initialize()
   
   oldWest = 0; westPoint = 0; newWest = 0;
 
-  logfs.open("sg.log",std::ofstream::out);
+  if (env.getParam(SG::PRINTTOLOG))
+    logfs.open("sg.log",std::ofstream::out);
 
   SGPoint payoffUB, payoffLB;
   game.getPayoffBounds(payoffUB,payoffLB);
@@ -57,6 +58,8 @@ void SGApprox::initialize()
 	  actions[state].push_back(SGAction(env,state,action));
     } // state
 
+  pruneActions();
+
   pivot = SGTuple(numStates);
   actionTuple = vector< const SGAction* >(numStates,&nullAction);
   regimeTuple = vector<SG::Regime>(numStates,SG::Binding);
@@ -70,6 +73,13 @@ void SGApprox::initialize()
   extremeTuples.push_back(SGTuple(numStates,SGPoint(payoffLB[0],payoffLB[1]))); 
   extremeTuples.push_back(SGTuple(numStates,SGPoint(payoffLB[0],payoffUB[1]))); 
 
+  angularIndex.clear();
+  angularIndex.push_back(SGPoint(0,0));
+  angularIndex.push_back(SGPoint(1,0));
+  angularIndex.push_back(SGPoint(0,-1));
+  angularIndex.push_back(SGPoint(-1,0));
+  angularIndex.push_back(SGPoint(0,1));
+
   if (env.getParam(SG::PRINTTOLOG))
     {
       for (int point=0; point < extremeTuples.size(); point++)
@@ -99,6 +109,93 @@ void SGApprox::initialize()
   
 } // initialize
 
+void SGApprox::pruneActions()
+{
+  numPrunedActions = 0;
+  if (env.getParam(SG::PRUNEPASSES) == 0)
+    return;
+
+  SGPoint payoffUB, payoffLB;
+  game.getPayoffBounds(payoffUB,payoffLB);
+  SGTuple upperBound(numStates,payoffUB), lowerBound(numStates,payoffLB);
+
+  int numActionsTotal = 0;
+  for (int state = 0; state < numStates; state++)
+    numActionsTotal += actions[state].size();
+
+  for (int pass = 0; pass < env.getParam(SG::PRUNEPASSES); pass++)
+    {
+      int numPruned = 0;
+      double boundChange = 0;
+      SGTuple newUpperBound(upperBound), newLowerBound(lowerBound);
+
+      for (int state = 0; state < numStates; state++)
+	{
+	  SGPoint stateUB(-numeric_limits<double>::max()),
+	    stateLB(numeric_limits<double>::max());
+
+	  list<SGAction>::iterator action = actions[state].begin();
+	  while (action != actions[state].end())
+	    {
+	      int a = action->getAction();
+	      const SGPoint & payoff = game.getPayoff(state,a);
+
+	      // Equilibrium payoffs are at least the flow payoff plus
+	      // the smallest continuation value that satisfies the IC
+	      // constraint with respect to the lower bounds, and at most
+	      // the flow payoff plus the expected upper bound.
+	      bool supportable = true;
+	      SGPoint minCont, maxCont;
+	      for (int player = 0; player < numPlayers; player++)
+		{
+		  maxCont[player] = upperBound.expectation(game.getTransitions(state,a),
+							   player);
+		  if (game.getConstrained()[player])
+		    minCont[player] = lowerBound.expectation(game.getTransitions(state,a),
+							     player);
+		  else
+		    minCont[player] = SGAction::calculateMinIC(a,state,player,
+							       game,lowerBound);
+
+		  if (minCont[player] > maxCont[player] + env.getParam(SG::ICTOL))
+		    supportable = false;
+		}
+
+	      if (!supportable)
+		{
+		  action = actions[state].erase(action);
+		  numPruned++;
+		  continue;
+		}
+
+	      stateUB.max((1-delta)*payoff+delta*maxCont);
+	      stateLB.min((1-delta)*payoff+delta*minCont);
+	      ++action;
+	    } // action
+
+	  if (actions[state].size() == 0)
+	    continue;
+
+	  newUpperBound[state].min(stateUB);
+	  newLowerBound[state].max(stateLB);
+	  boundChange = max(boundChange,
+			    max(SGPoint::distance(newUpperBound[state],upperBound[state]),
+				SGPoint::distance(newLowerBound[state],lowerBound[state])));
+	} // state
+
+      upperBound = newUpperBound;
+      lowerBound = newLowerBound;
+      numPrunedActions += numPruned;
+
+      if (numPruned == 0 && boundChange < env.getParam(SG::ERRORTOL))
+	break;
+    } // pass
+
+  if (env.getParam(SG::PRINTTOCOUT))
+    cout << "Eliminated " << numPrunedActions << " of "
+	 << numActionsTotal << " actions before the first iteration." << endl;
+} // pruneActions
+
 void SGApprox::logAppend(ofstream & logfs, 
 			 int iter, int rev, const SGTuple & tuple,
 			 int state, int action)
@@ -200,8 +297,8 @@ void SGApprox::findBestDirection()
 	{
 	  SG::Regime bestBindingRegime = SG::Binding;
 
-	  SGPoint expPivot = pivot.expectation(game.getProbabilities()[state][action->getAction()]);
-	  SGPoint stagePayoff = game.getPayoffs()[state][action->getAction()];
+	  SGPoint expPivot = pivot.expectation(game.getTransitions(state,action->getAction()));
+	  SGPoint stagePayoff = game.getPayoff(state,action->getAction());
 	  SGPoint nonBindingPayoff = (1-delta) * stagePayoff + delta * expPivot;
 	  SGPoint nonBindingDirection = nonBindingPayoff - pivot[state];
 	  double nonBindingNorm = nonBindingDirection.norm();
@@ -287,40 +384,95 @@ void SGApprox::findBestDirection()
 			       (point == 1 && player == 1 && !action->hasCorner()))
 			{
 			  // Also determine slope of feasible set clockwise
-			  // relative to the binding payoff.
-			  int nextPoint = action->getTuples()[player][point];
-			  while (nextPoint < extremeTuples.size())
+			  // relative to the binding payoff. Moving clockwise
+			  // along the expected trajectory, the binding level
+			  // rises until the tangent from the pivot and falls
+			  // after it, and the tangent is reached before the
+			  // direction turns by half a revolution. Both the
+			  // tangent and the first tuple above the
+			  // non-binding direction are found by bisection.
+			  // Incentive compatibility is not monotone along the
+			  // trajectory, so it is checked separately.
+			  const vector<double> & transitions
+			    = game.getTransitions(state,action->getAction());
+			  auto nextDirection = [&](int tupleIndex)
 			    {
-			      SGPoint newExpContVal = extremeTuples[nextPoint]
-				.expectation(game.getProbabilities()[state][action->getAction()]);
-			      SGPoint nextDirection = (1-delta)*stagePayoff
-				+ delta*newExpContVal
+			      return (1-delta)*stagePayoff
+				+ delta*extremeTuples[tupleIndex].expectation(transitions)
 				- pivot[state];
-			      double nextBindingLevel
-				= (nextDirection*nonBindingNormal)
-				/ std::sqrt(nonBindingNorm * nextDirection.norm());
-
-			      if (nextBindingLevel > bindingLevel
-				  && newExpContVal >= action->getMinICPayoffs())
-				{
-				  bindingLevel = nextBindingLevel;
-				  bindingDirections[point] = nextDirection;
-
-				  if (bindingLevel > -env.getParam(SG::LEVELTOL)
+			    };
+			  auto nextBindingLevel = [&](const SGPoint & direction)
+			    {
+			      return (direction*nonBindingNormal)
+				/ std::sqrt(nonBindingNorm * direction.norm());
+			    };
+			  // True if the binding level rises at tupleIndex.
+			  int firstPoint = action->getTuples()[player][point];
+			  auto rises = [&](int tupleIndex)
+			    {
+			      double previousLevel = (tupleIndex == firstPoint? bindingLevel
+						      : nextBindingLevel(nextDirection(tupleIndex-1)));
+			      return nextBindingLevel(nextDirection(tupleIndex)) > previousLevel;
+			    };
+			  auto isAbove = [&](int tupleIndex)
+			    {
+			      SGPoint direction = nextDirection(tupleIndex);
+			      return (nextBindingLevel(direction) > -env.getParam(SG::LEVELTOL)
 				      && (!foundAbove
 					  || improves(aboveDirection,
 						      nonBindingDirection,
-						      bindingDirections[point]) ) )
+						      direction) ) );
+			    };
+
+			  if (firstPoint < extremeTuples.size() && rises(firstPoint))
+			    {
+			      // Find the tangent by galloping and then
+			      // bisecting.
+			      int lastPoint = angularIndex.findAngle(firstPoint,PI);
+			      int risePoint = firstPoint, fallPoint = firstPoint+1, step = 1;
+			      while (fallPoint <= lastPoint && rises(fallPoint))
+				{
+				  risePoint = fallPoint;
+				  step *= 2;
+				  fallPoint = std::min(risePoint + step, lastPoint + 1);
+				}
+			      while (fallPoint - risePoint > 1)
+				{
+				  int middle = (risePoint + fallPoint)/2;
+				  if (rises(middle))
+				    risePoint = middle;
+				  else
+				    fallPoint = middle;
+				}
+
+			      if (isAbove(risePoint))
+				{
+				  int belowPoint = firstPoint-1, abovePoint = risePoint;
+				  while (abovePoint - belowPoint > 1)
 				    {
-				      aboveDirection = bindingDirections[point];
+				      int middle = (belowPoint + abovePoint)/2;
+				      if (isAbove(middle))
+					abovePoint = middle;
+				      else
+					belowPoint = middle;
+				    }
+
+				  // The continuation values up to abovePoint
+				  // must all be IC. If one is not, the range
+				  // ends before it, and abovePoint is the first
+				  // tuple above, so nothing in the range is.
+				  int icPoint = firstPoint;
+				  while (icPoint <= abovePoint
+					 && extremeTuples[icPoint].expectation(transitions)
+					 >= action->getMinICPayoffs())
+				    icPoint++;
+
+				  if (icPoint > abovePoint)
+				    {
+				      aboveDirection = nextDirection(abovePoint);
 				      foundAbove = true;
-				      break;
 				    }
-				  
-				  nextPoint++;
 				}
-			      else // Already reached maximum bindingLevel.
-				break;
 			    }
 			}
 
@@ -467,7 +619,7 @@ void SGApprox::calculateNewPivot()
 
 	      tempMovement = (delta*actionTuple[state]->getMinICPayoffs()[player]
 			      -pivot[state][player]
-			      +(1-delta)*game.getPayoffs()[state][actionTuple[state]->getAction()][player])
+			      +(1-delta)*game.getPayoff(state,actionTuple[state]->getAction())[player])
 		/ currentDirection[player];
 	      
 	      if (tempMovement < maxMovement[state]
@@ -506,8 +658,8 @@ void SGApprox::calculateNewPivot()
       if (regimeTuple[state]==SG::NonBinding)
 	{
 	  SGPoint tempPayoff( (1-delta)
-			      *game.getPayoffs()[state][actionTuple[state]->getAction()] 
-			      +delta*pivot.expectation(game.getProbabilities()[state][actionTuple[state]->getAction()]) );
+			      *game.getPayoff(state,actionTuple[state]->getAction()) 
+			      +delta*pivot.expectation(game.getTransitions(state,actionTuple[state]->getAction())) );
 	  
 	  assert( SGPoint::distance(tempPayoff, pivot[state]) < 1e-8 );
 	  if ( SGPoint::distance(tempPayoff, pivot[state]) > 1e-5 )
@@ -523,9 +675,13 @@ void SGApprox::calculateNewPivot()
     {
       // cout << "Flat detected!" << endl;
       extremeTuples.back() = pivot;
+      angularIndex.mergeBack(currentDirection);
     }
   else
-    extremeTuples.push_back(pivot);
+    {
+      extremeTuples.push_back(pivot);
+      angularIndex.push_back(currentDirection);
+    }
 
   if (env.getParam(SG::PRINTTOLOG))
     {
@@ -555,10 +711,12 @@ double SGApprox::updatePivot(vector<double> & movements,
 
       assert(regimeTuple[state]==SG::NonBinding);
 
+      const vector<double> & transitions
+	= game.getTransitions(state,actionTuple[state]->getAction());
       for (int statep = 0; statep < numStates; statep++)
 	{
 	  tempChange[state] += delta* 
-	    game.getProbabilities()[state][actionTuple[state]->getAction()][statep]
+	    transitions[statep]
 	    * changes[statep];
 	}
     }
@@ -748,6 +906,7 @@ void SGApprox::calculateBindingContinuations()
 	
 	  action->calculateBindingContinuations(updatedThreatTuple,
 						game,extremeTuples,
+						angularIndex,
 						threatTuple,
 						pivot,currentDirection,
 						oldWest);
@@ -782,7 +941,7 @@ void SGApprox::trimBindingContinuations()
 	  // Check if the line starting from pivot towards direction
 	  // cuts any of the intersection lines.
 	  expPivot 
-	    = pivot.expectation(game.getProbabilities()[state][action->getAction()]);
+	    = pivot.expectation(game.getTransitions(state,action->getAction()));
 
 	  action->trim(expPivot,currentDirection);
 
@@ -23,16 +23,15 @@
 
 void SGApprox_V2::end()
 {
-  // testOFS.close();
   logfs.close();
 }
 
 void SGApprox_V2::initialize()
 {
-  int state, iter, action;
+  int state, action;
 
-  logfs.open("sg_v2.log",std::ofstream::out);
-  // testOFS.open("test.log",std::ofstream::out);
+  if (env.getParam(SG::PRINTTOLOG))
+    logfs.open("sg_v2.log",std::ofstream::out);
 
   game.getPayoffBounds(payoffUB,payoffLB);
 
@@ -54,21 +53,23 @@ void SGApprox_V2::initialize()
 	  actions[state].push_back(SGAction(env,state,action));
     } // state
 
-  pivot = SGTuple(numStates);
   actionTuple = vector< const SGAction* >(numStates,&nullAction);
   regimeTuple = vector<SG::Regime>(numStates,SG::Binding);
   threatTuple = SGTuple(numStates,payoffLB);
+  updatedThreatTuple = vector<bool>(2,true);
+  updatedThreatStates = vector< vector<bool> >(2,vector<bool>(numStates,true));
 
   // Initialize feasible set
   W.clear(); W.reserve(env.getParam(SG::TUPLERESERVESIZE));
-  W.push_back(SGHyperplane(SGPoint(1.0,0.0),
-			   vector<double>(numStates,payoffUB[0])));
   W.push_back(SGHyperplane(SGPoint(0.0,1.0),
 			   vector<double>(numStates,payoffUB[1])));
-  W.push_back(SGHyperplane(SGPoint(-1.0,0.0),
-			   vector<double>(numStates,-payoffLB[0])));
+  W.push_back(SGHyperplane(SGPoint(1.0,0.0),
+			   vector<double>(numStates,payoffUB[0])));
   W.push_back(SGHyperplane(SGPoint(0.0,-1.0),
 			   vector<double>(numStates,-payoffLB[1])));
+  W.push_back(SGHyperplane(SGPoint(-1.0,0.0),
+			   vector<double>(numStates,-payoffLB[0])));
+  Wp.clear(); Wp.reserve(env.getParam(SG::TUPLERESERVESIZE));
 
   if (env.getParam(SG::PRINTTOLOG))
     {
@@ -79,237 +80,104 @@ void SGApprox_V2::initialize()
   // Initialize the currDir and pivot.
   currDir = SGPoint(payoffUB[0]-payoffLB[0],0.0);
   pivot = SGTuple(numStates,SGPoint(payoffLB[0],payoffUB[1]));
-  currLevels = vector<double> (numStates,payoffUB[1]);
 
   numIterations = 0; 
-  numSteps = -1;
+  numSteps = 0;
   bestRegime = SG::Binding;
   bestAction = actions[0].end();
-
-  // if (env.getParam(SG::STOREITERATIONS) == 2)
-  //   soln.push_back(SGIteration(*this,
-  // 			       env.getParam(SG::STOREACTIONS)));
-  numSteps = 0;
-
 } // initialize
 
 void SGApprox_V2::logAppend(ofstream & logfs, 
-			 int step, int iter, const SGHyperplane & hp,
-			 int state, int action)
+			    int iter, int step, const SGHyperplane & hp,
+			    int state, int action)
 {
   logfs << setw(3) << iter << " " << setw(3) << step << " "
 	<< hp << " " << setw(3) << state << " " << setw(3) << action << endl;
 }
 
-double SGApprox_V2::generate(bool storeIterations)
+double SGApprox_V2::generate(bool storeIteration)
 {
-  cout << endl << "Start of iteration " << numIterations << endl << endl;
-  
-  // Four steps. First, calculate binding continuation values
-  calculateBindingContinuations();
+  bool recordTrajectory = env.getParam(SG::STOREITERATIONS) > 0;
 
-  cout << "Payoff UB: " << payoffUB << ", payoff LB: " << payoffLB << endl;
-  cout << "Threats: " << threatTuple << endl << endl;
-  
-  for (int state = 0; state < numStates; state++)
-    {
-      for (auto ait = actions[state].begin();
-	   ait != actions[state].end();
-	   ++ait)
-	{
-	  cout << "(s,a)=(" << ait->getState() << "," << ait->getAction() << "): "
-	       << ait->getPoints()[0] << ","
-	       << ait->getPoints()[1] << ", minIC="
-	       << ait->getMinICPayoffs() << endl;
-	} // ait
-    } // state
+  // First, update the minimum IC continuation values and the binding
+  // continuation values. Both stay fixed for the whole revolution.
+  updateMinPayoffs();
+  calculateBindingContinuations();
 
-  cout << endl << "Finding initial pivot..." << endl;
-  // Find initial pivot
-  findInitialPivot();
-  
-  // Start minimizing player 1's payoff
-  currDir = SGPoint (-1,0);
-  currNrml = currDir.getNrml();
-  for (int state = 0; state < numStates; state++)
-    currLevels[state] = pivot[state][1];
-  
   Wp.clear();
-  // Wp.push_back(SGHyperplane(currNrml,currLevels));
-  
-  cout << "Pivot: " << pivot << endl
-       << "Actions: (" << actionTuple[0]->getAction() << ", "
-       << actionTuple[1]->getAction() << ")" << endl;
-  
-  cout << endl << "Computing W'..." << endl;
-  // Find the new direction
-  double minDist = numeric_limits<double>::max();
-  do
+  pivots.clear();
+  actionTuples.clear();
+  regimeTuples.clear();
+  minTuple = pivot;
+  facingWest = false;
+
+  // Twist the pivot until the direction has passed due north, which
+  // completes the revolution. Checking the direction is constant
+  // time per step.
+  bool passNorth = false;
+  while (!passNorth)
     {
-      cout << "Finding the best direction..." << endl;
-      findBestDir();
-      assert(bestAction->getState() < game.getNumStates());
-      assert(bestAction->getAction() < game.getNumActions_total()[bestAction->getState()]);
+      if (numSteps >= env.getParam(SG::MAXITERATIONS))
+	return errorLevel;
 
-      cout << "Calculating new pivot..." << endl;
-      
+      findBestDir();
       calculateNewPivot();
+      addHyperplane();
 
       for (int state = 0; state < numStates; state++)
-	currLevels[state] = pivot[state]*currNrml;
-      Wp.push_back(SGHyperplane(currNrml,currLevels));
+	minTuple[state].min(pivot[state]);
 
-      for (int state = 0; state < numStates; state++)
-      	logfs << pivot[state][0] << " " << pivot[state][1] << " ";
-      logfs << endl;
-      
-      cout << "(s,a,r)=";
-      for (int state = 0; state < numStates; state++)
+      if (recordTrajectory)
 	{
-	  cout << "(" << state << "," << actionTuple[state]->getAction();
-	  if (regimeTuple[state]==SG::Binding)
-	    cout << ", binding), ";
-	  else
-	    cout << ", non-binding), ";
+	  pivots.push_back(pivot);
+	  vector<int> actionIndices(numStates,-1);
+	  for (int state = 0; state < numStates; state++)
+	    actionIndices[state] = actionTuple[state]->getAction();
+	  actionTuples.push_back(actionIndices);
+	  regimeTuples.push_back(regimeTuple);
 	}
-      cout << endl;
-      cout << "New hyperplane: " << Wp.back() << endl;
-      cout << "New pivot: " << pivot << endl;
 
-      if (Wp.size() > 2)
-	{
-	  minDist = numeric_limits<double>::max();
-	  for (int k = 0; k < Wp.size()-2; k++)
-	    minDist = min(minDist,SGHyperplane::distance(Wp.back(),Wp[k]));
-	  cout << "Minimum distance: " << minDist << endl << endl;
-	}
-      
-      // if (env.getParam(SG::PRINTTOLOG))
-      // 	{
-      // 	  logAppend(logfs,numSteps,numIterations,hyperplane,
-      // 		    bestAction->getState(),bestAction->getAction());
-      // 	}
-      
-    } while( Wp.size()<4
-	     || minDist > 1e-10);
-  
-  // if (storeIterations)
-  //   {
-  //     soln.push_back(SGIteration(*this,
-  // 				 env.getParam(SG::STOREACTIONS)));
-  //     assert(soln.getIterations().back().getBestAction()
-  // 	     < game.getNumActions_total()[soln.getIterations().back().getBestState()]);
-  //   }
-  
-  errorLevel = distance();
-  W=Wp;
-  
-  numIterations++;
-  
-  return errorLevel;
-  
-} // generate
+      if (env.getParam(SG::PRINTTOLOG))
+	logAppend(logfs,numIterations,numSteps,Wp.back(),
+		  bestAction->getState(),bestAction->getAction());
 
-void SGApprox_V2::findInitialPivot()
-{
-  // Do policy iteration to find a first pivot. Minimize player 1's
-  // payoff.
-  
-  // Start with upper bounds on the highest payoff for all states.
-  SGPoint normal (0,1);
-  vector<double> levels(numStates,payoffUB[1]+1.0); 
-  pivot = SGTuple(numStates,SGPoint(payoffLB[0],payoffLB[1]-1.0));
-
-  double pivotError = 1.0;
-  // Iterate until convergence
-  while (pivotError > env.getParam(SG::UPDATEPIVOTTOL))
+      if (currDir[0] < -env.getParam(SG::DIRECTIONTOL))
+	facingWest = true;
+      else if (facingWest && currDir[0] > env.getParam(SG::DIRECTIONTOL))
+	passNorth = true;
+
+      numSteps++;
+    } // while
+
+  // The lowest payoffs on this revolution are the new threats.
+  for (int player = 0; player < numPlayers; player++)
     {
-      SGTuple newPivot = pivot;
-      
+      updatedThreatTuple[player] = false;
       for (int state = 0; state < numStates; state++)
 	{
-	  // Iterate over all actions to find the one that generates
-	  // the lowest payoff for player 1.
-	  
-	  double bestLevel = -numeric_limits<double>::max();
-	  
-	  for (auto ait = actions[state].begin();
-	       ait != actions[state].end();
-	       ++ait)
+	  updatedThreatStates[player][state] = false;
+	  if (minTuple[state][player] > (threatTuple[state][player]
+					 + env.getParam(SG::PASTTHREATTOL)) )
 	    {
-	      // Procedure to find an improvement to the policy
-	      // function
-	      
-	      SGPoint nonBindingPayoff = (1-delta)*game.getPayoffs()[state]
-		[ait->getAction()]
-		+ delta * pivot.expectation(game.getProbabilities()[state][ait->getAction()]);
-
-	      bool bestAPSNotBinding = false;
-	      SGPoint bestAPSPayoff;
-	      // Make this code valid for an arbitrary direction
-
-	      // Find which payoff is highest in current normal and
-	      // break ties in favor of the clockwise 90 degree.
-	      bestBindingPlayer = 0;
-	      bestBindingPoint = 0;
-	      for (int p = 0; p < numPlayers; p++)
-		{
-		  for (int k = 0; k < ait->getPoints()[p].size(); k++)
-		    {
-		      double tmpLvl = ait->getPoints()[p][k]*currDir;
-		      if (tmpLvl > bestBindLvl)
-			{
-			  bestBindingPlayer = p;
-			  bestBindingPayoff = k;
-			}
-		    } // point
-		} // player
-	      if (bndryNormals[p][k]*currDir > 0)
-		bestAPSNotBinding = true;
-
-	      if (bestAPSNotBinding
-		  || bestAPSPayoff*currDir > nonBindingPayoff*currDir)
-		{
-		  if (nonBindingPayoff*currDir > bestLevel)
-		    {
-	      	      bestLevel = nonBindingPayoff*currDir;
-	      	      regimeTuple[state] = SG::NonBinding;
-	      	      newPivot[state] = nonBindingPayoff;
-		    }
-		}
-	      else
-		{
-		  if (bestAPSPayoff*currDir > bestLevel)
-		    {
-	      	      bestLevel = bestAPSPayoff*currDir;
-	      	      regimeTuple[state] = SG::Binding;
-	      	      newPivot[state] = bestAPSPayoff;
-		    }
-		}
-	    } // ait
+	      threatTuple[state][player] = minTuple[state][player];
+	      updatedThreatTuple[player] = true;
+	      updatedThreatStates[player][state] = true;
+	    }
 	} // state
+    } // player
 
-      pivotError = SGTuple::distance(newPivot,pivot);
+  errorLevel = (numIterations < 2? 1.0: distance());
+  W.swap(Wp);
+  numIterations++;
 
-      // Now do Bellman iteration to find new fixed point
-      int updatePivotPasses = 0;
-      do
-	{
-	  pivot = newPivot;
-	  for (int state = 0; state < numStates; state++)
-	    {
-	      if (regimeTuple[state] == SG::NonBinding)
-		newPivot[state] = (1-delta)*game.getPayoffs()[state]
-		  [actionTuple[state]->getAction()]
-		  + delta*pivot.expectation(game.getProbabilities()[state]
-					    [actionTuple[state]->getAction()]);
-	    }
-	} while (SGTuple::distance(newPivot,pivot) > env.getParam(SG::UPDATEPIVOTTOL)
-		 && (++updatePivotPasses < env.getParam(SG::MAXUPDATEPIVOTPASSES) ));
+  if (storeIteration)
+    soln.push_back(SGIteration_V2(*this,env.getParam(SG::STOREACTIONS)));
 
-    } // policy iteration
-  
-} // findInitialPivot
+  if (env.getParam(SG::PRINTTOCOUT))
+    cout << progressString() << endl;
+
+  return errorLevel;
+} // generate
 
 std::string SGApprox_V2::progressString() const
 {
@@ -321,7 +189,7 @@ std::string SGApprox_V2::progressString() const
   std::stringstream ss;
   ss << "Error level: " << errorLevel
      << ", iter/step: " << numIterations << "/" << numSteps
-     << ", numHyperPlanes: " << Wp.size()
+     << ", numHyperplanes: " << W.size()
      << ", numActionsRemaining: " << numActsRemaining;
 
   return ss.str();
@@ -332,171 +200,138 @@ void SGApprox_V2::findBestDir()
   // Search for the next best direction.
   int state;
 
-  double reverseDirTol = 1e-6;
-  
-  
   bestAction = actions[0].end(); // use end as the default value for bestAction
   bestRegime = SG::Binding;
 
-  double currNorm = currDir.norm();
-
   bestDir = -1.0*currDir;
-  bestNrml = -1.0*currNrml;
-  // Search over all actions to find the one that generates the
-  // shallowest normal that is clockwise relative to the curr
-  // normal. 
+
   for (state = 0; state < numStates; state++)
     {
       for (list<SGAction>::const_iterator ait = actions[state].begin();
 	   ait != actions[state].end();
 	   ++ait)
 	{
-	  // Find the best direction for this action, i.e., the
-	  // smallest clockwise rotation from the curr normal. 
-	  
-	  // Non-binding payoff
-	  const SGPoint & stagePayoff  = game.getPayoffs()[state][ait->getAction()];
-	  const vector<double> & prob = game.getProbabilities()[state][ait->getAction()];
-	  SGPoint nonBindingPayoff = ( (1-delta)*stagePayoff
-				       + delta*pivot.expectation(prob) );
+	  const SGPoint & stagePayoff = game.getPayoffs()[state][ait->getAction()];
+	  SGPoint expPivot = pivot.expectation(game.getProbabilities()[state]
+					       [ait->getAction()]);
+	  SGPoint nonBindingPayoff = (1-delta)*stagePayoff + delta*expPivot;
 	  SGPoint nonBindingDir = nonBindingPayoff - pivot[state];
-	  SGPoint nonBindingNrml = nonBindingDir.getNrml();
 
-	  bool nonBindingReverseDirFlag = false;
-	  
-	  // Flip the direction of the norm if we have bended backwards
-	  if (nonBindingDir * currNrml > reverseDirTol
-	      || (abs(nonBindingDir*currNrml) < reverseDirTol
-		  && nonBindingDir * currNrml.getNrml() > reverseDirTol) )
+	  // The non-binding payoff is available if the expected pivot
+	  // is incentive compatible.
+	  if (expPivot >= ait->getMinICPayoffs())
 	    {
-	      nonBindingNrml *= -1.0;
-	      nonBindingReverseDirFlag = true;
+	      if (nonBindingDir.norm() > env.getParam(SG::NORMTOL)
+		  && improves(currDir,bestDir,nonBindingDir))
+		{
+		  bestDir = nonBindingDir;
+		  bestAction = ait;
+		  bestRegime = SG::NonBinding;
+		}
+	      continue;
 	    }
 
-	  // We can only use the non-binding direction if the
-	  // non-binding payoff is "below" the best binding direction.
-	  
-	  bool nonBindingIsMinimal = false;
-	  bool bindingAbovePivotFlag = false;
-	  bool dropActionFlag = false;
-	  
-	  SGPoint bestBindingPayoff;
-	  SGPoint bestBindingDir;
-	  SGPoint bestBindingNrml = -1.0*currNrml;
-	  // Binding payoffs
-	  for (int p = 0; p < numPlayers; p++)
+	  const SGTuple & vertices = feasibleSets[state][ait->getAction()];
+
+	  // The non-binding direction is still available if the ray
+	  // from the pivot in that direction passes through the
+	  // payoffs generated by the feasible set. The pivot then moves
+	  // until the expected pivot hits an incentive constraint, so
+	  // skip it if the current action is already at that
+	  // constraint and would move out.
+	  if (nonBindingDir.norm() > env.getParam(SG::NORMTOL)
+	      && improves(currDir,bestDir,nonBindingDir)
+	      && rayMeetsPolygon(pivot[state],nonBindingDir,
+				 (1-delta)*stagePayoff,vertices))
 	    {
-	      for (int c = 0; c < ait->getPoints()[p].size(); c++)
+	      bool pointOut = false;
+	      if (actionTuple[state] == &(*ait))
 		{
-		  SGPoint bindingPayoff = ( (1-delta)*stagePayoff
-					    + delta*ait->getPoints()[p][c] );
-		  SGPoint bindingDir = bindingPayoff - pivot[state];
-		  SGPoint bindingNrml = bindingDir.getNrml();
-		  if (bindingDir*currNrml > reverseDirTol
-		      || (abs(bindingDir*currNrml) < reverseDirTol
-			  && bindingDir * currNrml.getNrml() > reverseDirTol) )
-		    bindingNrml *= -1.0;
-
-		  if (bindingDir * currNrml > env.getParam(SG::IMPROVETOL))
+		  SGPoint contVal = (pivot[state]-(1-delta)*stagePayoff)/delta;
+		  for (int player = 0; player < numPlayers; player++)
 		    {
-		      // Either pivot is contained in feasible set or
-		      // else action is infeasible. If we have
-		      // containment, it must be that the non-binding
-		      // payoff is below the pivot. 
-		      bindingAbovePivotFlag = true;
+		      if (contVal[player] <= ait->getMinICPayoffs()[player]
+			  && nonBindingDir[player] < 0)
+			pointOut = true;
 		    }
-		  else if (bindingPayoff * bestBindingNrml > env.getParam(SG::IMPROVETOL))
-		    {
-		      bestBindingNrml = bindingNrml;
-		      bestBindingPayoff = bindingPayoff;
-		      bestBindingDir = bindingDir;
-		    }
-		} // continuation value
-	    } // player
-
-	  if (bindingAbovePivotFlag)
-	    {
-	      // Must be that non-binding payoff is (weakly) below the
-	      // pivot, or else action is infeasible.
-	      if (isBelow(nonBindingDir,currNrml)
-		  && improves(currNrml,bestNrml,nonBindingNrml))
+		}
+	      if (!pointOut)
 		{
-		  bestNrml = nonBindingNrml;
-		  bestAction = ait;
 		  bestDir = nonBindingDir;
+		  bestAction = ait;
 		  bestRegime = SG::NonBinding;
+		  continue;
 		}
 	    }
-	  else
+
+	  // Otherwise, move towards the binding continuation values.
+	  for (int player = 0; player < numPlayers; player++)
 	    {
-	      // Binding payoffs are all below the curr normal
-	      if ( isBelow(nonBindingDir,bestBindingNrml)
-		   && improves(currNrml,bestNrml,nonBindingNrml))
+	      const SGTuple & points = ait->getPoints()[player];
+	      for (int point = 0; point < points.size(); point++)
 		{
-		  bestNrml = nonBindingNrml;
-		  bestAction = ait;
-		  bestDir = nonBindingDir;
-		  bestRegime = SG::NonBinding;
-		}
-	      else if (improves(currNrml,bestNrml,bestBindingNrml))
-		{
-		  bestNrml = bestBindingNrml;
-		  bestAction = ait;
-		  bestDir = bestBindingDir;
-		  bestRegime = SG::Binding;
-		}
-	    }
-	  
-	  // if (!bindingAbovePivotFlag
-	  //     && bestBindingDir * nonBindingNrml < -reverseDirTol
-	  //     && improves(currNrml,bestNrml,bestBindingNrml))
-	  //   {
-	  //     bestNrml = bestBindingNrml;
-	  //     bestAction = ait;
-	  //     bestDir = bestBindingDir;
-	  //     bestRegime = SG::Binding;
-	  //   }
-	  // else if ( (nonBindingIsMinimal
-	  // 	    || bestBindingDir * nonBindingNrml > reverseDirTol)
-	  // 	    && improves(currNrml,bestNrml,nonBindingNrml) )
-	  //   {
-	  //     bestNrml = nonBindingNrml;
-	  //     bestAction = ait;
-	  //     bestDir = nonBindingDir;
-	  //     bestRegime = SG::NonBinding;
-	  //   }
+		  SGPoint bindingDir = (1-delta)*stagePayoff
+		    + delta*points[point] - pivot[state];
+
+		  if (bindingDir.norm() > env.getParam(SG::NORMTOL)
+		      && improves(currDir,bestDir,bindingDir))
+		    {
+		      bestDir = bindingDir;
+		      bestAction = ait;
+		      bestRegime = SG::Binding;
+		    }
+		} // point
+	    } // player
 	} // action
     } // state
   
   if (bestAction == actions[0].end())
     throw(SGException(SG::NO_ADMISSIBLE_DIRECTION));
-  
 } // findBestDir
 
-bool SGApprox_V2::isBelow(const SGPoint & dir,
-			  const SGPoint & norm) const
+bool SGApprox_V2::rayMeetsPolygon(const SGPoint & origin,
+				  const SGPoint & direction,
+				  const SGPoint & offset,
+				  const SGTuple & vertices) const
 {
-  return (dir*norm < -env.getParam(SG::IMPROVETOL)
-	  || ( abs(dir*norm) < env.getParam(SG::IMPROVETOL)
-	       && dir*norm.getNrml() < -env.getParam(SG::IMPROVETOL) ) );
-}
+  // The generated payoffs are offset + delta*vertices. Look for a
+  // sign change of the cross product with the direction at a point
+  // ahead of the origin.
+  int numVertices = vertices.size();
+  double tol = env.getParam(SG::LEVELTOL);
+  SGPoint normal = direction.getNormal();
+  for (int k = 0; k < numVertices; k++)
+    {
+      SGPoint p = offset + delta*vertices[k] - origin;
+      SGPoint q = offset + delta*vertices[(k+1)%numVertices] - origin;
+      double pLevel = p*normal, qLevel = q*normal;
+      if ((pLevel > tol && qLevel > tol)
+	  || (pLevel < -tol && qLevel < -tol))
+	continue;
+
+      SGPoint crossing = p;
+      if (abs(pLevel-qLevel) > tol)
+	crossing = p + pLevel/(pLevel-qLevel)*(q-p);
+      if (crossing*direction > env.getParam(SG::NORMTOL))
+	return true;
+    } // for k
+  return false;
+} // rayMeetsPolygon
 
 bool SGApprox_V2::improves(const SGPoint & curr, 
-			const SGPoint & best, 
-			const SGPoint & newDir) const
+			   const SGPoint & best, 
+			   const SGPoint & newDir) const
 {
-  SGPoint newNrml = newDir.getNrml();
+  SGPoint newNormal = newDir.getNormal();
   double currNorm = curr.norm();
   double newNorm = newDir.norm();
-  double level  =  newNrml * curr/sqrt(newNorm)/sqrt(currNorm);
+  double level  =  newNormal * curr/sqrt(newNorm)/sqrt(currNorm);
 
   return ( level > env.getParam(SG::IMPROVETOL)
 	   || ( level > -env.getParam(SG::IMPROVETOL)
 		&& newDir*curr > 0.0 ) )
-    && (newNrml * best/sqrt(newNorm)/sqrt(best.norm()) 
-	< env.getParam(SG::IMPROVETOL)); // This broke the kocherlakota example, but
-  // made the PD example and others work
-  // beautifully (used to be -env.getParam(SG::IMPROVETOL))
+    && (newNormal * best/sqrt(newNorm)/sqrt(best.norm()) 
+	< env.getParam(SG::IMPROVETOL));
 } // improves
 
 void SGApprox_V2::calculateNewPivot()
@@ -509,54 +344,61 @@ void SGApprox_V2::calculateNewPivot()
   actionTuple[bestAction->getState()] = &(*bestAction);
 
   currDir = bestDir;
-  currNrml = bestNrml/bestNrml.norm();
 
   // First construct maxMovement array.
+  vector<double> maxMovement(numStates,numeric_limits<double>::max());
+  vector<SG::Regime> maxMovementConstraints(numStates,SG::Binding0);
   vector<double> movements(numStates,0.0);
   
   double tempMovement;
-      
-  movements[bestAction->getState()] = 1.0;
+
+  for (player = 0; player < numPlayers; player++)
+    {
+      if (currDir[player] >= 0)
+	continue;
+
+      for (state = 0; state < numStates; state++)
+	{
+	  // Calculate how far we can move before we hit this
+	  // player's IC constraint.
+	  if (regimeTuple[state] != SG::NonBinding)
+	    continue;
+
+	  tempMovement = (delta*actionTuple[state]->getMinICPayoffs()[player]
+			  -pivot[state][player]
+			  +(1-delta)*game.getPayoffs()[state]
+			  [actionTuple[state]->getAction()][player])
+	    / currDir[player];
+
+	  if (tempMovement < maxMovement[state]
+	      && tempMovement > 0)
+	    {
+	      maxMovement[state] = tempMovement;
+	      maxMovementConstraints[state] = (player==0? SG::Binding0: SG::Binding1);
+	    }
+	} // state
+    } // player
+
+  movements[bestAction->getState()] = min(1.0,maxMovement[bestAction->getState()]);
   vector<double> changes(movements);
 
-  while (updatePivot(movements,changes,regimeTuple)
+  while (updatePivot(movements,changes,maxMovement,maxMovementConstraints)
 	 > env.getParam(SG::UPDATEPIVOTTOL)
 	 && (++updatePivotPasses < env.getParam(SG::MAXUPDATEPIVOTPASSES)))
     {}
   if (updatePivotPasses >= env.getParam(SG::MAXUPDATEPIVOTPASSES))
     throw(SGException(SG::TOO_MANY_PIVOT_UPDATES));
   
-  double maxDistance = 0;
   for (state=0; state < numStates; state++)
-    {
-      maxDistance = std::max(maxDistance,movements[state]);
-      pivot[state] += movements[state]*currDir;
-    }
+    pivot[state] += movements[state]*currDir;
 
-  // Add check here that pivot is self-generated (in the
-  // non-binding case)
-  for (state=0; state < numStates; state++)
-    {
-      if (regimeTuple[state]==SG::NonBinding)
-	{
-	  SGPoint tempPayoff( (1-delta)
-			      *game.getPayoffs()[state][actionTuple[state]->getAction()] 
-			      +delta*pivot.expectation(game.getProbabilities()[state][actionTuple[state]->getAction()]) );
-	  
-	  assert( SGPoint::distance(tempPayoff, pivot[state]) < 1e-8 );
-	  if ( SGPoint::distance(tempPayoff, pivot[state]) > 1e-5 )
-	    cout << "Error. Non-binding pivot does not self generate. Distance: "
-		 << SGPoint::distance(tempPayoff, pivot[state]) << endl;
-	}
-    }
-  
   pivot.roundTuple(env.getParam(SG::ROUNDTOL));
-
 } // calculateNewPivot
 
 double SGApprox_V2::updatePivot(vector<double> & movements, 
 				vector<double> & changes,
-				vector<SG::Regime> & regimeTuple)
+				const vector<double> & maxMovement,
+				const vector<SG::Regime> & maxMovementConstraints)
 {
   // Solve forward the system of equations implied by regimeTuple
   // and actionTuple. If an IC constraint is violated by the forward
@@ -564,27 +406,33 @@ double SGApprox_V2::updatePivot(vector<double> & movements,
   // constraint.
   double newError = 0.0;
 
-  vector<double> tempChange(numStates,0.0), tempMovement(numStates,0.0);
+  vector<double> tempChange(numStates,0.0);
 
   for (int state = 0; state < numStates; state++)
     {
       if (regimeTuple[state]!=SG::NonBinding)
 	continue;
 
-      assert(regimeTuple[state]==SG::NonBinding);
-
+      const vector<double> & transitions
+	= game.getProbabilities()[state][actionTuple[state]->getAction()];
       for (int statep = 0; statep < numStates; statep++)
-	{
-	  tempChange[state] += delta* 
-	    game.getProbabilities()[state][actionTuple[state]->getAction()][statep]
-	    * changes[statep];
-	}
+	tempChange[state] += delta*transitions[statep]*changes[statep];
     }
 
   for (int state=0; state < numStates; state++)
     {
-      movements[state] += tempChange[state];
-      changes[state] = tempChange[state];
+      double tempMovement = movements[state]+tempChange[state];
+      if (tempMovement <= maxMovement[state])
+	{
+	  movements[state] = tempMovement;
+	  changes[state] = tempChange[state];
+	}
+      else
+	{
+	  changes[state] = maxMovement[state]-movements[state];
+	  movements[state] = maxMovement[state];
+	  regimeTuple[state] = maxMovementConstraints[state];
+	}
 
       newError = max(newError,changes[state]);
     }
@@ -592,76 +440,253 @@ double SGApprox_V2::updatePivot(vector<double> & movements,
   return newError;
 } // updatePivot
 
+void SGApprox_V2::addHyperplane()
+{
+  SGPoint normal = currDir.getNormal();
+  normal.normalize();
+
+  vector<double> levels(numStates);
+  for (int state = 0; state < numStates; state++)
+    levels[state] = pivot[state]*normal;
+
+  // Every state moves along the current direction, so a hyperplane
+  // parallel to the last one is the same hyperplane.
+  if (Wp.size() > 0
+      && Wp.back().getNormal()*normal > 0
+      && abs(Wp.back().getNormal()*normal.getNormal())
+      < env.getParam(SG::FLATTOL))
+    Wp.back() = SGHyperplane(normal,levels);
+  else
+    Wp.push_back(SGHyperplane(normal,levels));
+} // addHyperplane
+
 double SGApprox_V2::distance() const
 {
-  if (numIterations<2)
+  if (W.empty() || Wp.empty())
     return 1.0;
 
-  double newError = 0.0;
+  // Sort the new hyperplanes by the angle of their normals.
+  vector< pair<double,int> > angles(Wp.size());
+  for (int k = 0; k < Wp.size(); k++)
+    angles[k] = make_pair(atan2(Wp[k].getNormal()[1],
+				Wp[k].getNormal()[0]),k);
+  sort(angles.begin(),angles.end());
 
-  for (auto hp_old = W.begin(); hp_old != W.end() ; hp_old++)
+  double newError = 0.0;
+  for (auto hp_old = W.begin(); hp_old != W.end(); ++hp_old)
     {
-      double distToCurrIter = numeric_limits<double>::max();
-      double tempDist;
-      for (auto hp_new = Wp.begin(); hp_new != Wp.end() ; hp_new++)
-	{
-	  // Find perpendicular to the line between point and point-1
-	  // that goes through oldPoint.
+      double angle = atan2(hp_old->getNormal()[1],hp_old->getNormal()[0]);
+      int above = lower_bound(angles.begin(),angles.end(),
+			      make_pair(angle,-1)) - angles.begin();
+      int below = (above + angles.size() - 1) % angles.size();
+      above = above % angles.size();
+
+      newError = std::max(newError,
+			  std::min(SGHyperplane::distance(*hp_old,
+							  Wp[angles[above].second]),
+				   SGHyperplane::distance(*hp_old,
+							  Wp[angles[below].second])));
+    } // for old hp
 
-	  tempDist = SGHyperplane::distance(*hp_old,*hp_new);
+  return newError;
+} // distance
 
-	  if (tempDist <= distToCurrIter)
-	    distToCurrIter = tempDist;
-	} // for new hp
+void SGApprox_V2::updateMinPayoffs()
+{
+  list<SGAction>::iterator action;
+  vector<bool> update(2,true);
 
-      if (tempDist <= distToCurrIter)
-	distToCurrIter = tempDist;
+  for (int player = 0; player < numPlayers; player++)
+    {
+      if (!updatedThreatTuple[player] 
+	  || game.getConstrained()[player])
+	update[player] = false;
+    }
 
-      if (distToCurrIter >= newError)
-	newError = distToCurrIter;
-    } // for old hp
+  // Flag the action profiles that reach a state whose threat
+  // changed. Only their expected threats are different.
+  const vector<int> & reverseStarts = game.getReverseStarts();
+  const vector<int> & reverseStates = game.getReverseStates();
+  const vector<int> & reverseActions = game.getReverseActions();
+  vector< vector< vector<bool> > > reachesUpdate(numPlayers);
+  for (int player = 0; player < numPlayers; player++)
+    {
+      if (!update[player])
+	continue;
 
-  return newError;
-}
+      reachesUpdate[player].resize(numStates);
+      for (int state = 0; state < numStates; state++)
+	reachesUpdate[player][state]
+	  = vector<bool>(game.getNumActions_total()[state],false);
+      for (int statep = 0; statep < numStates; statep++)
+	{
+	  if (!updatedThreatStates[player][statep])
+	    continue;
+	  for (int k = reverseStarts[statep]; k < reverseStarts[statep+1]; k++)
+	    reachesUpdate[player][reverseStates[k]][reverseActions[k]] = true;
+	} // statep
+    } // player
+
+  // An action's minimum IC continuation value for a player depends
+  // on the transitions of each of that player's deviations, so it
+  // only needs to be recomputed if one of them was flagged.
+  vector<bool> actionUpdate(2);
+  vector<int> deviations;
+  for (int state = 0; state < numStates; state++)
+    {
+      const vector<int> & numActions = game.getNumActions()[state];
+      for (action = actions[state].begin();
+  	   action != actions[state].end();
+  	   action ++)
+	{
+	  bool anyUpdate = false;
+	  for (int player = 0; player < numPlayers; player++)
+	    {
+	      actionUpdate[player] = false;
+	      if (!update[player])
+		continue;
+
+	      indexToVector(action->getAction(),deviations,numActions);
+	      for (int deviation = 0; deviation < numActions[player]; deviation++)
+		{
+		  deviations[player] = deviation;
+		  if (reachesUpdate[player][state][vectorToIndex(deviations,
+								 numActions)])
+		    {
+		      actionUpdate[player] = true;
+		      anyUpdate = true;
+		      break;
+		    }
+		} // deviation
+	    } // player
+
+	  if (anyUpdate)
+	    action->calculateMinIC(game,actionUpdate,threatTuple);
+	} // action
+    } // state
+} // updateMinPayoffs
 
 void SGApprox_V2::calculateBindingContinuations() 
 {
-  // Calculates the IC intersection points. To be used after updating
-  // the threat tuple.
-  int state, tupleIndex;
-  vector<int> intsctTuples;
-  vector<double> xbounds(2), ybounds(2);
-
-  bool anyUpdate = false;
+  // Store the hyperplanes in W as a matrix of levels, so that the
+  // expected levels for all of the actions in a state can be
+  // computed at once.
+  int numHyperplanes = W.size();
+  normals.resize(numHyperplanes);
+  levelMatrix.resize(numStates*numHyperplanes);
+  for (int k = 0; k < numHyperplanes; k++)
+    {
+      normals[k] = W[k].getNormal();
+      for (int sp = 0; sp < numStates; sp++)
+	levelMatrix[sp*numHyperplanes+k] = W[k][sp];
+    } // k
 
-  for (state = 0; state < numStates; state++)
+  feasibleSets.resize(numStates);
+  for (int state = 0; state < numStates; state++)
     {
+      feasibleSets[state].assign(game.getNumActions_total()[state],SGTuple());
+
+      int numRows = actions[state].size();
+      probMatrix.resize(numRows*numStates);
+      expLevelMatrix.resize(numRows*numHyperplanes);
+      int row = 0;
+      for (list<SGAction>::const_iterator action = actions[state].begin();
+	   action != actions[state].end();
+	   ++action, ++row)
+	{
+	  const vector<double> & transitions
+	    = game.getProbabilities()[state][action->getAction()];
+	  std::copy(transitions.begin(),transitions.end(),
+		    probMatrix.begin()+row*numStates);
+	} // action
+      expectLevels(probMatrix.data(),numRows,numStates,
+		   levelMatrix.data(),numHyperplanes,
+		   expLevelMatrix.data());
+
       list<SGAction>::iterator action = actions[state].begin();
+      row = 0;
       while (action != actions[state].end())
 	{
+	  const double * expLevels = expLevelMatrix.data()+row*numHyperplanes;
+	  action->calculateBindingContinuations(game,normals,expLevels);
+
+	  // Clip the box of feasible payoffs to the expected half
+	  // spaces and the incentive constraints.
+	  SGTuple & vertices = feasibleSets[state][action->getAction()];
+	  vertices.push_back(payoffLB);
+	  vertices.push_back(SGPoint(payoffUB[0],payoffLB[1]));
+	  vertices.push_back(payoffUB);
+	  vertices.push_back(SGPoint(payoffLB[0],payoffUB[1]));
+	  for (int k = 0; k < numHyperplanes && vertices.size() > 0; k++)
+	    clipPolygon(vertices,normals[k],expLevels[k]);
 	  for (int player = 0; player < numPlayers; player++)
 	    {
 	      if (game.getConstrained()[player])
 		continue;
-	      anyUpdate = true;
-	    }
-	  
-	  action->calculateMinIC(game,
-				 vector<bool>(numPlayers,true),
-				 threatTuple);
-	  action->calculateBindingContinuations(game,W);
+	      SGPoint normal(0.0,0.0);
+	      normal[player] = -1.0;
+	      clipPolygon(vertices,normal,-action->getMinICPayoffs()[player]);
+	    } // player
 	  
-	  // Drop the point if no longer IC
-	  if ((action->getPoints()[0].size() == 0 && !game.getConstrained()[0])
-	      && (action->getPoints()[1].size() == 0 && !game.getConstrained()[1]))
+	  // Drop the action if no continuation value is feasible and
+	  // incentive compatible.
+	  if (vertices.size() == 0)
 	    {
 	      if (actionTuple[state] == &(*action))
-		regimeTuple[state] = SG::Binding;
+		{
+		  regimeTuple[state] = SG::Binding;
+		  actionTuple[state] = &nullAction;
+		}
 	      actions[state].erase(action++);
 	    }
 	  else
 	    action++;
+	  row++;
 	} // action
     } // state
-} // calculateIntersections
-  
+} // calculateBindingContinuations
+
+void SGApprox_V2::expectLevels(const double * prob, int numRows,
+			       int numStates,
+			       const double * levels, int numCols,
+			       double * out)
+{
+  const int colBlock = 256;
+
+  std::fill(out,out+numRows*numCols,0.0);
+  for (int col0 = 0; col0 < numCols; col0 += colBlock)
+    {
+      int col1 = std::min(col0+colBlock,numCols);
+      for (int row = 0; row < numRows; row++)
+	{
+	  double * outRow = out+row*numCols;
+	  for (int sp = 0; sp < numStates; sp++)
+	    {
+	      double p = prob[row*numStates+sp];
+	      if (p == 0)
+		continue;
+	      const double * levelRow = levels+sp*numCols;
+	      for (int col = col0; col < col1; col++)
+		outRow[col] += p*levelRow[col];
+	    } // sp
+	} // row
+    } // col0
+} // expectLevels
+
+void SGApprox_V2::clipPolygon(SGTuple & polygon,
+			      const SGPoint & normal, double level)
+{
+  double tol = 1e-12*(1+abs(level));
+  SGTuple clipped;
+  for (int v = 0; v < polygon.size(); v++)
+    {
+      const SGPoint & p = polygon[v];
+      const SGPoint & q = polygon[(v+1)%polygon.size()];
+      double lp = normal*p - level, lq = normal*q - level;
+      if (lp <= tol)
+	clipped.push_back(p);
+      if ( (lp < -tol && lq > tol) || (lp > tol && lq < -tol) )
+	clipped.push_back(p + (lp/(lp-lq))*(q-p));
+    } // for v
+  polygon = clipped;
+} // clipPolygon
@@ -0,0 +1,459 @@
+// This file is part of the SGSolve library for stochastic games
+// Copyright (C) 2016 Benjamin A. Brooks
+// 
+// SGSolve free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// SGSolve is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see
+// <http://www.gnu.org/licenses/>.
+// 
+// Benjamin A. Brooks
+// ben@benjaminbrooks.net
+// Chicago, IL
+
+#include "sgcapi.h"
+#include "sgsolver.hpp"
+#include <memory>
+#include <string>
+
+struct sg_game
+{
+  SGGame game;
+};
+
+struct sg_env
+{
+  SGEnv env;
+};
+
+struct sg_solver
+{
+  //! One call to SGSolver::solve.
+  /*! SGSolver refers to the environment and the game, so they are
+      shared with it. Solution handles share ownership of the run and
+      point into the SGSolver's own SGSolution, so the solution is
+      never copied, and handles from earlier solves keep theirs. */
+  struct Run
+  {
+    std::shared_ptr<const SGEnv> env;
+    std::shared_ptr<const SGGame> game;
+    SGSolver solver;
+
+    Run(const std::shared_ptr<const SGEnv> & _env,
+	const std::shared_ptr<const SGGame> & _game):
+      env(_env), game(_game), solver(*env,*game)
+    {}
+  };
+
+  std::shared_ptr<const SGEnv> env;
+  std::shared_ptr<const SGGame> game;
+  //! The last run. It has not been solved yet if solved is false.
+  std::shared_ptr<Run> run;
+  bool solved;
+};
+
+struct sg_solution
+{
+  std::shared_ptr<const SGSolution> soln;
+};
+
+namespace
+{
+  //! Message for sg_last_error.
+  thread_local std::string lastError;
+
+  //! Runs f, translating any exception into SG_ERROR.
+  template<class F>
+  int guard(F f)
+  {
+    try
+      {
+	f();
+	return SG_OK;
+      }
+    catch (std::exception & e)
+      {
+	lastError = e.what();
+      }
+    catch (...)
+      {
+	lastError = "Unknown exception";
+      }
+    return SG_ERROR;
+  } // guard
+
+  //! Records an error that did not come from an exception.
+  int fail(const char * message)
+  {
+    lastError = message;
+    return SG_ERROR;
+  }
+
+  //! Copies all of the parameters from source to target.
+  void copyParams(const SGEnv & source, SGEnv & target)
+  {
+    const vector<SGEnv::ParamInfo> & table = SGEnv::getParamTable();
+    for (int k = 0; k < table.size(); k++)
+      target.setParam(string(table[k].name),
+		      source.getParam(string(table[k].name)));
+  } // copyParams
+}
+
+const char * sg_last_error(void)
+{
+  return lastError.c_str();
+}
+
+sg_game * sg_game_create(double delta, int numStates,
+			 const int * numActions,
+			 const double * payoffs,
+			 const double * probabilities,
+			 const int * unconstrained)
+{
+  if (numActions == NULL || payoffs == NULL || probabilities == NULL)
+    {
+      fail("Null array passed to sg_game_create");
+      return NULL;
+    }
+  if (numStates < 1)
+    {
+      fail("Number of states must be at least 1");
+      return NULL;
+    }
+
+  sg_game * game = NULL;
+  guard([&]()
+	{
+	  vector< vector<int> > _numActions(numStates,vector<int>(2));
+	  vector< vector< vector<double> > > _payoffs(numStates);
+	  vector< vector< vector<double> > > _probabilities(numStates);
+	  vector<bool> _unconstrained(2,false);
+
+	  int row = 0;
+	  for (int state = 0; state < numStates; state++)
+	    {
+	      _numActions[state][0] = numActions[2*state];
+	      _numActions[state][1] = numActions[2*state+1];
+	      if (_numActions[state][0] < 1 || _numActions[state][1] < 1)
+		throw(SGException(SG::BAD_PARAM_VALUE));
+
+	      int numProfiles = _numActions[state][0]*_numActions[state][1];
+	      _payoffs[state].resize(numProfiles);
+	      _probabilities[state].resize(numProfiles);
+	      for (int action = 0; action < numProfiles; action++, row++)
+		{
+		  _payoffs[state][action].assign(payoffs+2*row,
+						 payoffs+2*row+2);
+		  _probabilities[state][action]
+		    .assign(probabilities+numStates*row,
+			    probabilities+numStates*(row+1));
+		}
+	    } // for state
+	  if (unconstrained != NULL)
+	    {
+	      _unconstrained[0] = (unconstrained[0] != 0);
+	      _unconstrained[1] = (unconstrained[1] != 0);
+	    }
+
+	  game = new sg_game{SGGame(delta,numStates,_numActions,
+				    _payoffs,_probabilities,
+				    _unconstrained)};
+	});
+  return game;
+} // sg_game_create
+
+sg_game * sg_game_load(const char * filename)
+{
+  sg_game * game = NULL;
+  guard([&]()
+	{
+	  std::unique_ptr<sg_game> newGame(new sg_game);
+	  SGGame::load(newGame->game,filename);
+	  game = newGame.release();
+	});
+  return game;
+} // sg_game_load
+
+int sg_game_save(const sg_game * game, const char * filename)
+{
+  return guard([&]() { SGGame::save(game->game,filename); });
+}
+
+void sg_game_free(sg_game * game)
+{
+  delete game;
+}
+
+double sg_game_delta(const sg_game * game)
+{
+  return game->game.getDelta();
+}
+
+int sg_game_num_states(const sg_game * game)
+{
+  return game->game.getNumStates();
+}
+
+int sg_game_num_profiles(const sg_game * game)
+{
+  int numProfiles = 0;
+  for (int state = 0; state < game->game.getNumStates(); state++)
+    numProfiles += game->game.getNumActions_total()[state];
+  return numProfiles;
+} // sg_game_num_profiles
+
+int sg_game_get_num_actions(const sg_game * game, int * numActions)
+{
+  if (numActions == NULL)
+    return fail("Null array passed to sg_game_get_num_actions");
+  for (int state = 0; state < game->game.getNumStates(); state++)
+    {
+      numActions[2*state] = game->game.getNumActions()[state][0];
+      numActions[2*state+1] = game->game.getNumActions()[state][1];
+    }
+  return SG_OK;
+} // sg_game_get_num_actions
+
+int sg_game_get_payoffs(const sg_game * game, double * payoffs)
+{
+  if (payoffs == NULL)
+    return fail("Null array passed to sg_game_get_payoffs");
+  int row = 0;
+  for (int state = 0; state < game->game.getNumStates(); state++)
+    {
+      for (int action = 0; action < game->game.getNumActions_total()[state];
+	   action++, row++)
+	{
+	  payoffs[2*row] = game->game.getPayoffs()[state][action][0];
+	  payoffs[2*row+1] = game->game.getPayoffs()[state][action][1];
+	}
+    }
+  return SG_OK;
+} // sg_game_get_payoffs
+
+int sg_game_get_probabilities(const sg_game * game,
+			      double * probabilities)
+{
+  if (probabilities == NULL)
+    return fail("Null array passed to sg_game_get_probabilities");
+  int numStates = game->game.getNumStates();
+  double * out = probabilities;
+  for (int state = 0; state < numStates; state++)
+    {
+      for (int action = 0; action < game->game.getNumActions_total()[state];
+	   action++, out += numStates)
+	std::copy(game->game.getProbabilities()[state][action].begin(),
+		  game->game.getProbabilities()[state][action].end(),
+		  out);
+    }
+  return SG_OK;
+} // sg_game_get_probabilities
+
+sg_env * sg_env_create(void)
+{
+  sg_env * env = NULL;
+  guard([&]() { env = new sg_env; });
+  return env;
+}
+
+void sg_env_free(sg_env * env)
+{
+  delete env;
+}
+
+int sg_env_set_param(sg_env * env, const char * name, double value)
+{
+  if (name == NULL)
+    return fail("Null parameter name");
+  return guard([&]() { env->env.setParam(string(name),value); });
+}
+
+int sg_env_get_param(const sg_env * env, const char * name,
+		     double * value)
+{
+  if (name == NULL || value == NULL)
+    return fail("Null argument passed to sg_env_get_param");
+  return guard([&]() { *value = env->env.getParam(string(name)); });
+}
+
+sg_solver * sg_solver_create(const sg_env * env, const sg_game * game)
+{
+  sg_solver * solver = NULL;
+  guard([&]()
+	{
+	  std::unique_ptr<sg_solver> newSolver(new sg_solver);
+	  std::shared_ptr<SGEnv> newEnv = std::make_shared<SGEnv>();
+	  copyParams(env->env,*newEnv);
+	  newSolver->env = newEnv;
+	  newSolver->game = std::make_shared<SGGame>(game->game);
+	  newSolver->run = std::make_shared<sg_solver::Run>(newSolver->env,
+							    newSolver->game);
+	  newSolver->solved = false;
+	  solver = newSolver.release();
+	});
+  return solver;
+} // sg_solver_create
+
+void sg_solver_free(sg_solver * solver)
+{
+  delete solver;
+}
+
+int sg_solver_solve(sg_solver * solver,
+		    sg_progress_callback progress,
+		    void * userData)
+{
+  bool stopped = false;
+  int status = guard([&]()
+    {
+      // SGSolver::solve adds to its solution, so every solve after
+      // the first gets a new run.
+      if (solver->solved)
+	solver->run = std::make_shared<sg_solver::Run>(solver->env,
+						       solver->game);
+      solver->solved = true;
+
+      stopped = !solver->run->solver.solve([&](const SGApprox & approx)
+	{
+	  return progress == NULL
+	    || progress(approx.getNumIterations(),
+			approx.getNumRevolutions(),
+			approx.getErrorLevel(),userData) == 0;
+	});
+    });
+
+  if (status == SG_OK && stopped)
+    return fail("Solve stopped by the progress callback");
+  return status;
+} // sg_solver_solve
+
+sg_solution * sg_solver_get_solution(const sg_solver * solver)
+{
+  sg_solution * soln = NULL;
+  guard([&]()
+	{
+	  soln = new sg_solution{std::shared_ptr<const SGSolution>
+	      (solver->run,&solver->run->solver.getSolution())};
+	});
+  return soln;
+} // sg_solver_get_solution
+
+sg_solution * sg_solution_load(const char * filename)
+{
+  sg_solution * soln = NULL;
+  guard([&]()
+	{
+	  std::shared_ptr<SGSolution> newSoln = std::make_shared<SGSolution>();
+	  SGSolution::load(*newSoln,filename);
+	  soln = new sg_solution{newSoln};
+	});
+  return soln;
+} // sg_solution_load
+
+int sg_solution_save(const sg_solution * soln, const char * filename)
+{
+  return guard([&]() { SGSolution::save(*soln->soln,filename); });
+}
+
+void sg_solution_free(sg_solution * soln)
+{
+  delete soln;
+}
+
+sg_game * sg_solution_get_game(const sg_solution * soln)
+{
+  sg_game * game = NULL;
+  guard([&]() { game = new sg_game{soln->soln->getGame()}; });
+  return game;
+}
+
+int sg_solution_num_states(const sg_solution * soln)
+{
+  return soln->soln->getGame().getNumStates();
+}
+
+int sg_solution_num_iterations(const sg_solution * soln)
+{
+  return soln->soln->getIterations().size();
+}
+
+int sg_solution_num_tuples(const sg_solution * soln)
+{
+  return soln->soln->getExtremeTuples().size();
+}
+
+int sg_solution_get_tuples(const sg_solution * soln, double * tuples)
+{
+  if (tuples == NULL)
+    return fail("Null array passed to sg_solution_get_tuples");
+
+  int numStates = soln->soln->getGame().getNumStates();
+  double * out = tuples;
+  for (list<SGTuple>::const_iterator tuple
+	 = soln->soln->getExtremeTuples().begin();
+       tuple != soln->soln->getExtremeTuples().end();
+       ++tuple)
+    {
+      for (int state = 0; state < numStates; state++)
+	{
+	  *(out++) = (*tuple)[state][0];
+	  *(out++) = (*tuple)[state][1];
+	}
+    }
+  return SG_OK;
+} // sg_solution_get_tuples
+
+int sg_solution_get_iterations(const sg_solution * soln,
+			       int * iteration,
+			       int * revolution,
+			       double * pivots,
+			       double * directions,
+			       int * actions,
+			       int * regimes,
+			       int * bestState,
+			       int * numExtremeTuples)
+{
+  int numStates = soln->soln->getGame().getNumStates();
+  int k = 0;
+  for (list<SGIteration>::const_iterator iter
+	 = soln->soln->getIterations().begin();
+       iter != soln->soln->getIterations().end();
+       ++iter, k++)
+    {
+      if (iteration != NULL)
+	iteration[k] = iter->getIteration();
+      if (revolution != NULL)
+	revolution[k] = iter->getRevolution();
+      if (bestState != NULL)
+	bestState[k] = iter->getBestState();
+      if (numExtremeTuples != NULL)
+	numExtremeTuples[k] = iter->getNumExtremeTuples();
+      if (directions != NULL)
+	{
+	  directions[2*k] = iter->getDirection()[0];
+	  directions[2*k+1] = iter->getDirection()[1];
+	}
+      for (int state = 0; state < numStates; state++)
+	{
+	  int offset = numStates*k+state;
+	  if (pivots != NULL)
+	    {
+	      pivots[2*offset] = iter->getPivot()[state][0];
+	      pivots[2*offset+1] = iter->getPivot()[state][1];
+	    }
+	  if (actions != NULL)
+	    actions[offset] = iter->getActionTuple()[state];
+	  if (regimes != NULL)
+	    regimes[offset] = iter->getRegimeTuple()[state];
+	}
+    } // for iter
+  return SG_OK;
+} // sg_solution_get_iterations
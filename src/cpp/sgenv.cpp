@@ -20,6 +20,9 @@
 // Chicago, IL
 
 #include "sgenv.hpp"
+#include <cctype>
+#include <cmath>
+#include <cstring>
 
 SGEnv::SGEnv()
 {
@@ -35,6 +38,7 @@ void SGEnv::restoreDefaults()
   intParams[SG::MAXUPDATEPIVOTPASSES] = 1e8;
   intParams[SG::TUPLERESERVESIZE] = 1e4;
   intParams[SG::STOREITERATIONS] = 2;
+  intParams[SG::PRUNEPASSES] = 10;
 
   doubleParams[SG::ERRORTOL] = 1e-8;
   doubleParams[SG::DIRECTIONTOL] = 1e-11;
@@ -108,3 +112,90 @@ int SGEnv::getParam(SG::INT_PARAM param) const
       throw(SGException(SG::UNKNOWN_PARAM));
   return intParams[param];
 } // getParam
+
+void SGEnv::setParam(const string & name, double value)
+{
+  const ParamInfo & info = findParam(name);
+  switch (info.type)
+    {
+    case DoubleParam:
+      setParam(static_cast<SG::DBL_PARAM>(info.param),value);
+      break;
+    case BoolParam:
+      setParam(static_cast<SG::BOOL_PARAM>(info.param),value != 0);
+      break;
+    case IntParam:
+      if (value != std::floor(value))
+	throw(SGException(SG::BAD_PARAM_VALUE));
+      setParam(static_cast<SG::INT_PARAM>(info.param),
+	       static_cast<int>(value));
+      break;
+    }
+} // setParam
+
+double SGEnv::getParam(const string & name) const
+{
+  const ParamInfo & info = findParam(name);
+  switch (info.type)
+    {
+    case DoubleParam:
+      return getParam(static_cast<SG::DBL_PARAM>(info.param));
+    case BoolParam:
+      return getParam(static_cast<SG::BOOL_PARAM>(info.param));
+    case IntParam:
+      return getParam(static_cast<SG::INT_PARAM>(info.param));
+    }
+  throw(SGException(SG::UNKNOWN_PARAM));
+} // getParam
+
+const vector<SGEnv::ParamInfo> & SGEnv::getParamTable()
+{
+  static const vector<ParamInfo> table = {
+    {"errorTol", DoubleParam, SG::ERRORTOL},
+    {"directionTol", DoubleParam, SG::DIRECTIONTOL},
+    {"pastThreatTol", DoubleParam, SG::PASTTHREATTOL},
+    {"updatePivotTol", DoubleParam, SG::UPDATEPIVOTTOL},
+    {"ICTol", DoubleParam, SG::ICTOL},
+    {"normTol", DoubleParam, SG::NORMTOL},
+    {"flatTol", DoubleParam, SG::FLATTOL},
+    {"levelTol", DoubleParam, SG::LEVELTOL},
+    {"improveTol", DoubleParam, SG::IMPROVETOL},
+    {"roundTol", DoubleParam, SG::ROUNDTOL},
+    {"backBendingTol", DoubleParam, SG::BACKBENDINGTOL},
+    {"movementTol", DoubleParam, SG::MOVEMENTTOL},
+    {"intersectTol", DoubleParam, SG::INTERSECTTOL},
+
+    {"backBendingWarning", BoolParam, SG::BACKBENDINGWARNING},
+    {"mergeTuples", BoolParam, SG::MERGETUPLES},
+    {"printToLog", BoolParam, SG::PRINTTOLOG},
+    {"printToCout", BoolParam, SG::PRINTTOCOUT},
+    {"storeActions", BoolParam, SG::STOREACTIONS},
+    {"checkSufficient", BoolParam, SG::CHECKSUFFICIENT},
+
+    {"maxIterations", IntParam, SG::MAXITERATIONS},
+    {"maxUpdatePivotPasses", IntParam, SG::MAXUPDATEPIVOTPASSES},
+    {"storeIterations", IntParam, SG::STOREITERATIONS},
+    {"tupleReserveSize", IntParam, SG::TUPLERESERVESIZE},
+    {"prunePasses", IntParam, SG::PRUNEPASSES}
+  };
+  return table;
+} // getParamTable
+
+const SGEnv::ParamInfo & SGEnv::findParam(const string & name)
+{
+  const vector<ParamInfo> & table = getParamTable();
+  for (int k = 0; k < table.size(); k++)
+    {
+      const char * tableName = table[k].name;
+      if (name.size() != std::strlen(tableName))
+	continue;
+
+      int c = 0;
+      while (c < name.size()
+	     && std::tolower(name[c]) == std::tolower(tableName[c]))
+	c++;
+      if (c == name.size())
+	return table[k];
+    }
+  throw(SGException(SG::UNKNOWN_PARAM));
+} // findParam
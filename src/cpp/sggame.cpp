@@ -21,7 +21,7 @@
 
 #include "sggame.hpp"
 
-SGGame::SGGame(const SGAbstractGame & game):
+SGGame::SGGame(const SGAbstractGame & game, int numThreads):
   numPlayers(2),
   delta(game.getDelta()),
   numStates(game.getNumStates()),
@@ -30,38 +30,97 @@ SGGame::SGGame(const SGAbstractGame & game):
   payoffs(numStates),
   probabilities(numStates),
   eqActions(numStates),
-  unconstrained(2)
+  unconstrained(2),
+  reverseTransitionsValid(false)
 {
   for (int player = 0; player < numPlayers; player++)
     unconstrained[player] = !game.constrained(player);
 
+  for (int state = 0; state < numStates; state++)
+    numActions_total[state] = numActions[state][0] * numActions[state][1];
+
+  // Nonzero transition probabilities of each state in compressed row
+  // form, used below to assemble the reverse transition index.
+  vector< vector<int> > rowStarts(numStates), rowStates(numStates);
+  vector< vector<double> > rowProbabilities(numStates);
+
+  // States differ in their numbers of actions, so threads take the
+  // next unconverted state rather than a fixed block of states.
+  parallelFor(numStates,numWorkerThreads(numThreads,numStates),
+	      [&](int state, int thread)
+	      {
+		convertState(game,state,rowStarts[state],
+			     rowStates[state],rowProbabilities[state]);
+	      });
+
+  // Transpose the rows into the reverse transition index.
+  reverseStarts = vector<int>(numStates+1,0);
   for (int state = 0; state < numStates; state++)
     {
-      numActions_total[state] = numActions[state][0] * numActions[state][1];
-      payoffs[state] = vector<SGPoint>(numActions_total[state]);
-      probabilities[state] = vector< vector<double> >(numActions_total[state],
-						      vector<double> (numStates,0));
+      for (int k = 0; k < rowStates[state].size(); k++)
+	reverseStarts[rowStates[state][k]+1]++;
+    }
+  for (int statep = 0; statep < numStates; statep++)
+    reverseStarts[statep+1] += reverseStarts[statep];
+
+  reverseStates.resize(reverseStarts.back());
+  reverseActions.resize(reverseStarts.back());
+  reverseProbabilities.resize(reverseStarts.back());
 
+  vector<int> next(reverseStarts.begin(),reverseStarts.end()-1);
+  for (int state = 0; state < numStates; state++)
+    {
       for (int action = 0; action < numActions_total[state]; action++)
 	{
-	  double probSum = 0;
-	  payoffs[state][action] = game.payoffs(state,action);
-	  for (int statep = 0; statep < numStates; statep++)
+	  for (int k = rowStarts[state][action];
+	       k < rowStarts[state][action+1]; k++)
 	    {
-	      probSum +=
-		(probabilities[state][action][statep]
-		 = game.probability(state,action,statep));
-	      assert (game.probability(state,action,statep)>=0);
+	      int pos = next[rowStates[state][k]]++;
+	      reverseStates[pos] = state;
+	      reverseActions[pos] = action;
+	      reverseProbabilities[pos] = rowProbabilities[state][k];
 	    }
-	  assert(abs(probSum-1.0)<1e-6);
-
-	  if (game.isEquilibriumAction(state,action))
-	    eqActions[state].push_back(action);
-	  
-	} // for action
-    } // for state
+	}
+    } // state
+  reverseTransitionsValid = true;
 } // Conversion from SGAbstractGame
 
+void SGGame::convertState(const SGAbstractGame & game, int state,
+			  vector<int> & rowStarts,
+			  vector<int> & rowStates,
+			  vector<double> & rowProbabilities)
+{
+  payoffs[state] = vector<SGPoint>(numActions_total[state]);
+  probabilities[state] = vector< vector<double> >(numActions_total[state],
+						  vector<double> (numStates,0));
+  rowStarts = vector<int>(1,0);
+  rowStarts.reserve(numActions_total[state]+1);
+
+  for (int action = 0; action < numActions_total[state]; action++)
+    {
+      double probSum = 0;
+      payoffs[state][action] = game.payoffs(state,action);
+
+      vector<double> & row = probabilities[state][action];
+      game.probabilities(state,action,&row[0]);
+      for (int statep = 0; statep < numStates; statep++)
+	{
+	  assert(row[statep]>=0);
+	  probSum += row[statep];
+	  if (row[statep] > 0)
+	    {
+	      rowStates.push_back(statep);
+	      rowProbabilities.push_back(row[statep]);
+	    }
+	}
+      assert(abs(probSum-1.0)<1e-6);
+      rowStarts.push_back(rowStates.size());
+
+      if (game.isEquilibriumAction(state,action))
+	eqActions[state].push_back(action);
+    } // for action
+} // convertState
+
 SGGame::SGGame(double _delta,
 	       int _numStates,
 	       const vector< vector<int> > & _numActions,
@@ -95,7 +154,8 @@ SGGame::SGGame(double _delta,
   probabilities(_probabilities),
   numActions_total(numStates,1),
   eqActions(_eqActions),
-  unconstrained(_unconstrained)
+  unconstrained(_unconstrained),
+  reverseTransitionsValid(false)
 {
   double probSum;
   double currentPayoff;
@@ -245,6 +305,7 @@ bool SGGame::setProbability(int state, int action,
       && prob >= 0)
     {
       probabilities[state][action][newState] = prob;
+      reverseTransitionsValid = false;
       return true;
     }
   return false;
@@ -291,6 +352,7 @@ bool SGGame::addAction(int state, int player, int position)
 
   numActions[state][player] ++;
   numActions_total[state] = numActions[state][0] * numActions[state][1];
+  reverseTransitionsValid = false;
 
   return true;
 } // addAction
@@ -333,6 +395,7 @@ bool SGGame::removeAction(int state, int player, int position)
   
   numActions[state][player] --;
   numActions_total[state] = numActions[state][0] * numActions[state][1];
+  reverseTransitionsValid = false;
 
   return true;
 } // removeAction
@@ -361,6 +424,7 @@ bool SGGame::addState(int position)
 	probabilities[state][action]
 	  .insert(probabilities[state][action].begin()+position,0.0);
     }
+  reverseTransitionsValid = false;
 
   return true;
 } // addState
@@ -385,9 +449,59 @@ bool SGGame::removeState(int state)
 	probabilities[state][action].erase(probabilities[state][action].begin()
 					   +state);
     }
+  reverseTransitionsValid = false;
   return true;
 } // removeState
 
+void SGGame::buildReverseTransitions() const
+{
+  if (reverseTransitionsValid)
+    return;
+
+  // First pass counts the entries in each column, second pass fills
+  // them in. Entries within a column are ordered by state and then
+  // by action.
+  reverseStarts = vector<int>(numStates+1,0);
+  for (int state = 0; state < numStates; state++)
+    {
+      for (int action = 0; action < numActions_total[state]; action++)
+	{
+	  for (int statep = 0; statep < numStates; statep++)
+	    {
+	      if (probabilities[state][action][statep] > 0)
+		reverseStarts[statep+1]++;
+	    }
+	}
+    } // state
+  for (int statep = 0; statep < numStates; statep++)
+    reverseStarts[statep+1] += reverseStarts[statep];
+
+  reverseStates.resize(reverseStarts.back());
+  reverseActions.resize(reverseStarts.back());
+  reverseProbabilities.resize(reverseStarts.back());
+
+  vector<int> next(reverseStarts.begin(),reverseStarts.end()-1);
+  for (int state = 0; state < numStates; state++)
+    {
+      for (int action = 0; action < numActions_total[state]; action++)
+	{
+	  for (int statep = 0; statep < numStates; statep++)
+	    {
+	      double prob = probabilities[state][action][statep];
+	      if (prob > 0)
+		{
+		  int k = next[statep]++;
+		  reverseStates[k] = state;
+		  reverseActions[k] = action;
+		  reverseProbabilities[k] = prob;
+		}
+	    }
+	}
+    } // state
+
+  reverseTransitionsValid = true;
+} // buildReverseTransitions
+
 bool SGGame::setConstrained(const vector<bool> & _unconstrained)
 {
   if (_unconstrained.size()!=2)
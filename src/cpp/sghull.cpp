@@ -0,0 +1,460 @@
+// This file is part of the SGSolve library for stochastic games
+// Copyright (C) 2016 Benjamin A. Brooks
+// 
+// SGSolve free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// SGSolve is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see
+// <http://www.gnu.org/licenses/>.
+// 
+// Benjamin A. Brooks
+// ben@benjaminbrooks.net
+// Chicago, IL
+
+
+#include "sghull.hpp"
+
+bool SGHull::build(const double * _points, int _numPoints)
+{
+  points = _points;
+  numPoints = _numPoints;
+
+  // Recycle all of the old facets.
+  freeFacets.clear();
+  for (int f = facets.size()-1; f >= 0; f--)
+    {
+      facets[f].alive = false;
+      facets[f].outside.clear();
+      freeFacets.push_back(f);
+    }
+  edges.clear();
+  pending.clear();
+
+  if (numPoints < 4)
+    return false;
+
+  double scale = 0;
+  for (int k = 0; k < 3*numPoints; k++)
+    scale = std::max(scale,abs(points[k]));
+  tol = 1e-10*(1+scale);
+
+  auto diff = [&](int a, int b, double * out)
+    {
+      for (int i = 0; i < 3; i++)
+	out[i] = point(a)[i]-point(b)[i];
+    };
+  auto cross = [](const double * u, const double * v, double * out)
+    {
+      out[0] = u[1]*v[2]-u[2]*v[1];
+      out[1] = u[2]*v[0]-u[0]*v[2];
+      out[2] = u[0]*v[1]-u[1]*v[0];
+    };
+  auto norm = [](const double * u)
+    { return sqrt(u[0]*u[0]+u[1]*u[1]+u[2]*u[2]); };
+
+  // Find an initial simplex: the point with the smallest first
+  // coordinate, the point furthest from it, the point furthest from
+  // the line through those two, and the point furthest from the plane
+  // through those three.
+  int v0 = 0, v1 = -1, v2 = -1, v3 = -1;
+  for (int k = 1; k < numPoints; k++)
+    {
+      if (point(k)[0] < point(v0)[0])
+	v0 = k;
+    }
+
+  double u[3], w[3], c[3], best = tol;
+  for (int k = 0; k < numPoints; k++)
+    {
+      diff(k,v0,u);
+      if (norm(u) > best)
+	{
+	  best = norm(u);
+	  v1 = k;
+	}
+    }
+  if (v1 < 0)
+    return false;
+
+  double e1[3];
+  diff(v1,v0,e1);
+  double e1Norm = norm(e1);
+  best = tol;
+  for (int k = 0; k < numPoints; k++)
+    {
+      diff(k,v0,u);
+      cross(e1,u,c);
+      if (norm(c)/e1Norm > best)
+	{
+	  best = norm(c)/e1Norm;
+	  v2 = k;
+	}
+    }
+  if (v2 < 0)
+    return false;
+
+  double n[3];
+  diff(v2,v0,u);
+  cross(e1,u,n);
+  double nNorm = norm(n);
+  best = tol;
+  for (int k = 0; k < numPoints; k++)
+    {
+      diff(k,v0,w);
+      double dist = abs(n[0]*w[0]+n[1]*w[1]+n[2]*w[2])/nNorm;
+      if (dist > best)
+	{
+	  best = dist;
+	  v3 = k;
+	}
+    }
+  if (v3 < 0)
+    return false;
+
+  // Orient the base so that the fourth vertex is below it.
+  diff(v3,v0,w);
+  if (n[0]*w[0]+n[1]*w[1]+n[2]*w[2] > 0)
+    std::swap(v1,v2);
+  newFacets.clear();
+  newFacets.push_back(addFacet(v0,v1,v2));
+  newFacets.push_back(addFacet(v0,v3,v1));
+  newFacets.push_back(addFacet(v1,v3,v2));
+  newFacets.push_back(addFacet(v2,v3,v0));
+  for (int k = 0; k < numPoints; k++)
+    {
+      if (k != v0 && k != v1 && k != v2 && k != v3)
+	assign(k,newFacets);
+    }
+  pending = newFacets;
+
+  while (!pending.empty())
+    {
+      int f = pending.back();
+      pending.pop_back();
+      if (facets[f].alive && !facets[f].outside.empty())
+	expand(f);
+    }
+
+  return true;
+} // build
+
+int SGHull::addFacet(int a, int b, int c)
+{
+  int f;
+  if (freeFacets.empty())
+    {
+      f = facets.size();
+      facets.push_back(Facet());
+    }
+  else
+    {
+      f = freeFacets.back();
+      freeFacets.pop_back();
+    }
+
+  Facet & facet = facets[f];
+  facet.vertices[0] = a;
+  facet.vertices[1] = b;
+  facet.vertices[2] = c;
+  facet.alive = true;
+
+  double u[3], w[3];
+  for (int i = 0; i < 3; i++)
+    {
+      u[i] = point(b)[i]-point(a)[i];
+      w[i] = point(c)[i]-point(a)[i];
+    }
+  facet.normal[0] = u[1]*w[2]-u[2]*w[1];
+  facet.normal[1] = u[2]*w[0]-u[0]*w[2];
+  facet.normal[2] = u[0]*w[1]-u[1]*w[0];
+  double length = sqrt(facet.normal[0]*facet.normal[0]
+		       +facet.normal[1]*facet.normal[1]
+		       +facet.normal[2]*facet.normal[2]);
+  facet.area = length/2;
+  facet.level = 0;
+  for (int i = 0; i < 3; i++)
+    {
+      // A degenerate facet gets a zero normal, so that no point can
+      // see it.
+      if (length > 0)
+	facet.normal[i] /= length;
+      facet.level += facet.normal[i]*point(a)[i];
+    }
+
+  edges[edgeKey(a,b)] = f;
+  edges[edgeKey(b,c)] = f;
+  edges[edgeKey(c,a)] = f;
+  return f;
+} // addFacet
+
+void SGHull::removeFacet(int f)
+{
+  Facet & facet = facets[f];
+  for (int i = 0; i < 3; i++)
+    edges.erase(edgeKey(facet.vertices[i],facet.vertices[(i+1)%3]));
+  facet.alive = false;
+  freeFacets.push_back(f);
+} // removeFacet
+
+double SGHull::height(int a, int b, int c, int k) const
+{
+  double u[3], w[3], normal[3];
+  for (int i = 0; i < 3; i++)
+    {
+      u[i] = point(b)[i]-point(a)[i];
+      w[i] = point(c)[i]-point(a)[i];
+    }
+  normal[0] = u[1]*w[2]-u[2]*w[1];
+  normal[1] = u[2]*w[0]-u[0]*w[2];
+  normal[2] = u[0]*w[1]-u[1]*w[0];
+  double length = sqrt(normal[0]*normal[0]+normal[1]*normal[1]
+		       +normal[2]*normal[2]);
+  if (length == 0)
+    return numeric_limits<double>::max();
+
+  double h = 0;
+  for (int i = 0; i < 3; i++)
+    h += normal[i]*(point(k)[i]-point(a)[i]);
+  return h/length;
+} // height
+
+double SGHull::height(int f, int k) const
+{
+  const Facet & facet = facets[f];
+  const double * p = point(k);
+  return facet.normal[0]*p[0]+facet.normal[1]*p[1]+facet.normal[2]*p[2]
+    - facet.level;
+} // height
+
+bool SGHull::assign(int k, const vector<int> & candidates)
+{
+  int best = -1;
+  double bestHeight = tol;
+  for (int i = 0; i < candidates.size(); i++)
+    {
+      double h = height(candidates[i],k);
+      if (h > bestHeight)
+	{
+	  bestHeight = h;
+	  best = candidates[i];
+	}
+    }
+  if (best < 0)
+    return false;
+
+  facets[best].outside.push_back(k);
+  return true;
+} // assign
+
+void SGHull::expand(int start)
+{
+  int k = facets[start].outside[0];
+  for (int i = 1; i < facets[start].outside.size(); i++)
+    {
+      if (height(start,facets[start].outside[i]) > height(start,k))
+	k = facets[start].outside[i];
+    }
+
+  // Grow the visible region through neighbouring facets, so that it
+  // stays connected even when rounding errors make the heights of
+  // distant facets inconsistent. A neighbour is also removed if the
+  // new facet through the shared edge would not bend away from it,
+  // which happens when the point is almost in line with the edge
+  // and only a little below the neighbour's plane.
+  if (isVisible.size() < facets.size())
+    isVisible.resize(facets.size(),0);
+  visible.assign(1,start);
+  isVisible[start] = 1;
+  horizon.clear();
+  for (int i = 0; i < visible.size(); i++)
+    {
+      const Facet & facet = facets[visible[i]];
+      for (int j = 0; j < 3; j++)
+	{
+	  int a = facet.vertices[j], b = facet.vertices[(j+1)%3];
+	  int twin = edges[edgeKey(b,a)];
+	  if (isVisible[twin])
+	    continue;
+	  const Facet & neighbour = facets[twin];
+	  int c = neighbour.vertices[0];
+	  for (int v = 1; v < 3 && (c == a || c == b); v++)
+	    c = neighbour.vertices[v];
+	  if (height(twin,k) > tol || height(a,b,k,c) > -tol)
+	    {
+	      isVisible[twin] = 1;
+	      visible.push_back(twin);
+	    }
+	}
+    } // i
+
+  // The horizon consists of the edges of visible facets whose
+  // neighbours are not visible.
+  for (int i = 0; i < visible.size(); i++)
+    {
+      const Facet & facet = facets[visible[i]];
+      for (int j = 0; j < 3; j++)
+	{
+	  int a = facet.vertices[j], b = facet.vertices[(j+1)%3];
+	  if (!isVisible[edges[edgeKey(b,a)]])
+	    {
+	      horizon.push_back(a);
+	      horizon.push_back(b);
+	    }
+	}
+    } // i
+
+  orphans.clear();
+  for (int i = 0; i < visible.size(); i++)
+    {
+      Facet & facet = facets[visible[i]];
+      for (int j = 0; j < facet.outside.size(); j++)
+	{
+	  if (facet.outside[j] != k)
+	    orphans.push_back(facet.outside[j]);
+	}
+      facet.outside.clear();
+      isVisible[visible[i]] = 0;
+      removeFacet(visible[i]);
+    }
+
+  newFacets.clear();
+  for (int i = 0; i < horizon.size(); i += 2)
+    newFacets.push_back(addFacet(horizon[i],horizon[i+1],k));
+
+  // Points that are not above any of the new facets are now inside
+  // the hull.
+  for (int i = 0; i < orphans.size(); i++)
+    assign(orphans[i],newFacets);
+  for (int i = 0; i < newFacets.size(); i++)
+    {
+      if (!facets[newFacets[i]].outside.empty())
+	pending.push_back(newFacets[i]);
+    }
+} // expand
+
+void SGHull::getFacets(vector<double> & planes) const
+{
+  // Visit the facets from the largest down, and grow a face from each
+  // one that has not been merged yet.
+  vector<int> byArea;
+  for (int f = 0; f < facets.size(); f++)
+    {
+      if (facets[f].alive)
+	byArea.push_back(f);
+    }
+  std::sort(byArea.begin(),byArea.end(),
+	    [&](int f0, int f1) { return facets[f0].area > facets[f1].area; });
+
+  planes.clear();
+  vector<char> merged(facets.size(),0);
+  vector<int> face;
+  for (int i = 0; i < byArea.size(); i++)
+    {
+      int seed = byArea[i];
+      if (merged[seed])
+	continue;
+
+      const Facet & plane = facets[seed];
+      face.assign(1,seed);
+      merged[seed] = 1;
+      for (int j = 0; j < face.size(); j++)
+	{
+	  const Facet & facet = facets[face[j]];
+	  for (int e = 0; e < 3; e++)
+	    {
+	      int a = facet.vertices[e], b = facet.vertices[(e+1)%3];
+	      auto twin = edges.find(edgeKey(b,a));
+	      if (twin == edges.end() || merged[twin->second])
+		continue;
+
+	      // Merge the neighbour if its vertices are on the seed's
+	      // plane.
+	      const Facet & next = facets[twin->second];
+	      bool coplanar = true;
+	      for (int v = 0; v < 3 && coplanar; v++)
+		{
+		  const double * p = point(next.vertices[v]);
+		  double h = plane.normal[0]*p[0]+plane.normal[1]*p[1]
+		    +plane.normal[2]*p[2] - plane.level;
+		  if (abs(h) > tol)
+		    coplanar = false;
+		}
+	      if (coplanar)
+		{
+		  merged[twin->second] = 1;
+		  face.push_back(twin->second);
+		}
+	    } // e
+	} // j
+
+      // The normal of a thin facet can be off by much more than the
+      // tolerance, so the level is the highest of all of the points
+      // rather than of the face's vertices. The plane then supports
+      // the hull whatever its normal is.
+      double level = -numeric_limits<double>::max();
+      for (int k = 0; k < numPoints; k++)
+	{
+	  const double * p = point(k);
+	  level = std::max(level,plane.normal[0]*p[0]+plane.normal[1]*p[1]
+			   +plane.normal[2]*p[2]);
+	}
+
+      planes.insert(planes.end(),plane.normal,plane.normal+3);
+      planes.push_back(level);
+    } // i
+} // getFacets
+
+void SGHull::getVertices(vector<int> & vertices) const
+{
+  vector<char> isVertex(numPoints,0);
+  for (int f = 0; f < facets.size(); f++)
+    {
+      if (!facets[f].alive)
+	continue;
+      for (int i = 0; i < 3; i++)
+	isVertex[facets[f].vertices[i]] = 1;
+    }
+
+  vertices.clear();
+  for (int k = 0; k < numPoints; k++)
+    {
+      if (isVertex[k])
+	vertices.push_back(k);
+    }
+} // getVertices
+
+double SGHull::volume() const
+{
+  // Sum the signed volumes of the tetrahedra between each facet and a
+  // common vertex.
+  double total = 0;
+  const double * o = NULL;
+  for (int f = 0; f < facets.size(); f++)
+    {
+      if (!facets[f].alive)
+	continue;
+      const int * v = facets[f].vertices;
+      if (o == NULL)
+	o = point(v[0]);
+
+      double a[3], b[3], c[3];
+      for (int i = 0; i < 3; i++)
+	{
+	  a[i] = point(v[0])[i]-o[i];
+	  b[i] = point(v[1])[i]-o[i];
+	  c[i] = point(v[2])[i]-o[i];
+	}
+      total += a[0]*(b[1]*c[2]-b[2]*c[1])
+	+ a[1]*(b[2]*c[0]-b[0]*c[2])
+	+ a[2]*(b[0]*c[1]-b[1]*c[0]);
+    } // f
+  return total/6.0;
+} // volume
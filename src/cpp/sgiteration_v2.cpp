@@ -0,0 +1,47 @@
+// This file is part of the SGSolve library for stochastic games
+// Copyright (C) 2016 Benjamin A. Brooks
+// 
+// SGSolve free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// SGSolve is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see
+// <http://www.gnu.org/licenses/>.
+// 
+// Benjamin A. Brooks
+// ben@benjaminbrooks.net
+// Chicago, IL
+
+#include "sgapprox_v2.hpp"
+
+SGIteration_V2::SGIteration_V2(const SGApprox_V2 & approx,
+			       bool storeActions):
+  iteration(approx.getNumIterations()),
+  payoffTuples(approx.getPivots()),
+  hyperplanes(approx.getW().begin(),approx.getW().end()),
+  actionTuples(approx.getActionTuples()),
+  regimeTuples(approx.getRegimeTuples()),
+  actions(approx.getActions().size()),
+  threatTuple(approx.getThreatTuple())
+{
+  if (storeActions)
+    {
+      for (int state = 0; state < actions.size(); state++)
+	{
+	  for (list<SGAction>::const_iterator action
+		 = approx.getActions()[state].begin();
+	       action != approx.getActions()[state].end();
+	       ++action)
+	    {
+	      actions[state].push_back(SGBaseAction(*action));
+	    }
+	}
+    }
+}
@@ -0,0 +1,113 @@
+// This file is part of the SGSolve library for stochastic games
+// Copyright (C) 2016 Benjamin A. Brooks
+// 
+// SGSolve free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// SGSolve is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see
+// <http://www.gnu.org/licenses/>.
+// 
+// Benjamin A. Brooks
+// ben@benjaminbrooks.net
+// Chicago, IL
+
+#include "sglazygame.hpp"
+
+SGLazyGame::SGLazyGame(const SGAbstractGame & _game, int _cacheSize):
+  game(_game),
+  delta(_game.getDelta()),
+  numPlayers(2),
+  numStates(_game.getNumStates()),
+  numActions(_game.getNumActions()),
+  numActions_total(numStates),
+  actionOffsets(numStates+1,0),
+  payoffs(numStates),
+  eqActions(numStates),
+  unconstrained(2),
+  payoffUB(-numeric_limits<double>::max()),
+  payoffLB(numeric_limits<double>::max()),
+  cacheSize(_cacheSize),
+  numRowEvaluations(0)
+{
+  if (cacheSize < 1)
+    throw(SGException(SG::BAD_PARAM_VALUE));
+
+  for (int player = 0; player < numPlayers; player++)
+    unconstrained[player] = !game.constrained(player);
+
+  for (int state = 0; state < numStates; state++)
+    {
+      numActions_total[state] = numActions[state][0]*numActions[state][1];
+      actionOffsets[state+1] = actionOffsets[state]+numActions_total[state];
+
+      payoffs[state].resize(numActions_total[state]);
+      for (int action = 0; action < numActions_total[state]; action++)
+	{
+	  payoffs[state][action] = game.payoffs(state,action);
+	  payoffUB.max(payoffs[state][action]);
+	  payoffLB.min(payoffs[state][action]);
+
+	  if (game.isEquilibriumAction(state,action))
+	    eqActions[state].push_back(action);
+	} // action
+    } // state
+} // constructor
+
+const vector<double> & SGLazyGame::getTransitions(int state,
+						  int action) const
+{
+  long key = actionOffsets[state]+action;
+
+  auto it = rowIndex.find(key);
+  if (it != rowIndex.end())
+    {
+      // Move the row to the front of the list.
+      rows.splice(rows.begin(),rows,it->second);
+      return rows.front().second;
+    }
+
+  if (rows.size() < cacheSize)
+    rows.push_front(make_pair(key,vector<double>(numStates,0)));
+  else
+    {
+      // Reuse the storage of the least recently used row.
+      rowIndex.erase(rows.back().first);
+      rows.splice(rows.begin(),rows,--rows.end());
+      rows.front().first = key;
+    }
+  rowIndex[key] = rows.begin();
+
+  vector<double> & row = rows.front().second;
+  game.probabilities(state,action,&row[0]);
+  numRowEvaluations++;
+
+  return row;
+} // getTransitions
+
+bool SGLazyGame::setCacheSize(int newCacheSize)
+{
+  if (newCacheSize < 1)
+    return false;
+
+  cacheSize = newCacheSize;
+  while (rows.size() > cacheSize)
+    {
+      rowIndex.erase(rows.back().first);
+      rows.pop_back();
+    }
+  return true;
+} // setCacheSize
+
+void SGLazyGame::clearCache() const
+{
+  rows.clear();
+  rowIndex.clear();
+} // clearCache
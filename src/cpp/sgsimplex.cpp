@@ -0,0 +1,814 @@
+// This file is part of the SGSolve library for stochastic games
+// Copyright (C) 2016 Benjamin A. Brooks
+// 
+// SGSolve free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// SGSolve is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see
+// <http://www.gnu.org/licenses/>.
+// 
+// Benjamin A. Brooks
+// ben@benjaminbrooks.net
+// Chicago, IL
+
+#include "sgsimplex.hpp"
+
+constexpr double SGLP::INF;
+
+int SGSimplex::addVariables(int num, double lb, double ub)
+{
+  if (num < 0 || lb > ub)
+    throw(SGException(SG::BAD_PARAM_VALUE));
+
+  int first = numVars;
+  lower.insert(lower.end(),num,lb);
+  upper.insert(upper.end(),num,ub);
+  cost.insert(cost.end(),num,0.0);
+  colRows.resize(numVars+num);
+  colVals.resize(numVars+num);
+
+  // Logical variables are numbered after the structural variables,
+  // so their indices shift.
+  for (int p = 0; p < head.size(); p++)
+    {
+      if (head[p] >= numVars)
+	head[p] += num;
+    }
+  x.insert(x.begin()+numVars,num,0.0);
+  varStatus.insert(varStatus.begin()+numVars,num,AT_LOWER);
+  numVars += num;
+
+  for (int j = first; j < numVars; j++)
+    placeNonbasic(j);
+
+  status = NOT_SOLVED;
+  return first;
+} // addVariables
+
+int SGSimplex::addConstraint(const SGLinExpr & expr, Sense sense,
+			     double _rhs)
+{
+  int i = numConstrs;
+
+  // Merge repeated variables.
+  vector< pair<int,double> > terms;
+  terms.reserve(expr.size());
+  for (int k = 0; k < expr.size(); k++)
+    {
+      if (expr.vars[k] < 0 || expr.vars[k] >= numVars)
+	throw(SGException(SG::OUT_OF_BOUNDS));
+      terms.push_back(make_pair(expr.vars[k],expr.coefs[k]));
+    }
+  sort(terms.begin(),terms.end());
+  for (int k = 0; k < terms.size(); k++)
+    {
+      int j = terms[k].first;
+      double coef = terms[k].second;
+      while (k+1 < terms.size() && terms[k+1].first == j)
+	coef += terms[++k].second;
+      if (coef != 0)
+	{
+	  colRows[j].push_back(i);
+	  colVals[j].push_back(coef);
+	}
+    } // for k
+
+  senses.push_back(sense);
+  rhs.push_back(_rhs-expr.constant);
+  rowLower.push_back(0);
+  rowUpper.push_back(0);
+  setRowBounds(i);
+
+  // The logical of the new constraint enters the basis.
+  x.push_back(0);
+  varStatus.push_back(BASIC);
+  numConstrs++;
+
+  factorValid = false;
+  status = NOT_SOLVED;
+  return i;
+} // addConstraint
+
+void SGSimplex::removeConstraints(int first, int num)
+{
+  if (num <= 0)
+    return;
+  if (first < 0 || first+num > numConstrs)
+    throw(SGException(SG::OUT_OF_BOUNDS));
+
+  for (int j = 0; j < numVars; j++)
+    {
+      int kept = 0;
+      for (int k = 0; k < colRows[j].size(); k++)
+	{
+	  int i = colRows[j][k];
+	  if (i >= first && i < first+num)
+	    continue;
+	  colRows[j][kept] = (i < first? i: i-num);
+	  colVals[j][kept] = colVals[j][k];
+	  kept++;
+	}
+      colRows[j].resize(kept);
+      colVals[j].resize(kept);
+    } // for j
+
+  senses.erase(senses.begin()+first,senses.begin()+first+num);
+  rhs.erase(rhs.begin()+first,rhs.begin()+first+num);
+  rowLower.erase(rowLower.begin()+first,rowLower.begin()+first+num);
+  rowUpper.erase(rowUpper.begin()+first,rowUpper.begin()+first+num);
+  x.erase(x.begin()+numVars+first,x.begin()+numVars+first+num);
+  varStatus.erase(varStatus.begin()+numVars+first,
+		  varStatus.begin()+numVars+first+num);
+  numConstrs -= num;
+
+  factorValid = false;
+  status = NOT_SOLVED;
+} // removeConstraints
+
+void SGSimplex::setRHS(int constr, double _rhs)
+{
+  if (constr < 0 || constr >= numConstrs)
+    throw(SGException(SG::OUT_OF_BOUNDS));
+  rhs[constr] = _rhs;
+  setRowBounds(constr);
+  status = NOT_SOLVED;
+} // setRHS
+
+void SGSimplex::setBounds(int var, double lb, double ub)
+{
+  if (var < 0 || var >= numVars)
+    throw(SGException(SG::OUT_OF_BOUNDS));
+  if (lb > ub)
+    throw(SGException(SG::BAD_PARAM_VALUE));
+  lower[var] = lb;
+  upper[var] = ub;
+  status = NOT_SOLVED;
+} // setBounds
+
+void SGSimplex::setBasis(const vector<int> & basis)
+{
+  if (basis.size() != numVars+numConstrs)
+    throw(SGException(SG::BAD_PARAM_VALUE));
+  for (int j = 0; j < basis.size(); j++)
+    {
+      if (basis[j] > BASIC || basis[j] < SUPERBASIC)
+	throw(SGException(SG::BAD_PARAM_VALUE));
+    }
+  varStatus = basis;
+  factorValid = false;
+  status = NOT_SOLVED;
+} // setBasis
+
+void SGSimplex::setObjective(const SGLinExpr & expr, bool _maximize)
+{
+  std::fill(cost.begin(),cost.end(),0.0);
+  for (int k = 0; k < expr.size(); k++)
+    {
+      if (expr.vars[k] < 0 || expr.vars[k] >= numVars)
+	throw(SGException(SG::OUT_OF_BOUNDS));
+      cost[expr.vars[k]] += expr.coefs[k];
+    }
+  objConstant = expr.constant;
+  maximize = _maximize;
+  status = NOT_SOLVED;
+} // setObjective
+
+void SGSimplex::setRowBounds(int i)
+{
+  switch (senses[i])
+    {
+    case LESSEQUAL:
+      rowLower[i] = -INF;
+      rowUpper[i] = rhs[i];
+      break;
+    case GREATEREQUAL:
+      rowLower[i] = rhs[i];
+      rowUpper[i] = INF;
+      break;
+    case EQUAL:
+      rowLower[i] = rhs[i];
+      rowUpper[i] = rhs[i];
+      break;
+    }
+} // setRowBounds
+
+void SGSimplex::ftran(int j, vector<double> & w) const
+{
+  int m = numConstrs;
+  w.assign(m,0.0);
+  if (j < numVars)
+    {
+      for (int k = 0; k < colRows[j].size(); k++)
+	{
+	  const double * col = Binv.data()+colRows[j][k];
+	  double val = colVals[j][k];
+	  for (int p = 0; p < m; p++)
+	    w[p] += col[p*m]*val;
+	}
+    }
+  else
+    {
+      // The column of a logical is -e_i.
+      const double * col = Binv.data()+(j-numVars);
+      for (int p = 0; p < m; p++)
+	w[p] = -col[p*m];
+    }
+} // ftran
+
+double SGSimplex::dotColumn(const double * y, int j) const
+{
+  if (j >= numVars)
+    return -y[j-numVars];
+
+  double sum = 0;
+  for (int k = 0; k < colRows[j].size(); k++)
+    sum += y[colRows[j][k]]*colVals[j][k];
+  return sum;
+} // dotColumn
+
+void SGSimplex::btran(const vector<double> & cB, vector<double> & y) const
+{
+  int m = numConstrs;
+  y.assign(m,0.0);
+  for (int p = 0; p < m; p++)
+    {
+      if (cB[p] == 0)
+	continue;
+      const double * row = Binv.data()+p*m;
+      for (int k = 0; k < m; k++)
+	y[k] += cB[p]*row[k];
+    }
+} // btran
+
+void SGSimplex::placeNonbasic(int j)
+{
+  double l = lb(j), u = ub(j);
+  if (varStatus[j] == AT_UPPER && u < INF)
+    x[j] = u;
+  else if (l > -INF)
+    {
+      varStatus[j] = AT_LOWER;
+      x[j] = l;
+    }
+  else if (u < INF)
+    {
+      varStatus[j] = AT_UPPER;
+      x[j] = u;
+    }
+  else
+    {
+      varStatus[j] = SUPERBASIC;
+      x[j] = 0;
+    }
+} // placeNonbasic
+
+void SGSimplex::pivot(int r, int q, const vector<double> & w)
+{
+  int m = numConstrs;
+  double * rowR = Binv.data()+r*m;
+  double scale = 1.0/w[r];
+  for (int k = 0; k < m; k++)
+    rowR[k] *= scale;
+  for (int p = 0; p < m; p++)
+    {
+      if (p == r || w[p] == 0)
+	continue;
+      double factor = w[p];
+      double * row = Binv.data()+p*m;
+      for (int k = 0; k < m; k++)
+	row[k] -= factor*rowR[k];
+    }
+
+  head[r] = q;
+  varStatus[q] = BASIC;
+  pivotsSinceFactor++;
+} // pivot
+
+void SGSimplex::factorize()
+{
+  int m = numConstrs;
+  Binv.assign(m*m,0.0);
+  for (int i = 0; i < m; i++)
+    Binv[i*m+i] = 1.0;
+  head.assign(m,-1);
+
+  // Pivot in the basic logicals first, since they only touch their
+  // own rows, and then the basic structural variables.
+  vector<int> order;
+  for (int j = numVars; j < numVars+m; j++)
+    {
+      if (varStatus[j] == BASIC)
+	order.push_back(j);
+    }
+  for (int j = 0; j < numVars; j++)
+    {
+      if (varStatus[j] == BASIC)
+	order.push_back(j);
+    }
+
+  vector<bool> rowDone(m,false);
+  vector<double> w;
+  for (int k = 0; k < order.size(); k++)
+    {
+      int j = order[k];
+      ftran(j,w);
+
+      int r = -1;
+      double best = pivotTol;
+      for (int i = 0; i < m; i++)
+	{
+	  if (!rowDone[i] && abs(w[i]) > best)
+	    {
+	      r = i;
+	      best = abs(w[i]);
+	    }
+	}
+      if (r < 0)
+	{
+	  // Column is dependent on those already in the basis.
+	  varStatus[j] = AT_LOWER;
+	  placeNonbasic(j);
+	  continue;
+	}
+
+      pivot(r,j,w);
+      rowDone[r] = true;
+    } // for k
+
+  // Fill the remaining positions with logicals.
+  for (int i = 0; i < m; i++)
+    {
+      if (rowDone[i])
+	continue;
+      ftran(numVars+i,w);
+      pivot(i,numVars+i,w);
+    }
+
+  pivotsSinceFactor = 0;
+  factorValid = true;
+} // factorize
+
+void SGSimplex::computePrimal()
+{
+  int m = numConstrs;
+  vector<double> b(m,0.0);
+  for (int j = 0; j < numVars+m; j++)
+    {
+      if (varStatus[j] == BASIC)
+	continue;
+      placeNonbasic(j);
+      if (x[j] == 0)
+	continue;
+      if (j < numVars)
+	{
+	  for (int k = 0; k < colRows[j].size(); k++)
+	    b[colRows[j][k]] -= colVals[j][k]*x[j];
+	}
+      else
+	b[j-numVars] += x[j];
+    } // for j
+
+  for (int p = 0; p < m; p++)
+    {
+      const double * row = Binv.data()+p*m;
+      double sum = 0;
+      for (int k = 0; k < m; k++)
+	sum += row[k]*b[k];
+      x[head[p]] = sum;
+    }
+} // computePrimal
+
+bool SGSimplex::primalFeasible() const
+{
+  for (int p = 0; p < numConstrs; p++)
+    {
+      int j = head[p];
+      if (x[j] < lb(j)-feasTol || x[j] > ub(j)+feasTol)
+	return false;
+    }
+  return true;
+} // primalFeasible
+
+bool SGSimplex::dualFeasible()
+{
+  int m = numConstrs;
+  vector<double> cB(m), y;
+  for (int p = 0; p < m; p++)
+    cB[p] = phaseTwoCost(head[p]);
+  btran(cB,y);
+
+  for (int j = 0; j < numVars+m; j++)
+    {
+      if (varStatus[j] == BASIC || lb(j) == ub(j))
+	continue;
+      double d = phaseTwoCost(j)-dotColumn(y.data(),j);
+      if ( (varStatus[j] != AT_UPPER && d < -scaledOptTol)
+	   || (varStatus[j] != AT_LOWER && d > scaledOptTol) )
+	return false;
+    }
+  return true;
+} // dualFeasible
+
+SGLP::Status SGSimplex::primal()
+{
+  int m = numConstrs;
+  int numTotal = numVars+m;
+  vector<double> cB(m), y, w, rate(m);
+  vector<bool> rejected(numTotal,false);
+  int degenerateSteps = 0;
+
+  while (numIterations < iterationLimit)
+    {
+      if (pivotsSinceFactor >= refactorFrequency)
+	{
+	  factorize();
+	  computePrimal();
+	}
+
+      // Phase one minimizes the sum of infeasibilities of the basic
+      // variables.
+      bool phaseOne = false;
+      for (int p = 0; p < m; p++)
+	{
+	  int j = head[p];
+	  cB[p] = 0;
+	  if (x[j] < lb(j)-feasTol)
+	    cB[p] = -1;
+	  else if (x[j] > ub(j)+feasTol)
+	    cB[p] = 1;
+	  if (cB[p] != 0)
+	    phaseOne = true;
+	}
+      if (!phaseOne)
+	{
+	  for (int p = 0; p < m; p++)
+	    cB[p] = phaseTwoCost(head[p]);
+	}
+      btran(cB,y);
+
+      // Pricing. Fall back on Bland's rule after a long run of
+      // degenerate pivots.
+      double tol = phaseOne? optTol: scaledOptTol;
+      bool bland = degenerateSteps > 50;
+      int q = -1;
+      double dir = 0, best = tol;
+      for (int j = 0; j < numTotal; j++)
+	{
+	  if (varStatus[j] == BASIC || lb(j) == ub(j) || rejected[j])
+	    continue;
+	  double d = (phaseOne? 0.0: phaseTwoCost(j))-dotColumn(y.data(),j);
+	  if (d < -best && varStatus[j] != AT_UPPER)
+	    {
+	      q = j;
+	      dir = 1;
+	      best = -d;
+	    }
+	  else if (d > best && varStatus[j] != AT_LOWER)
+	    {
+	      q = j;
+	      dir = -1;
+	      best = d;
+	    }
+	  if (bland && q >= 0)
+	    break;
+	} // for j
+      if (q < 0)
+	return phaseOne? INFEASIBLE: OPTIMAL;
+
+      ftran(q,w);
+      for (int p = 0; p < m; p++)
+	rate[p] = -dir*w[p];
+
+      // Harris ratio test. The first pass finds the largest step
+      // with bounds relaxed by feasTol, and the second pass picks
+      // the largest pivot among the blocking variables within that
+      // step.
+      double tMax = INF;
+      for (int p = 0; p < m; p++)
+	{
+	  int j = head[p];
+	  double bound;
+	  if (rate[p] > pivotTol)
+	    {
+	      if (x[j] > ub(j)+feasTol)
+		continue;
+	      else if (x[j] < lb(j)-feasTol)
+		bound = lb(j);
+	      else if (ub(j) < INF)
+		bound = ub(j);
+	      else
+		continue;
+	      tMax = std::min(tMax,(bound-x[j]+feasTol)/rate[p]);
+	    }
+	  else if (rate[p] < -pivotTol)
+	    {
+	      if (x[j] < lb(j)-feasTol)
+		continue;
+	      else if (x[j] > ub(j)+feasTol)
+		bound = ub(j);
+	      else if (lb(j) > -INF)
+		bound = lb(j);
+	      else
+		continue;
+	      tMax = std::min(tMax,(x[j]-bound+feasTol)/(-rate[p]));
+	    }
+	} // for p
+
+      double range = INF;
+      if (lb(q) > -INF && ub(q) < INF)
+	range = ub(q)-lb(q);
+
+      if (tMax >= INF && range >= INF)
+	{
+	  // A ray along which the objective improves by no more than
+	  // the rounding errors in the basic variables times the
+	  // largest cost is not evidence of unboundedness. Skip the
+	  // variable until the basis changes.
+	  double rayNorm = 1.0;
+	  for (int p = 0; p < m; p++)
+	    rayNorm = std::max(rayNorm,abs(rate[p]));
+	  if (!phaseOne && best <= 1e-9*maxCost*rayNorm)
+	    {
+	      rejected[q] = true;
+	      continue;
+	    }
+	  return phaseOne? NOT_SOLVED: UNBOUNDED;
+	}
+
+      int r = -1;
+      double t = range, leavingBound = 0;
+      if (range > tMax)
+	{
+	  double bestPivot = 0;
+	  for (int p = 0; p < m; p++)
+	    {
+	      if (abs(rate[p]) <= pivotTol)
+		continue;
+	      int j = head[p];
+	      double bound, ratio;
+	      if (rate[p] > 0)
+		{
+		  if (x[j] > ub(j)+feasTol)
+		    continue;
+		  else if (x[j] < lb(j)-feasTol)
+		    bound = lb(j);
+		  else if (ub(j) < INF)
+		    bound = ub(j);
+		  else
+		    continue;
+		  ratio = (bound-x[j])/rate[p];
+		}
+	      else
+		{
+		  if (x[j] < lb(j)-feasTol)
+		    continue;
+		  else if (x[j] > ub(j)+feasTol)
+		    bound = ub(j);
+		  else if (lb(j) > -INF)
+		    bound = lb(j);
+		  else
+		    continue;
+		  ratio = (x[j]-bound)/(-rate[p]);
+		}
+	      if (ratio > tMax)
+		continue;
+	      if (bland? (r < 0 || j < head[r]): abs(rate[p]) > bestPivot)
+		{
+		  r = p;
+		  bestPivot = abs(rate[p]);
+		  t = std::max(0.0,ratio);
+		  leavingBound = bound;
+		}
+	    } // for p
+	  if (r < 0)
+	    return NOT_SOLVED;
+	}
+
+      x[q] += dir*t;
+      for (int p = 0; p < m; p++)
+	x[head[p]] += t*rate[p];
+
+      if (r < 0)
+	{
+	  // The entering variable moves to its other bound.
+	  varStatus[q] = (dir > 0? AT_UPPER: AT_LOWER);
+	  x[q] = (dir > 0? ub(q): lb(q));
+	}
+      else
+	{
+	  int j = head[r];
+	  x[j] = leavingBound;
+	  varStatus[j] = ( (leavingBound == ub(j) && lb(j) < ub(j))?
+			   AT_UPPER: AT_LOWER);
+	  pivot(r,q,w);
+	  std::fill(rejected.begin(),rejected.end(),false);
+	}
+
+      if (t < 1e-12)
+	degenerateSteps++;
+      else
+	degenerateSteps = 0;
+      numIterations++;
+    } // while
+
+  return ITERATION_LIMIT;
+} // primal
+
+SGLP::Status SGSimplex::dual()
+{
+  int m = numConstrs;
+  int numTotal = numVars+m;
+  vector<double> cB(m), y, w;
+
+  while (numIterations < iterationLimit)
+    {
+      if (pivotsSinceFactor >= refactorFrequency)
+	{
+	  factorize();
+	  computePrimal();
+	}
+
+      // The most infeasible basic variable leaves.
+      int r = -1;
+      bool below = false;
+      double worst = feasTol;
+      for (int p = 0; p < m; p++)
+	{
+	  int j = head[p];
+	  if (lb(j)-x[j] > worst)
+	    {
+	      r = p;
+	      below = true;
+	      worst = lb(j)-x[j];
+	    }
+	  else if (x[j]-ub(j) > worst)
+	    {
+	      r = p;
+	      below = false;
+	      worst = x[j]-ub(j);
+	    }
+	}
+      if (r < 0)
+	return OPTIMAL;
+
+      for (int p = 0; p < m; p++)
+	cB[p] = phaseTwoCost(head[p]);
+      btran(cB,y);
+      const double * rho = Binv.data()+r*m;
+
+      // Dual ratio test on the nonbasic variables that can move the
+      // leaving variable towards its violated bound. The leaving
+      // variable changes by -alpha_j times the change in x_j.
+      double sign = (below? 1.0: -1.0);
+      double tMax = INF;
+      vector<int> candidates;
+      vector<double> alphas, ratios;
+      for (int j = 0; j < numTotal; j++)
+	{
+	  if (varStatus[j] == BASIC || lb(j) == ub(j))
+	    continue;
+	  double alpha = dotColumn(rho,j);
+	  if (abs(alpha) <= pivotTol)
+	    continue;
+	  bool increase = (-alpha*sign > 0);
+	  if ( (increase && varStatus[j] == AT_UPPER)
+	       || (!increase && varStatus[j] == AT_LOWER) )
+	    continue;
+
+	  double d = phaseTwoCost(j)-dotColumn(y.data(),j);
+	  double slack = std::max(0.0,increase? d: -d);
+	  candidates.push_back(j);
+	  alphas.push_back(alpha);
+	  ratios.push_back(slack/abs(alpha));
+	  tMax = std::min(tMax,(slack+scaledOptTol)/abs(alpha));
+	} // for j
+      if (candidates.empty())
+	return INFEASIBLE;
+
+      int q = -1;
+      double bestPivot = 0;
+      for (int k = 0; k < candidates.size(); k++)
+	{
+	  if (ratios[k] <= tMax && abs(alphas[k]) > bestPivot)
+	    {
+	      q = candidates[k];
+	      bestPivot = abs(alphas[k]);
+	    }
+	}
+
+      ftran(q,w);
+      int j = head[r];
+      double target = (below? lb(j): ub(j));
+      double step = (target-x[j])/(-w[r]);
+      x[q] += step;
+      for (int p = 0; p < m; p++)
+	x[head[p]] -= w[p]*step;
+      x[j] = target;
+      varStatus[j] = ( (below || lb(j) == ub(j))? AT_LOWER: AT_UPPER);
+      pivot(r,q,w);
+
+      numIterations++;
+    } // while
+
+  return ITERATION_LIMIT;
+} // dual
+
+SGLP::Status SGSimplex::solve()
+{
+  numIterations = 0;
+
+  // Reduced costs carry rounding errors in proportion to the largest
+  // objective coefficient.
+  maxCost = 0.0;
+  for (int j = 0; j < numVars; j++)
+    maxCost = std::max(maxCost,abs(cost[j]));
+  scaledOptTol = std::max(optTol,1e-12*maxCost);
+
+  if (!factorValid)
+    factorize();
+  computePrimal();
+
+  status = NOT_SOLVED;
+  if (!primalFeasible() && dualFeasible())
+    status = dual();
+
+  // The primal method finishes the job. If the dual method stopped
+  // at an optimum, this only confirms it. Rounding errors from the
+  // product form updates are cleaned up by recomputing the primal
+  // solution from a fresh factorization.
+  for (int attempt = 0; attempt < 3; attempt++)
+    {
+      if (status == ITERATION_LIMIT)
+	break;
+      status = primal();
+      if (status != OPTIMAL || pivotsSinceFactor == 0)
+	break;
+      factorize();
+      computePrimal();
+      if (primalFeasible())
+	break;
+    }
+
+  objValue = objConstant;
+  for (int j = 0; j < numVars; j++)
+    objValue += cost[j]*x[j];
+
+  return status;
+} // solve
+
+void SGSimplex::getRHSRange(int constr, double & low, double & high) const
+{
+  if (constr < 0 || constr >= numConstrs)
+    throw(SGException(SG::OUT_OF_BOUNDS));
+
+  int m = numConstrs;
+  int j = numVars+constr;
+  if (varStatus[j] == BASIC)
+    {
+      // The constraint is slack, so the basis is unaffected until
+      // the right hand side reaches the activity.
+      low = -INF;
+      high = INF;
+      if (senses[constr] != GREATEREQUAL)
+	low = x[j];
+      if (senses[constr] != LESSEQUAL)
+	high = x[j];
+      return;
+    }
+
+  // Moving the right hand side by t moves the basic variables by t
+  // times column constr of Binv.
+  double up = INF, down = INF;
+  for (int p = 0; p < m; p++)
+    {
+      double g = Binv[p*m+constr];
+      if (abs(g) <= pivotTol)
+	continue;
+      int k = head[p];
+      if (g > 0)
+	{
+	  if (ub(k) < INF)
+	    up = std::min(up,(ub(k)-x[k])/g);
+	  if (lb(k) > -INF)
+	    down = std::min(down,(x[k]-lb(k))/g);
+	}
+      else
+	{
+	  if (lb(k) > -INF)
+	    up = std::min(up,(x[k]-lb(k))/(-g));
+	  if (ub(k) < INF)
+	    down = std::min(down,(ub(k)-x[k])/(-g));
+	}
+    } // for p
+
+  low = (down < INF? rhs[constr]-std::max(0.0,down): -INF);
+  high = (up < INF? rhs[constr]+std::max(0.0,up): INF);
+} // getRHSRange
@@ -31,13 +31,8 @@ void SGSimulator::initialize()
   transitionTableSS.str(""); // Reset the string
   
   // First find the iteration that starts the last revolution.
-  startOfLastRev = soln.getIterations().end();
-  startOfLastRev--;
-  while (startOfLastRev->getRevolution() == soln.getIterations().back().getRevolution()
-	 && startOfLastRev != soln.getIterations().begin())
-    startOfLastRev--;
-  if (startOfLastRev != soln.getIterations().begin())
-    startOfLastRev++;
+  startOfLastRev
+    = soln.findRevolution(soln.getIterations().back().getRevolution());
 
   int itersInLastRev = soln.getIterations().back().getIteration()
     - startOfLastRev->getIteration()+1;
@@ -245,17 +240,23 @@ void SGSimulator::simulate(int _numSim,
 			   int _numIter, 
 			   int initialState, 
 			   int initialTuple)
+{
+  simulate(_numSim,_numIter,initialState,initialTuple,
+	   1,std::function<bool(int)>());
+} // simulate
+
+bool SGSimulator::simulate(int _numSim,
+			   int _numIter,
+			   int initialState,
+			   int initialTuple,
+			   int numThreads,
+			   const std::function<bool(int)> & progress,
+			   int progressMilliseconds)
 {
   numSim = _numSim;
   numIter = _numIter;
   const int numStates = soln.getGame().getNumStates();
   const vector<int> & numActions_total = soln.getGame().getNumActions_total();
-  const SGGame & game = soln.getGame();
-
-  // Random number generator
-  unsigned seed (std::chrono::system_clock::now().time_since_epoch().count());
-  std::default_random_engine generator(seed);
-  std::uniform_real_distribution<double> distribution(0.0,1.0);
 
   // Reinitialize distribution containers
   stateDistr = vector<int>(numStates,0);
@@ -265,85 +266,215 @@ void SGSimulator::simulate(int _numSim,
   for (int state = 0; state < numStates; state++)
     actionDistr[state] = vector<int>(numActions_total[state],0);
 
-
   if (logFlag)
     ss.str(""); // clear the stringstream
 
   assert(initialTuple >= startOfLastRev->getIteration());
   assert(initialTuple <= soln.getIterations().back().getIteration());
     
-  list<SGIteration>::const_iterator initialTupleIt = soln.getIterations().end();
-
-  initialTupleIt--;
-  while (initialTupleIt->getIteration() != initialTuple)
-    initialTupleIt--;
+  list<SGIteration>::const_iterator initialTupleIt
+    = soln.findIteration(initialTuple);
+  assert(initialTupleIt->getIteration() == initialTuple);
 
   assert(initialTupleIt->getIteration() >= startOfLastRev->getIteration());
-      
-  // Main simulation loop
-  for (int sim = 0; sim < numSim; sim++)
-    {
-      int currentState = initialState;
-      list<SGIteration>::const_iterator currentTuple = initialTupleIt;
-      int currentAction = currentTuple->getActionTuple()[currentState];
 
-      for (int iter = 0; iter < numIter; iter++)
-	{
-	  if (logFlag && sim == 0 && iter<200)
-	    ss << "Simulation: " << sim
-	       << ", Period: " << iter
-	       << ", state: " << currentState
-	       << ", action: " << currentAction
-	       << ", tuple: " << currentTuple->getIteration()
-	       << endl;
-	  
+  numThreads = numWorkerThreads(numThreads,numSim);
 
-	  // Increment state/action counters
-	  stateDistr[currentState]++;
-	  actionDistr[currentState][currentTuple->getActionTuple()[currentState]]++;
-	  tupleDistr[currentTuple->getIteration()-startOfLastRev->getIteration()]++;
-	
-	  // Find new tuple/state/action
-	  double probSum = 0;
-	  double tupleDraw = distribution(generator);
-	  list<transitionPair>::const_iterator pairIter
-	    = transitionTable[currentTuple->getIteration()
-			      - startOfLastRev->getIteration()]
-	    [currentState].begin();
-	  list<SGIteration>::const_iterator newTuple;
-	  while (pairIter
-		 != transitionTable[currentTuple->getIteration()
-				    - startOfLastRev->getIteration()][currentState].end())
+  // Threads take the next simulation, count into their own
+  // distributions, and add them to the shared ones at most once per
+  // progress interval.
+  unsigned seed (std::chrono::system_clock::now().time_since_epoch().count());
+  std::atomic<bool> canceled(false);
+  std::mutex distrMutex;
+  std::condition_variable merged;
+  int numDone = 0;
+  bool running = true;
+
+  vector<std::default_random_engine> generators;
+  for (int thread = 0; thread < numThreads; thread++)
+    generators.push_back(std::default_random_engine(seed+thread));
+  vector< vector<int> > localStateDistr(numThreads,stateDistr),
+    localTupleDistr(numThreads,tupleDistr);
+  vector< vector< vector<int> > > localActionDistr(numThreads,actionDistr);
+  vector<int> localDone(numThreads,0);
+  vector<std::chrono::steady_clock::time_point>
+    lastMerge(numThreads,std::chrono::steady_clock::now());
+
+  auto merge = [&](int thread)
+    {
+      std::lock_guard<std::mutex> lock(distrMutex);
+      for (int state = 0; state < numStates; state++)
+	{
+	  stateDistr[state] += localStateDistr[thread][state];
+	  localStateDistr[thread][state] = 0;
+	  for (int action = 0; action < numActions_total[state]; action++)
 	    {
-	      probSum += pairIter->second;
-	      newTuple = pairIter->first;
-	      if (tupleDraw <= probSum)
-		break;
-	      ++pairIter;
+	      actionDistr[state][action] += localActionDistr[thread][state][action];
+	      localActionDistr[thread][state][action] = 0;
 	    }
+	}
+      for (int tuple = 0; tuple < tupleDistr.size(); tuple++)
+	{
+	  tupleDistr[tuple] += localTupleDistr[thread][tuple];
+	  localTupleDistr[thread][tuple] = 0;
+	}
+      numDone += localDone[thread];
+      localDone[thread] = 0;
+      lastMerge[thread] = std::chrono::steady_clock::now();
+    };
+
+  auto simulateAll = [&]()
+    {
+      parallelFor(numSim,numThreads,[&](int sim, int thread)
+		  {
+		    if (canceled)
+		      return;
+		    try
+		      {
+			simulateOne(sim,initialState,initialTupleIt,
+				    generators[thread],localStateDistr[thread],
+				    localTupleDistr[thread],
+				    localActionDistr[thread],canceled);
+		      }
+		    catch (...)
+		      {
+			canceled = true;
+			throw;
+		      }
+		    localDone[thread]++;
+		    if (std::chrono::steady_clock::now() - lastMerge[thread]
+			>= std::chrono::milliseconds(progressMilliseconds))
+		      {
+			merge(thread);
+			merged.notify_one();
+		      }
+		  });
+      for (int thread = 0; thread < numThreads; thread++)
+	merge(thread);
+    };
+
+  if (!progress)
+    simulateAll();
+  else
+    {
+      // The simulations run on threads of their own, so that the
+      // calling thread is free to report progress.
+      auto finished = [&]()
+	{
+	  std::lock_guard<std::mutex> lock(distrMutex);
+	  running = false;
+	  merged.notify_one();
+	};
+      runThreads(2,[&](int thread)
+		 {
+		   if (thread == 1)
+		     {
+		       try
+			 {
+			   simulateAll();
+			 }
+		       catch (...)
+			 {
+			   finished();
+			   throw;
+			 }
+		       finished();
+		       return;
+		     }
+
+		   // Report progress while holding the lock, so the
+		   // callback sees consistent distributions.
+		   std::unique_lock<std::mutex> lock(distrMutex);
+		   while (running)
+		     {
+		       merged.wait_for(lock,
+				       std::chrono::milliseconds(progressMilliseconds));
+		       if (!canceled && !progress(numDone))
+			 canceled = true;
+		     }
+		 });
+    }
+
+  if (progress)
+    progress(numDone);
+  return numDone == numSim;
+} // simulate
 
-	  // If we have exceeded number of iterations, wrap around to
-	  // start of last revolution.
-	  if (newTuple == soln.getIterations().end())
-	    newTuple = startOfLastRev;
+void SGSimulator::simulateOne(int sim,
+			      int initialState,
+			      list<SGIteration>::const_iterator initialTupleIt,
+			      std::default_random_engine & generator,
+			      vector<int> & stateCounts,
+			      vector<int> & tupleCounts,
+			      vector< vector<int> > & actionCounts,
+			      const std::atomic<bool> & canceled)
+{
+  const int numStates = soln.getGame().getNumStates();
+  std::uniform_real_distribution<double> distribution(0.0,1.0);
 
-	  // Find the new state
-	  probSum = 0;
-	  double stateDraw = distribution(generator);
-	  int newState=0;
-	  while (newState < numStates-1)
-	    {
-	      probSum += soln.getGame().getProbabilities()[currentState]
-		[currentAction][newState];
-	      if (stateDraw < probSum)
-		break;
-	      newState++;
-	    }
+  int currentState = initialState;
+  list<SGIteration>::const_iterator currentTuple = initialTupleIt;
+  int currentAction = currentTuple->getActionTuple()[currentState];
 
-	  // Update state variables
-	  currentTuple = newTuple;
-	  currentState = newState;
-	  currentAction = currentTuple->getActionTuple()[currentState];
-	} // iter
-    } // sim
-} // simulate
+  for (int iter = 0; iter < numIter; iter++)
+    {
+      // Long simulations check for cancellation as they go.
+      if (iter % 4096 == 0 && iter > 0 && canceled)
+	break;
+
+      // Only one thread runs simulation 0, so it can write to ss.
+      if (logFlag && sim == 0 && iter<200)
+	ss << "Simulation: " << sim
+	   << ", Period: " << iter
+	   << ", state: " << currentState
+	   << ", action: " << currentAction
+	   << ", tuple: " << currentTuple->getIteration()
+	   << endl;
+	  
+
+      // Increment state/action counters
+      stateCounts[currentState]++;
+      actionCounts[currentState][currentTuple->getActionTuple()[currentState]]++;
+      tupleCounts[currentTuple->getIteration()-startOfLastRev->getIteration()]++;
+	
+      // Find new tuple/state/action
+      double probSum = 0;
+      double tupleDraw = distribution(generator);
+      const list<transitionPair> & transitions
+	= transitionTable[currentTuple->getIteration()
+			  - startOfLastRev->getIteration()][currentState];
+      list<transitionPair>::const_iterator pairIter = transitions.begin();
+      list<SGIteration>::const_iterator newTuple;
+      while (pairIter != transitions.end())
+	{
+	  probSum += pairIter->second;
+	  newTuple = pairIter->first;
+	  if (tupleDraw <= probSum)
+	    break;
+	  ++pairIter;
+	}
+
+      // If we have exceeded number of iterations, wrap around to
+      // start of last revolution.
+      if (newTuple == soln.getIterations().end())
+	newTuple = startOfLastRev;
+
+      // Find the new state
+      probSum = 0;
+      double stateDraw = distribution(generator);
+      int newState=0;
+      while (newState < numStates-1)
+	{
+	  probSum += soln.getGame().getProbabilities()[currentState]
+	    [currentAction][newState];
+	  if (stateDraw < probSum)
+	    break;
+	  newState++;
+	}
+
+      // Update state variables
+      currentTuple = newTuple;
+      currentState = newState;
+      currentAction = currentTuple->getActionTuple()[currentState];
+    } // iter
+} // simulateOne
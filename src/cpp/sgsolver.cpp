@@ -25,10 +25,23 @@ SGSolver::SGSolver(const SGEnv & _env,
 		   const SGGame & _game):
   env(_env),
   game(_game),
-  soln(_game)
+  soln(_game),
+  numIterations(0), numRevolutions(0), errorLevel(1)
+{}
+
+SGSolver::SGSolver(const SGEnv & _env,
+		   const SGGameAccessor & _game):
+  env(_env),
+  game(_game),
+  numIterations(0), numRevolutions(0), errorLevel(1)
 {}
 
 void SGSolver::solve()
+{
+  solve(std::function<bool(const SGApprox &)>());
+} // solve
+
+bool SGSolver::solve(const std::function<bool(const SGApprox &)> & progress)
 {
 
   SGApprox approx (env,game,soln);
@@ -38,20 +51,39 @@ void SGSolver::solve()
   bool storeIterations = false;
   if (env.getParam(SG::STOREITERATIONS) == 2)
     storeIterations = true;
-  
-  while (approx.generate(storeIterations) > env.getParam(SG::ERRORTOL)
-	 && approx.getNumIterations() < env.getParam(SG::MAXITERATIONS))
-    {};
 
-  if (env.getParam(SG::STOREITERATIONS) == 1)
+  bool stopped = false, noDirection = false;
+  try
     {
-      int lastRev = approx.getNumRevolutions();
-      while (approx.getNumRevolutions() == lastRev
-	     && approx.getNumIterations() < env.getParam(SG::MAXITERATIONS))
+      do
+	{
+	  errorLevel = approx.generate(storeIterations);
+	  if (progress && approx.passedNorth() && !progress(approx))
+	    {
+	      stopped = true;
+	      break;
+	    }
+	} while (errorLevel > env.getParam(SG::ERRORTOL)
+		 && approx.getNumIterations() < env.getParam(SG::MAXITERATIONS));
+
+      if (!stopped && env.getParam(SG::STOREITERATIONS) == 1)
 	{
-	  approx.generate(true);
+	  int lastRev = approx.getNumRevolutions();
+	  while (approx.getNumRevolutions() == lastRev
+		 && approx.getNumIterations() < env.getParam(SG::MAXITERATIONS))
+	    {
+	      approx.generate(true);
+	    }
 	}
     }
+  catch (SGException & e)
+    {
+      // The algorithm cannot continue, but the tuples so far are
+      // still kept, and the exception is passed on below.
+      if (e.getType() != SG::NO_ADMISSIBLE_DIRECTION)
+	throw;
+      noDirection = true;
+    }
 
   // Add the extreme tuples array to soln.
   for (vector<SGTuple>::const_iterator tuple
@@ -60,6 +92,13 @@ void SGSolver::solve()
        ++tuple)
     soln.push_back(*tuple);
 
+  numIterations = approx.getNumIterations();
+  numRevolutions = approx.getNumRevolutions();
+
   approx.end();
 
+  if (noDirection)
+    throw(SGException(SG::NO_ADMISSIBLE_DIRECTION));
+
+  return !stopped;
 } // solve
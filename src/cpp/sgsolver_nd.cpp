@@ -0,0 +1,409 @@
+// This file is part of the SGSolve library for stochastic games
+// Copyright (C) 2016 Benjamin A. Brooks
+// 
+// SGSolve free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// SGSolve is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see
+// <http://www.gnu.org/licenses/>.
+// 
+// Benjamin A. Brooks
+// ben@benjaminbrooks.net
+// Chicago, IL
+
+
+#include "sgsolver_nd.hpp"
+
+SGSolverND::SGSolverND(const SGEnv & _env,
+		       const vector<int> & _numActions,
+		       const vector< vector<double> > & _payoffs,
+		       double _delta,
+		       int _numThreads):
+  env(_env), numActions(_numActions), delta(_delta),
+  numThreads(_numThreads), numIterations(0), numGenerated(0), volume(0),
+  volumeChange(0), degenerate(false)
+{
+  setPayoffs(_payoffs);
+
+  int product = 1;
+  for (int p = 0; p < numActions.size(); p++)
+    {
+      if (numActions[p] < 1)
+	throw(SGException(SG::INCONSISTENT_INPUTS));
+      product *= numActions[p];
+    }
+  if (numActions.size() != numPlayers || product != numActions_total)
+    throw(SGException(SG::INCONSISTENT_INPUTS));
+
+  computeGains();
+} // constructor
+
+SGSolverND::SGSolverND(const SGEnv & _env,
+		       const vector< vector<double> > & _payoffs,
+		       const vector< vector<double> > & _gains,
+		       double _delta,
+		       int _numThreads):
+  env(_env), delta(_delta),
+  numThreads(_numThreads), numIterations(0), numGenerated(0), volume(0),
+  volumeChange(0), degenerate(false)
+{
+  setPayoffs(_payoffs);
+  numActions.assign(numPlayers,0);
+
+  if (_gains.size() != numActions_total)
+    throw(SGException(SG::INCONSISTENT_INPUTS));
+  gains.resize(numActions_total*numPlayers);
+  for (int a = 0; a < numActions_total; a++)
+    {
+      if (_gains[a].size() != numPlayers)
+	throw(SGException(SG::INCONSISTENT_INPUTS));
+      std::copy(_gains[a].begin(),_gains[a].end(),
+		gains.begin()+a*numPlayers);
+    }
+} // constructor
+
+void SGSolverND::setPayoffs(const vector< vector<double> > & _payoffs)
+{
+  if (delta <= 0 || delta >= 1)
+    throw(SGException(SG::BAD_PARAM_VALUE));
+
+  numActions_total = _payoffs.size();
+  if (numActions_total == 0)
+    throw(SGException(SG::INCONSISTENT_INPUTS));
+  numPlayers = _payoffs[0].size();
+  if (numPlayers != 3)
+    throw(SGException(SG::INCONSISTENT_INPUTS));
+
+  payoffs.resize(numActions_total*numPlayers);
+  for (int a = 0; a < numActions_total; a++)
+    {
+      if (_payoffs[a].size() != numPlayers)
+	throw(SGException(SG::INCONSISTENT_INPUTS));
+      std::copy(_payoffs[a].begin(),_payoffs[a].end(),
+		payoffs.begin()+a*numPlayers);
+    }
+} // setPayoffs
+
+void SGSolverND::computeGains()
+{
+  gains.assign(numActions_total*numPlayers,0.0);
+
+  for (int a = 0; a < numActions_total; a++)
+    {
+      int remainder = a;
+      int scale = 1;
+      for (int p = 0; p < numPlayers; p++)
+	{
+	  int ownAction = remainder % numActions[p];
+	  for (int dev = 0; dev < numActions[p]; dev++)
+	    {
+	      if (dev == ownAction)
+		continue;
+	      int devAction = a+(dev-ownAction)*scale;
+	      gains[a*numPlayers+p]
+		= std::max(gains[a*numPlayers+p],
+			   payoffs[devAction*numPlayers+p]
+			   - payoffs[a*numPlayers+p]);
+	    } // for deviation
+
+	  scale *= numActions[p];
+	  remainder /= numActions[p];
+	} // for player
+    } // for action
+} // computeGains
+
+void SGSolverND::initialize()
+{
+  numIterations = 0;
+  numGenerated = 0;
+  degenerate = false;
+  volumeChange = 0;
+
+  payoffLB.assign(numPlayers,numeric_limits<double>::max());
+  payoffUB.assign(numPlayers,-numeric_limits<double>::max());
+  for (int a = 0; a < numActions_total; a++)
+    {
+      for (int p = 0; p < numPlayers; p++)
+	{
+	  payoffLB[p] = std::min(payoffLB[p],payoffs[a*numPlayers+p]);
+	  payoffUB[p] = std::max(payoffUB[p],payoffs[a*numPlayers+p]);
+	}
+    }
+  threats = payoffLB;
+
+  available.assign(numActions_total,1);
+  numAvailableActions = numActions_total;
+  actionPoints.resize(numActions_total);
+  actionConstrs.resize(numActions_total);
+
+  // Start from the convex hull of the stage payoffs.
+  points = payoffs;
+  pointActions.resize(numActions_total);
+  pointConstrs.assign(numActions_total,numPlayers);
+  for (int a = 0; a < numActions_total; a++)
+    pointActions[a] = a;
+
+  if (!hull.build(points.data(),numActions_total))
+    {
+      degenerate = true;
+      hyperplanes.clear();
+      extPntIndex.clear();
+      volume = 0;
+      return;
+    }
+  hull.getFacets(hyperplanes);
+  hull.getVertices(extPntIndex);
+  volume = hull.volume();
+} // initialize
+
+int SGSolverND::solve()
+{
+  initialize();
+
+  while (!degenerate && !collapsed()
+	 && numIterations < env.getParam(SG::MAXITERATIONS))
+    {
+      double change = iterate();
+
+      if (env.getParam(SG::PRINTTOCOUT))
+	cout << "Iteration: " << numIterations
+	     << ", volume change: " << setprecision(3) << change
+	     << ", vertices: " << extPntIndex.size()
+	     << ", payoffs: " << pointActions.size()
+	     << ", actions: " << numAvailableActions << endl;
+
+      if (change < env.getParam(SG::ERRORTOL))
+	break;
+    }
+
+  return numIterations;
+} // solve
+
+double SGSolverND::iterate()
+{
+  int threads = numWorkerThreads(numThreads,numActions_total);
+
+  if (workspaces.size() < threads)
+    {
+      Workspace workspace;
+      workspace.minCV.resize(numPlayers);
+      workspace.point.resize(numPlayers);
+      workspaces.resize(threads,workspace);
+    }
+
+  // Profiles take different amounts of time, depending on how many
+  // constraints bind, so threads take the next profile rather than
+  // a fixed block.
+  parallelFor(numActions_total,threads,[&](int a, int thread)
+	      {
+		if (available[a])
+		  generate(a,workspaces[thread],
+			   actionPoints[a],actionConstrs[a]);
+	      });
+
+  // Concatenate the payoffs in order of the profiles.
+  vector<double> newThreats(numPlayers,numeric_limits<double>::max());
+  points.clear();
+  pointActions.clear();
+  pointConstrs.clear();
+  for (int a = 0; a < numActions_total; a++)
+    {
+      if (!available[a])
+	continue;
+      if (actionConstrs[a].empty())
+	{
+	  available[a] = 0;
+	  numAvailableActions--;
+	  continue;
+	}
+
+      for (int k = 0; k < actionConstrs[a].size(); k++)
+	{
+	  const double * point = &actionPoints[a][k*numPlayers];
+	  for (int p = 0; p < numPlayers; p++)
+	    newThreats[p] = std::min(newThreats[p],point[p]);
+
+	  pointActions.push_back(a);
+	  pointConstrs.push_back(actionConstrs[a][k]);
+	}
+      points.insert(points.end(),
+		    actionPoints[a].begin(),actionPoints[a].end());
+    } // a
+
+  numIterations++;
+  numGenerated += pointActions.size();
+
+  if (collapsed())
+    {
+      hyperplanes.clear();
+      extPntIndex.clear();
+      volumeChange = volume;
+      volume = 0;
+      return volumeChange;
+    }
+
+  if (!hull.build(points.data(),pointActions.size()))
+    {
+      degenerate = true;
+      hyperplanes.clear();
+      extPntIndex.clear();
+      volumeChange = volume;
+      volume = 0;
+      return volumeChange;
+    }
+  hull.getFacets(hyperplanes);
+  hull.getVertices(extPntIndex);
+
+  double newVolume = hull.volume();
+  volumeChange = abs(volume-newVolume);
+  volume = newVolume;
+
+  for (int p = 0; p < numPlayers; p++)
+    threats[p] = std::max(threats[p],newThreats[p]);
+
+  return volumeChange;
+} // iterate
+
+void SGSolverND::generate(int a, Workspace & workspace,
+			  vector<double> & newPoints,
+			  vector<int> & newConstrs) const
+{
+  newPoints.clear();
+  newConstrs.clear();
+
+  const double * payoff = &payoffs[a*numPlayers];
+  vector<double> & minCV = workspace.minCV;
+  vector<double> & point = workspace.point;
+  vector<double> & polygon = workspace.polygon;
+  bool isIC = true;
+  for (int p = 0; p < numPlayers; p++)
+    {
+      minCV[p] = threats[p] + (1.0-delta)/delta*gains[a*numPlayers+p];
+      isIC = isIC && payoff[p] >= minCV[p];
+    }
+
+  // If the stage payoff is incentive compatible as a continuation
+  // value, it generates itself.
+  if (isIC)
+    {
+      newPoints.insert(newPoints.end(),payoff,payoff+numPlayers);
+      newConstrs.push_back(numPlayers);
+      return;
+    }
+
+  int numFacets = hyperplanes.size()/(numPlayers+1);
+  for (int p = 0; p < numPlayers; p++)
+    {
+      if (payoff[p] >= minCV[p])
+	continue;
+
+      // Slice the polytope where player p's constraint binds. The
+      // other players' constraints are lower bounds on the box that
+      // is clipped.
+      int p1 = (p+1)%numPlayers, p2 = (p+2)%numPlayers;
+      double lo1 = std::max(payoffLB[p1],minCV[p1]),
+	lo2 = std::max(payoffLB[p2],minCV[p2]);
+      if (lo1 > payoffUB[p1] || lo2 > payoffUB[p2])
+	continue;
+
+      polygon.clear();
+      polygon.push_back(lo1); polygon.push_back(lo2);
+      polygon.push_back(payoffUB[p1]); polygon.push_back(lo2);
+      polygon.push_back(payoffUB[p1]); polygon.push_back(payoffUB[p2]);
+      polygon.push_back(lo1); polygon.push_back(payoffUB[p2]);
+
+      for (int f = 0; f < numFacets && !polygon.empty(); f++)
+	{
+	  const double * facet = &hyperplanes[f*(numPlayers+1)];
+	  clipPolygon(polygon,facet[p1],facet[p2],
+		      facet[numPlayers]-facet[p]*minCV[p],
+		      workspace.clipped);
+	}
+
+      point[p] = minCV[p];
+      for (int v = 0; v < polygon.size(); v += 2)
+	{
+	  point[p1] = polygon[v];
+	  point[p2] = polygon[v+1];
+	  for (int pp = 0; pp < numPlayers; pp++)
+	    newPoints.push_back((1-delta)*payoff[pp]+delta*point[pp]);
+	  newConstrs.push_back(p);
+	}
+    } // p
+} // generate
+
+void SGSolverND::clipPolygon(vector<double> & polygon,
+			     double normal0, double normal1, double level,
+			     vector<double> & workspace)
+{
+  double tol = 1e-12*(1+abs(level));
+  int numVertices = polygon.size()/2;
+  workspace.clear();
+  for (int v = 0; v < numVertices; v++)
+    {
+      int w = (v+1)%numVertices;
+      double px = polygon[2*v], py = polygon[2*v+1];
+      double qx = polygon[2*w], qy = polygon[2*w+1];
+      double lp = normal0*px+normal1*py-level,
+	lq = normal0*qx+normal1*qy-level;
+      if (lp <= tol)
+	{
+	  workspace.push_back(px);
+	  workspace.push_back(py);
+	}
+      if ( (lp < -tol && lq > tol) || (lp > tol && lq < -tol) )
+	{
+	  double t = lp/(lp-lq);
+	  workspace.push_back(px+t*(qx-px));
+	  workspace.push_back(py+t*(qy-py));
+	}
+    } // for v
+  polygon.swap(workspace);
+} // clipPolygon
+
+void SGSolverND::save(ofstream & ofs) const
+{
+  ofs << setprecision(15) << numActions_total << " "
+      << delta << " " << extPntIndex.size() << " "
+      << 0 << " " << 0 << endl;
+
+  for (int p = 0; p < numPlayers; p++)
+    ofs << numActions[p] << " ";
+  ofs << 0 << " " << 0 << endl;
+
+  // Payoffs and gains from deviating
+  for (int a = 0; a < numActions_total; a++)
+    {
+      for (int p = 0; p < numPlayers; p++)
+	ofs << payoffs[a*numPlayers+p] << " ";
+      ofs << 0 << " " << 0 << endl;
+    }
+  for (int a = 0; a < numActions_total; a++)
+    {
+      for (int p = 0; p < numPlayers; p++)
+	ofs << gains[a*numPlayers+p] << " ";
+      ofs << 0 << " " << 0 << endl;
+    }
+
+  for (int k = 0; k < extPntIndex.size(); k++)
+    {
+      for (int p = 0; p < numPlayers; p++)
+	ofs << points[extPntIndex[k]*numPlayers+p] << " ";
+      ofs << extPntIndex[k] << " " << 0 << endl;
+    }
+
+  for (int k = 0; k < pointActions.size(); k++)
+    {
+      for (int p = 0; p < numPlayers; p++)
+	ofs << points[k*numPlayers+p] << " ";
+      ofs << pointActions[k] << " " << pointConstrs[k] << endl;
+    }
+} // save
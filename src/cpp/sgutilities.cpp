@@ -60,3 +60,92 @@ int vectorToIndex(const vector<int> & v,
     }
   return index;
 }
+
+int numWorkerThreads(int numThreads, int numTasks)
+{
+  if (numThreads <= 0)
+    numThreads = std::thread::hardware_concurrency();
+  return std::max(1,std::min(numThreads,numTasks));
+} // numWorkerThreads
+
+string quoteJSON(const string & str)
+{
+  string quoted = "\"";
+  for (int k = 0; k < str.size(); k++)
+    {
+      switch (str[k])
+	{
+	case '"':
+	  quoted += "\\\"";
+	  break;
+	case '\\':
+	  quoted += "\\\\";
+	  break;
+	case '\n':
+	  quoted += "\\n";
+	  break;
+	case '\r':
+	  quoted += "\\r";
+	  break;
+	case '\t':
+	  quoted += "\\t";
+	  break;
+	default:
+	  if (static_cast<unsigned char>(str[k]) < 0x20)
+	    {
+	      char escaped[8];
+	      snprintf(escaped,sizeof(escaped),"\\u%04x",
+		       static_cast<unsigned char>(str[k]));
+	      quoted += escaped;
+	    }
+	  else
+	    quoted += str[k];
+	}
+    }
+  return quoted + "\"";
+} // quoteJSON
+
+string quoteCSV(const string & str)
+{
+  string quoted = "\"";
+  for (int k = 0; k < str.size(); k++)
+    {
+      if (str[k] == '"')
+	quoted += '"';
+      quoted += str[k];
+    }
+  return quoted + "\"";
+} // quoteCSV
+
+SGProgressStreambuf::SGProgressStreambuf(std::streambuf * _source,
+					 std::streamsize _total,
+					 const std::function<void(double)> & _progress):
+  source(_source), total(_total), consumed(0), lastPercent(-1),
+  progress(_progress), buffer(1<<16)
+{
+  setg(buffer.data(),buffer.data(),buffer.data());
+}
+
+SGProgressStreambuf::int_type SGProgressStreambuf::underflow()
+{
+  if (gptr() < egptr())
+    return traits_type::to_int_type(*gptr());
+
+  std::streamsize numRead = source->sgetn(buffer.data(),buffer.size());
+  if (numRead <= 0)
+    return traits_type::eof();
+  setg(buffer.data(),buffer.data(),buffer.data()+numRead);
+
+  consumed += numRead;
+  if (progress && total > 0)
+    {
+      int percent = std::min<std::streamsize>(100,(100*consumed)/total);
+      if (percent > lastPercent)
+	{
+	  lastPercent = percent;
+	  progress(static_cast<double>(consumed)/total);
+	}
+    }
+
+  return traits_type::to_int_type(*gptr());
+} // underflow
@@ -137,6 +137,16 @@ public:
     return probHelper(e,t,ep)/stateProbSum[e][a];
   } // probability
 
+  virtual void probabilities(int e, const vector<int> & actions,
+			     double * out) const
+  {
+    int t = actions[1]-actions[0];
+    int a = actions[0]+actions[1]*numActions[e][0];
+    for (int ep = 0; ep < numStates; ep++)
+      out[ep] = probHelper(e,t,ep)/stateProbSum[e][a];
+  } // probabilities
+  using SGAbstractGame::probabilities;
+
   virtual bool isEquilibriumAction(int state, const vector<int> & actions) const
   {
     // Return true iff one of the players' actions is zero.
@@ -84,6 +84,23 @@ public:
       tomorrow when starting from the given state and when the given
       action pair is played. */
   virtual double probability(int state,const vector<int> &actions,int statep) const = 0;
+  //! Transition probabilities for all new states at once
+  /*! Writes the probability of reaching each new state tomorrow,
+      when starting from the given state and when the given action
+      pair is played, into out[0],...,out[numStates-1]. The default
+      definition calls the probability method once for each new
+      state. A derived class can redefine this method when an entire
+      row of transition probabilities is cheaper to compute in one
+      pass, e.g., when a normalizing constant is shared across
+      states. SGGame::SGGame may call this method and the payoffs
+      method from several threads at once, so neither should modify
+      the object. */
+  virtual void probabilities(int state,const vector<int> & actions,
+			     double * out) const
+  {
+    for (int statep = 0; statep < numStates; statep++)
+      out[statep] = probability(state,actions,statep);
+  }
   //! Returns true if the given action pair can be played in
   //! equilibrium
   /*! The default definition of this method always returns true, so that all
@@ -115,6 +132,12 @@ public:
       method. */
   double probability(int state,int action,int statep) const
   { return probability(state,indexToActions(action,state),statep); }
+  //! An overloaded version of probabilities that uses a linear
+  //! action index
+  /*! This method converts the linear action index into an action pair
+      and then returns the result of the probabilities method. */
+  void probabilities(int state,int action,double * out) const
+  { probabilities(state,indexToActions(action,state),out); }
   //! An overloaded version of isEquilibriumAction that uses a linear
   //! action index
   /*! This method converts the linear action index into an action pair
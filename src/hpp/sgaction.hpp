@@ -29,6 +29,7 @@
 #include "sggame.hpp"
 #include "sgbaseaction.hpp"
 #include "sghyperplane.hpp"
+#include "sgangularindex.hpp"
 
 //! Enhanced version of SGBaseAction
 /*! Same functionality as SGBaseAction, but includes additional
@@ -117,7 +118,7 @@ public:
 	    double level);
 
   //! Calculates the minimum incentive compatible continuation payoff
-  void calculateMinIC(const SGGame & game,
+  void calculateMinIC(const SGGameAccessor & game,
 		      const vector<bool> & update,
 		      const SGTuple & threatTuple);
 
@@ -133,12 +134,28 @@ public:
   }
 
   //! Calculates binding continuation values from hyperplane constraints
-  void calculateBindingContinuations(const SGGame & game,
-				     const vector<SGHyperplane> & W);
+  /*! Used by SGApprox_V2. The expected feasible set is the
+      intersection of the half spaces normals[k]*x<=expLevels[k],
+      where expLevels are the levels of the hyperplanes averaged
+      using this action's transition probabilities. Each player's
+      binding segment is the part of that player's incentive
+      constraint that lies in the expected feasible set and satisfies
+      the other player's incentive constraint. Entries of
+      SGBaseAction::tuples are set to -1. */
+  void calculateBindingContinuations(const SGGameAccessor & game,
+				     const vector<SGPoint> & normals,
+				     const double * expLevels);
   
+  //! Calculates binding continuation values from the trajectory
+  /*! Finds the points where the expected trajectory of the pivot
+      crosses each player's minimum IC continuation value, walking
+      back from the last extreme tuple to oldWest. The walk is done
+      one monotone piece of angularIndex at a time, and within each
+      piece the crossings are located by bisection. */
   void calculateBindingContinuations(const vector<bool> & updatedThreatTuple,
-				     const SGGame & game,
+				     const SGGameAccessor & game,
 				     const vector<SGTuple> & extremeTuples,
+				     const SGAngularIndex & angularIndex,
 				     const SGTuple & threatTuple,
 				     const SGTuple & pivot,
 				     const SGPoint & currentDirection,
@@ -147,9 +164,9 @@ public:
   //! Calculates the IC constraint.
   /*! Calculates the minimum incentive compatible expected
       continuation value for the given action, relative to the given
-      threat tuple and for the given SGGame. */
+      threat tuple and for the given game. */
   static double calculateMinIC(int action,int state, int player,
-			       const SGGame & game,
+			       const SGGameAccessor & game,
 			       const SGTuple & threatTuple);
 
   
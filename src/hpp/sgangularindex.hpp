@@ -0,0 +1,104 @@
+// This file is part of the SGSolve library for stochastic games
+// Copyright (C) 2016 Benjamin A. Brooks
+// 
+// SGSolve free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// SGSolve is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see
+// <http://www.gnu.org/licenses/>.
+// 
+// Benjamin A. Brooks
+// ben@benjaminbrooks.net
+// Chicago, IL
+
+#ifndef _SGANGULARINDEX_HPP
+#define _SGANGULARINDEX_HPP
+
+#include "sgcommon.hpp"
+#include "sgpoint.hpp"
+
+//! Index of the directions along the trajectory of the pivot
+/*! Each extreme tuple in SGApprox::extremeTuples is obtained from the
+    previous one by moving the pivot in every state by a nonnegative
+    multiple of a common direction, and that direction rotates
+    clockwise. SGAngularIndex records, for each tuple, the cumulative
+    clockwise angle through which the direction has turned, so that
+    tuples can be looked up by angle with a binary search.
+
+    It also records, for each player, where the direction's
+    coordinate for that player changes sign. Between two such turning
+    points, the player's payoff moves monotonically in every state,
+    and therefore so does its expectation under any transition
+    probabilities. This lets SGAction find where an expected
+    trajectory crosses an IC constraint by bisection rather than by
+    walking the whole trajectory.
+
+  \ingroup src
+ */
+class SGAngularIndex
+{
+private:
+  vector<double> angles; /*!< angles[k] is the cumulative clockwise
+                            angle of the direction in which tuple k
+                            was generated. */
+  vector<SGPoint> directions; /*!< directions[k] is the direction in
+                                 which tuple k was generated. */
+  vector< vector<int> > pieceStarts; /*!< pieceStarts[i][k] is the
+                                        smallest index j such that
+                                        player i's payoffs are
+                                        monotone along tuples j
+                                        through k. */
+  vector< vector<signed char> > pieceSigns; /*!< Direction in which
+                                               player i's payoffs
+                                               move along the piece
+                                               ending at tuple
+                                               k. Zero if they have
+                                               not moved, and 2 if
+                                               the last edge is not
+                                               monotone. */
+
+  //! Clockwise angle from one direction to another
+  static double turn(const SGPoint & from, const SGPoint & to);
+  //! Classifies the edge into the last tuple
+  void classifyBack(const vector<signed char> & edgeSigns);
+  
+public:
+  //! Default constructor
+  SGAngularIndex():
+    pieceStarts(2), pieceSigns(2)
+  {}
+
+  //! Removes all tuples from the index
+  void clear();
+  //! Records a new tuple generated in the given direction
+  /*! The direction of the first tuple is ignored. */
+  void push_back(const SGPoint & direction);
+  //! Records that the last tuple was moved in the given direction
+  /*! Used when SGApprox merges the new pivot into the last extreme
+      tuple instead of appending it. */
+  void mergeBack(const SGPoint & direction);
+
+  //! Returns the number of tuples in the index
+  int size() const { return angles.size(); }
+  //! Returns the cumulative angle of tuple k
+  double getAngle(int k) const { return angles[k]; }
+  //! Returns the first tuple of the monotone piece ending at tuple k
+  /*! Player's payoffs move monotonically in every state along tuples
+      getPieceStart(player,k) through k. */
+  int getPieceStart(int player, int k) const
+  { return pieceStarts[player][k]; }
+  //! Returns the last tuple within the given angle of tuple k
+  /*! Returns the largest index j such that the direction has turned
+      by at most the given angle between tuples k and j. */
+  int findAngle(int k, double angle) const;
+};
+
+#endif
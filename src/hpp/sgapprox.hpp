@@ -26,6 +26,7 @@
 #include "sgutilities.hpp"
 #include "sgenv.hpp"
 #include "sggame.hpp"
+#include "sgangularindex.hpp"
 #include "sgexception.hpp"
 #include "sgsolution.hpp"
 #include "sgnamespace.hpp"
@@ -48,7 +49,7 @@ class SGApprox
 private:
   const SGEnv & env; /*!< Constant reference to the parent
                         environment. */
-  const SGGame & game; /*!< Constant reference to the game being
+  const SGGameAccessor & game; /*!< Constant reference to the game being
                           solved. */
   SGSolution & soln; /*!< Reference to the SGSolution object in which output
                     is being stored. */
@@ -85,6 +86,9 @@ private:
                                        supported according to the
                                        current approximation. */
   vector<SGTuple> extremeTuples; /*!< Past trajectory of the pivot. */
+  SGAngularIndex angularIndex; /*!< Directions in which the tuples in
+                                  SGApprox::extremeTuples were
+                                  generated. */
 
   SGTuple threatTuple; /*!< Current threat tuple. */
 
@@ -117,6 +121,19 @@ private:
   int newWest; /*!< Index within SGApprox::extremeTuples of the
 		 westernmost tuple on the current revolution. */
   int oldWest; /*!< Previous value of westPoint. */
+  int numPrunedActions; /*!< Number of equilibrium actions removed by
+                           SGApprox::pruneActions. */
+
+  //! Removes actions that can never be supported
+  /*! Computes upper and lower bounds on each player's equilibrium
+      payoffs state by state, starting from the bounds in
+      SGGameAccessor::getPayoffBounds. An action is removed from
+      SGApprox::actions if its minimum IC continuation value with
+      respect to the lower bounds exceeds the expected upper bound on
+      continuation values. The bounds are then recomputed over the
+      remaining actions, for at most SG::PRUNEPASSES passes or until
+      nothing changes. */
+  void pruneActions();
 
   //! Calculates the minimum IC continuation values
   /*! This method calculates for each SGAction object in
@@ -204,12 +221,12 @@ private:
 public:
   //! Constructor for SGApprox class
   SGApprox(const SGEnv & _env,
-	   const SGGame & _game,
+	   const SGGameAccessor & _game,
 	   SGSolution & _soln):
     env(_env), game(_game), soln(_soln),
     delta(game.getDelta()), numPlayers(game.getNumPlayers()),
     numStates(game.getNumStates()), errorLevel(1), sufficiencyFlag(true),
-    nullAction(env)
+    numPrunedActions(0), nullAction(env)
   { }
   
   //! Prepares the approximation for generation
@@ -225,6 +242,10 @@ public:
   int getNumIterations() const {return numIterations; }
   //! Returns the number of revolutions of the pivot thus far
   int getNumRevolutions() const {return numRevolutions; }
+  //! Returns the distance between the last two revolutions
+  double getErrorLevel() const {return errorLevel; }
+  //! Returns the number of actions removed before the first iteration
+  int getNumPrunedActions() const {return numPrunedActions; }
   //! Returns the number of tuples in the extremeTuples array
   int getNumExtremeTuples() const {return extremeTuples.size(); }
   //! Returns the regime in which the best test direction was
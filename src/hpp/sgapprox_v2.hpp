@@ -27,19 +27,21 @@
 #include "sgenv.hpp"
 #include "sggame.hpp"
 #include "sgexception.hpp"
-#include "sgsolution.hpp"
+#include "sgsolution_v2.hpp"
 #include "sgnamespace.hpp"
 
 //! Approximation of the equilibrium payoff correspondence.
 /*! This class contains an approximation of the equilibrium payoff
-  correspondence. At its core, it contains a sequence of extreme
-  tuples that have been generated thus far, a pivot, and a
-  direction. The main method, SGApprox_V2::generate(), finds a
-  new direction that will not intersect the equilibrium payoff
-  correspondence and updates the pivot in that direction. By
-  successively calling SGApprox_V2::generate(), the
+  correspondence. Unlike SGApprox, which records the trajectory of
+  the pivot, the approximation is stored as a list of hyperplanes,
+  each of which has a common normal and a level for every state. The
+  main method, SGApprox_V2::generate(), twists the pivot through a
+  complete revolution, using SGApprox_V2::W to compute binding
+  continuation values. Each step of the twist contributes one
+  hyperplane to SGApprox_V2::Wp, which replaces W at the end of the
+  revolution. By successively calling SGApprox_V2::generate(), the
   approximation will be refined and asymptotically it will converge
-  to the equilibrium payoff correspondence. 
+  to the equilibrium payoff correspondence.
   
   \ingroup src
 */
@@ -50,8 +52,8 @@ private:
                         environment. */
   const SGGame & game; /*!< Constant reference to the game being
                           solved. */
-  SGSolution & soln; /*!< Reference to the SGSolution object in which output
-                    is being stored. */
+  SGSolution_V2 & soln; /*!< Reference to the SGSolution_V2 object in
+                           which output is being stored. */
 
   const double delta; /*!< The discount factor, copied from
                          SGApprox_V2::game. */
@@ -61,27 +63,64 @@ private:
 
   std::ofstream logfs; /*!< File stream for log file. */
 
-  int numSteps; /*!< Number of steps within iteration. */
-  int numIterations; /*!< Elapsed number of iterations. */
+  int numSteps; /*!< Elapsed number of steps of the pivot. */
+  int numIterations; /*!< Elapsed number of revolutions. */
   double errorLevel; /*!< Current error level */
+
+  bool facingWest; /*!< True if the pivot has moved west since the
+                      start of the current revolution. The revolution
+                      ends when the direction turns east again. */
+  vector<bool> updatedThreatTuple; /*!< updatedThreatTuple[i] = true
+                                      if player i's threat tuple was
+                                      updated on the last
+                                      revolution. */
+  vector< vector<bool> > updatedThreatStates; /*!< updatedThreatStates[i][s]
+                                                 = true if player i's
+                                                 threat in state s was
+                                                 updated on the last
+                                                 revolution. */
   
   vector< list<SGAction> > actions; /*!< actions[state] is a list of
                                        actions that can still be
                                        supported according to the
                                        current approximation. */
-  vector<SGHyperplane> W; /*!< Feasible set. */
-  vector<SGHyperplane> Wp; /*!< New feasible set. */
+  vector<SGHyperplane> W; /*!< Hyperplanes generated on the last
+                             revolution, which bound the current
+                             approximation. */
+  vector<SGHyperplane> Wp; /*!< Hyperplanes generated so far on the
+                              current revolution. */
+  vector<SGPoint> normals; /*!< Normals of the hyperplanes in
+                               SGApprox_V2::W. */
+  vector<double> levelMatrix; /*!< Levels of the hyperplanes in
+                                 SGApprox_V2::W, stored state by
+                                 state, so that entry
+                                 state*W.size()+k is the level of
+                                 hyperplane k in that state. */
+  vector<double> probMatrix; /*!< Transition probabilities of the
+                                actions in one state, one row of
+                                numStates entries per action. */
+  vector<double> expLevelMatrix; /*!< Expected levels of the
+                                    hyperplanes in SGApprox_V2::W,
+                                    one row of W.size() entries per
+                                    row of probMatrix. */
+  vector< vector<SGTuple> > feasibleSets; /*!< feasibleSets[s][a] are
+                                             the vertices of the
+                                             expected feasible set
+                                             for action a in state s,
+                                             intersected with the
+                                             region where both
+                                             players' incentive
+                                             constraints hold. */
 
   SGPoint payoffUB; /*!< Upper bound on payoffs. */
   SGPoint payoffLB; /*!< Lower bound on payoffs. */
   
   SGTuple threatTuple; /*!< Current threat tuple. */
+  SGTuple minTuple; /*!< Smallest payoffs of each player reached by
+                       the pivot on the current revolution. */
 
   SGTuple pivot; /*!< Current pivot. */
   SGPoint currDir; /*!< The current direction. */
-  SGPoint currNormal; /*!< The current direction. */
-  vector<double> currLevels; /*!< The levels attained by the pivot
-                                   in the current normal direction. */
   vector< const SGAction* > actionTuple; /*!< actionTuple[state] is a
                                             pointer to the SGAction
                                             object that generates
@@ -89,6 +128,14 @@ private:
   vector<SG::Regime> regimeTuple; /*!< regimeTuple[state] gives the
 				    manner in which pivot[state] was
 				    generated. */
+
+  list<SGTuple> pivots; /*!< Trajectory of the pivot on the current
+                           revolution. Only recorded when
+                           SG::STOREITERATIONS is positive. */
+  list< vector<int> > actionTuples; /*!< Action tuples on the current
+                                       revolution. */
+  list< vector<SG::Regime> > regimeTuples; /*!< Regime tuples on the
+                                              current revolution. */
   
   list<SGAction>::const_iterator bestAction; /*!< Pointer to the
 					       action profile that
@@ -96,39 +143,59 @@ private:
 					       shallowest
 					       direction. */
   SGPoint bestDir; /*!< The shallowest direction at the current
-                            iteration. */
-  SGPoint bestNormal; /*!< The normal to the shallwest direction. */
+                      step. */
   SG::Regime bestRegime; /*!< Indicates which incentive
                                       constraints were binding for the
                                       best direction. */
 
   SGAction nullAction;
 
-  std::ofstream testOFS; 
-  
-
   // Methods
 
   //! Calculates the minimum IC continuation values
   /*! This method calculates for each SGAction object in
       SGApprox_V2::actions the minimum incentive compatible
-      continuation value, relative to the current threat tuple. */
+      continuation value, relative to the current threat tuple. Only
+      players whose threats changed are updated, and only for the
+      actions with a deviation that moves with positive probability
+      to a state where the threat changed. These are found with
+      SGGame's reverse transition index. */
   void updateMinPayoffs();
 
   //! Calculates binding continuation values
   /*! For each SGAction objection in SGApprox_V2::actions, this
-      method computes the extreme binding continuation values relative
-      to the current threat tuple and the trajectory of the pivot on
-      the previous revolution. */
+      method computes the extreme binding continuation values and
+      SGApprox_V2::feasibleSets relative to the current threat tuple
+      and the hyperplanes in SGApprox_V2::W. Actions whose feasible
+      sets are empty can no longer be supported and are removed. */
   void calculateBindingContinuations();
 
-  //! Finds an initial pivot, which maximizes player 2's payoff.
-  void findInitialPivot();
-  
+  //! Computes expected levels for a batch of actions
+  /*! Sets out to the numRows by numCols product of prob, a numRows
+      by numStates matrix, and levels, a numStates by numCols
+      matrix. All matrices are stored row by row. The product is
+      taken one block of columns at a time, so that the block of
+      levels stays in cache while every row uses it, and the inner
+      loop runs over contiguous columns so that the compiler can
+      vectorize it. */
+  static void expectLevels(const double * prob, int numRows,
+			   int numStates,
+			   const double * levels, int numCols,
+			   double * out);
+
+  //! Intersects a convex polygon with the half plane normal*x<=level
+  static void clipPolygon(SGTuple & polygon,
+			  const SGPoint & normal, double level);
+
   //! Calculates the best direction
-  /*! Iteraties over the SGAction objects in SGApprox_V2::actions
-      to find the shallowest admissible direction, and stores it in
-      bestDirection. */
+  /*! Iterates over the SGAction objects in SGApprox_V2::actions to
+      find the shallowest admissible direction, and stores it in
+      SGApprox_V2::bestDir. If the expected pivot is incentive
+      compatible, the candidate is the non-binding payoff. Otherwise,
+      the non-binding payoff is still a candidate if the direction
+      towards it passes through the payoffs generated by the action's
+      feasible set, and the payoffs generated by the binding
+      continuation values are candidates. */
   void findBestDir();
 
   //! Calculates the new pivot
@@ -147,28 +214,31 @@ private:
       regime. Returns the distance the pivot moves. */
   double updatePivot(vector<double> & movements, 
 		     vector<double> & changes,
-		     vector<SG::Regime> & regimeTuple);
+		     const vector<double> & maxMovement,
+		     const vector<SG::Regime> & maxMovementConstraints);
 
-  //! Updates flags before the next iteration
-  /*! This method checks whether or not the threat tuple has increased
-      and sets the flags for recalculating binding continuation
-      values. Also checks whether or not the cardinal direction has
-      changed, and updates SGApprox_V2::facingEastNorth and
-      SGApprox_V2::passNorth. */
-  void updateFlags();
+  //! Adds the hyperplane through the pivot to SGApprox_V2::Wp
+  /*! The normal is the current direction rotated counter-clockwise
+      by 90 degrees. If it is parallel to the normal of the last
+      hyperplane, the last hyperplane is replaced. */
+  void addHyperplane();
 
   //! Calculates the distance between revolutions
-  /*! Returns the distance between successive iterations. Only runs
-      when SGApprox_V2::passNorth is true. Currently only runs
-      when the number of SGTuple objects on successive revolutions is
-      the same, and then takes the maximum over all distances between
-      tuples that are in corresponding positions in the
-      revolutions. */
+  /*! Returns the largest distance, in the sense of
+      SGHyperplane::distance, between a hyperplane in SGApprox_V2::W
+      and the closest of the two hyperplanes in SGApprox_V2::Wp whose
+      normals flank it. Both lists are ordered by angle, so the
+      comparison takes O(n log n) time rather than O(n^2). */
   double distance() const;
 
-  double distHelper(const SGPoint & p, 
-		    const SGPoint & qA, 
-		    const SGPoint & qB) const;
+  //! Checks whether the ray from origin meets the generated payoffs
+  /*! Returns true if the ray from origin in the given direction
+      passes through the polygon offset+delta*vertices at a point
+      ahead of origin. */
+  bool rayMeetsPolygon(const SGPoint & origin,
+		       const SGPoint & direction,
+		       const SGPoint & offset,
+		       const SGTuple & vertices) const;
 
   //! Checks whether or not newDir is shallower than best, relative to current
   /*! Returns true if the cosine between newDir and best is
@@ -180,19 +250,16 @@ private:
 		const SGPoint & best, 
 		const SGPoint & newDir) const;
 
-  bool isBelow (const SGPoint & dir,
-		const SGPoint & norm) const;
-
-  //! Outputs progress to the log file every iteration
+  //! Outputs progress to the log file every step
   void logAppend(ofstream & logfs,
-		 int iter, int rev, const SGHyperplane & hp,
+		 int iter, int step, const SGHyperplane & hp,
 		 int state, int action);
 
 public:
   //! Constructor for SGApprox_V2 class
   SGApprox_V2(const SGEnv & _env,
 	      const SGGame & _game,
-	      SGSolution & _soln):
+	      SGSolution_V2 & _soln):
     env(_env), game(_game), soln(_soln),
     delta(game.getDelta()), numPlayers(game.getNumPlayers()),
     numStates(game.getNumStates()), errorLevel(1), 
@@ -200,17 +267,15 @@ public:
   { }
   
   //! Prepares the approximation for generation
-  /*! Opens the log file, constructs the actions array, initializes
-      extremeTuples to a large "box" correspondence that contains the
-      equilibrium payoff correspondence. Also initializes the pivot
-      and the first direction. Sets the flags so that
-      SGApprox_V2::generate() will calculate new binding
-      continuation values on the first pass. */
+  /*! Opens the log file, constructs the actions array, initializes W
+      to a large "box" correspondence that contains the equilibrium
+      payoff correspondence. Also initializes the pivot to the north
+      west corner of the box and the first direction to due east. */
   void initialize();
 
-  //! Returns the number of iterations thus far
+  //! Returns the number of revolutions thus far
   int getNumIterations() const {return numIterations; }
-  //! Returns the number of revolutions of the pivot thus far
+  //! Returns the number of steps of the pivot thus far
   int getNumSteps() const {return numSteps; }
   //! Returns the number of hyperplanes in W
   int getNumHyperplanes() const {return W.size(); }
@@ -235,18 +300,26 @@ public:
   //! Returns the array of SGAction objects that can currently be
   //! supported
   const vector< list<SGAction> > & getActions() const { return actions; }
-  //! Returns the array of extreme tuples
+  //! Returns the hyperplanes generated on the last revolution
   const vector<SGHyperplane> & getW() const {return W; }
+  //! Returns the trajectory of the pivot on the last revolution
+  const list<SGTuple> & getPivots() const { return pivots; }
+  //! Returns the action tuples on the last revolution
+  const list< vector<int> > & getActionTuples() const { return actionTuples; }
+  //! Returns the regime tuples on the last revolution
+  const list< vector<SG::Regime> > & getRegimeTuples() const { return regimeTuples; }
 
   //! Returns a string indicating the algorithms progress
   std::string progressString() const;
 
   //! Refines the approximation
   /*! Main public routine for the SGApprox_V2 class. Updates minimum
-   IC continuation values and binding continuation values, finds the
-   best new direction, advances the pivot, and resets the flags. Also
-   returns the distance between revolutions when a revolution is
-   completed. Otherwise, returns 1. */
+      IC continuation values and binding continuation values, and
+      then advances the pivot until it has turned through a full
+      revolution. The hyperplanes generated along the way replace
+      SGApprox_V2::W. If storeIteration is true, an SGIteration_V2
+      is added to the solution. Returns the distance between
+      revolutions, or 1 for the first two revolutions. */
   double generate(bool storeIteration = true);
 
   //! Destructor
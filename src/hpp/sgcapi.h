@@ -0,0 +1,213 @@
+// This file is part of the SGSolve library for stochastic games
+// Copyright (C) 2016 Benjamin A. Brooks
+// 
+// SGSolve free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// SGSolve is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see
+// <http://www.gnu.org/licenses/>.
+// 
+// Benjamin A. Brooks
+// ben@benjaminbrooks.net
+// Chicago, IL
+
+#ifndef _SGCAPI_H
+#define _SGCAPI_H
+
+/*! \file
+  \brief C interface to the SGSolve library.
+
+  This header only uses C types, so it can be included from C and its
+  functions can be called through the foreign function interfaces of
+  other languages (e.g., ctypes/cffi in Python or ccall in Julia)
+  after linking against libsg.so.
+
+  Games, parameters, solvers, and solutions are passed around as
+  opaque handles, which are created by the sg_*_create and sg_*_load
+  functions and must be released with the matching sg_*_free
+  function. Arrays are passed in and out in bulk through buffers
+  owned by the caller, whose sizes can be computed from the sg_*_num_*
+  functions. All arrays are in row major (C) order:
+
+  - numActions[2*s+i] is player i's number of actions in state s.
+
+  - Action profiles in state s are numbered a = a0 + a1*numActions[2*s],
+    as in SGGame, and the profiles of all states are stacked in order
+    of the state, so profile a of state s is row
+    r = sum_{s'<s} numProfiles(s') + a.
+
+  - payoffs[2*r+i] is player i's payoff for row r.
+
+  - probabilities[numStates*r+s'] is the probability of moving to
+    state s' after row r.
+
+  Functions that return an int return SG_OK on success and SG_ERROR on
+  failure, and functions that return a handle return NULL on
+  failure. In either case, sg_last_error describes the failure. No C++
+  exceptions escape from this interface.
+
+  \ingroup src
+*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+  //! Return codes
+  enum { SG_OK = 0, SG_ERROR = -1 };
+
+  //! Opaque handle for an SGGame.
+  typedef struct sg_game sg_game;
+  //! Opaque handle for an SGEnv.
+  typedef struct sg_env sg_env;
+  //! Opaque handle for a solve in progress.
+  typedef struct sg_solver sg_solver;
+  //! Opaque handle for an SGSolution.
+  typedef struct sg_solution sg_solution;
+
+  //! Progress callback for sg_solver_solve.
+  /*! Called after each revolution with the number of iterations and
+      revolutions so far and the current error level. Returning
+      nonzero stops the solve. */
+  typedef int (*sg_progress_callback)(int numIterations,
+				      int numRevolutions,
+				      double errorLevel,
+				      void * userData);
+
+  //! Describes the last error on the calling thread.
+  const char * sg_last_error(void);
+
+  // Games
+
+  //! Creates a game from arrays in the layout described above.
+  /*! unconstrained may be NULL, otherwise unconstrained[i] is nonzero
+      if player i's incentive constraints are ignored. */
+  sg_game * sg_game_create(double delta, int numStates,
+			   const int * numActions,
+			   const double * payoffs,
+			   const double * probabilities,
+			   const int * unconstrained);
+  //! Loads a game saved with SGGame::save.
+  sg_game * sg_game_load(const char * filename);
+  //! Saves a game.
+  int sg_game_save(const sg_game * game, const char * filename);
+  //! Destroys a game.
+  void sg_game_free(sg_game * game);
+
+  //! Returns the discount factor.
+  double sg_game_delta(const sg_game * game);
+  //! Returns the number of states.
+  int sg_game_num_states(const sg_game * game);
+  //! Returns the total number of action profiles over all states.
+  /*! This is the number of rows of the payoff and probability
+      arrays. */
+  int sg_game_num_profiles(const sg_game * game);
+  //! Copies the numbers of actions into numActions.
+  /*! numActions must have room for 2*numStates entries. */
+  int sg_game_get_num_actions(const sg_game * game, int * numActions);
+  //! Copies the payoffs into payoffs.
+  /*! payoffs must have room for 2*sg_game_num_profiles entries. */
+  int sg_game_get_payoffs(const sg_game * game, double * payoffs);
+  //! Copies the transition probabilities into probabilities.
+  /*! probabilities must have room for
+      numStates*sg_game_num_profiles entries. */
+  int sg_game_get_probabilities(const sg_game * game,
+				double * probabilities);
+
+  // Parameters
+
+  //! Creates an environment with default parameters.
+  sg_env * sg_env_create(void);
+  //! Destroys an environment.
+  void sg_env_free(sg_env * env);
+  //! Sets a parameter by name, as in SGEnv::setParam.
+  int sg_env_set_param(sg_env * env, const char * name, double value);
+  //! Reads a parameter by name into value.
+  int sg_env_get_param(const sg_env * env, const char * name,
+		       double * value);
+
+  // Solving
+
+  //! Creates a solver for game with the parameters in env.
+  /*! The game and parameters are copied, so the handles can be freed
+      afterwards. */
+  sg_solver * sg_solver_create(const sg_env * env, const sg_game * game);
+  //! Destroys a solver.
+  void sg_solver_free(sg_solver * solver);
+  //! Runs the algorithm.
+  /*! Iterations are stored according to the storeIterations
+      parameter, as in SGSolver::solve. progress may be NULL. Returns
+      SG_OK if the algorithm converged or reached maxIterations, and
+      SG_ERROR if it failed or was stopped by the callback. */
+  int sg_solver_solve(sg_solver * solver,
+		      sg_progress_callback progress,
+		      void * userData);
+  //! Returns a handle to the solution of the last call to sg_solver_solve.
+  /*! The handle shares the solution with the solver rather than
+      copying it, and stays valid after the solver is freed. */
+  sg_solution * sg_solver_get_solution(const sg_solver * solver);
+
+  // Solutions
+
+  //! Loads a solution saved with SGSolution::save.
+  sg_solution * sg_solution_load(const char * filename);
+  //! Saves a solution.
+  int sg_solution_save(const sg_solution * soln, const char * filename);
+  //! Destroys a solution handle.
+  void sg_solution_free(sg_solution * soln);
+
+  //! Returns a copy of the solution's game.
+  sg_game * sg_solution_get_game(const sg_solution * soln);
+  //! Returns the number of states.
+  int sg_solution_num_states(const sg_solution * soln);
+  //! Returns the number of stored iterations.
+  int sg_solution_num_iterations(const sg_solution * soln);
+  //! Returns the number of extreme tuples.
+  int sg_solution_num_tuples(const sg_solution * soln);
+
+  //! Copies the extreme tuples into tuples.
+  /*! tuples[2*(numStates*k+s)+i] is player i's payoff in state s of
+      tuple k, so tuples must have room for
+      2*numStates*sg_solution_num_tuples entries. */
+  int sg_solution_get_tuples(const sg_solution * soln, double * tuples);
+
+  //! Copies the stored iterations into the given arrays.
+  /*! Any of the arrays may be NULL, in which case it is skipped. With
+      n = sg_solution_num_iterations and S the number of states:
+
+      - iteration, revolution, bestState, and numExtremeTuples have n
+        entries.
+
+      - pivots[2*(S*k+s)+i] is player i's payoff in state s of the
+        pivot at iteration k (2*S*n entries).
+
+      - directions[2*k+i] is coordinate i of the direction at
+        iteration k (2*n entries).
+
+      - actions[S*k+s] and regimes[S*k+s] are the action and the
+        SG::Regime in state s at iteration k (S*n entries each).
+
+      All arrays are filled in one pass over the iterations. */
+  int sg_solution_get_iterations(const sg_solution * soln,
+				 int * iteration,
+				 int * revolution,
+				 double * pivots,
+				 double * directions,
+				 int * actions,
+				 int * regimes,
+				 int * bestState,
+				 int * numExtremeTuples);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
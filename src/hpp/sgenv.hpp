@@ -27,12 +27,32 @@
 //! Manages parameters for algorithm behavior
 /*!  This class contains parameters for the algorithm.
 
+  Parameters are normally set with the enumerations in the SG
+  namespace. Every parameter also has a name, e.g. "errorTol" for
+  SG::ERRORTOL, and the table returned by SGEnv::getParamTable maps
+  names to parameters, so that interfaces such as sgmex can set
+  parameters from strings without listing them by hand. Names are
+  matched without regard to case.
+
   TODO: Add more checks on the correctness of passed parameter values.
 
   \ingroup src
  */
 class SGEnv
 {
+public:
+  //! Type of a parameter
+  enum ParamType {DoubleParam, BoolParam, IntParam};
+
+  //! Entry in the table of parameter names
+  struct ParamInfo
+  {
+    const char * name; /*!< Name of the parameter. */
+    ParamType type; /*!< Which enumeration param belongs to. */
+    int param; /*!< Value of the SG::DBL_PARAM, SG::BOOL_PARAM, or
+                  SG::INT_PARAM enumeration. */
+  };
+
 private:
   // Parameters
 
@@ -75,6 +95,23 @@ public:
   //! Method for getting integer parameters.
   int getParam(SG::INT_PARAM param) const;
 
+  //! Sets the parameter with the given name.
+  /*! Boolean parameters are true when value is nonzero, and integer
+      parameters must be passed a whole number. Throws
+      SG::UNKNOWN_PARAM if there is no parameter with that name. */
+  void setParam(const string & name, double value);
+
+  //! Returns the parameter with the given name, converted to double.
+  double getParam(const string & name) const;
+
+  //! Returns the table of all parameter names.
+  static const vector<ParamInfo> & getParamTable();
+
+  //! Looks up a parameter by name.
+  /*! Throws SG::UNKNOWN_PARAM if there is no parameter with that
+      name. */
+  static const ParamInfo & findParam(const string & name);
+
   //! Method for redirecting output
   void setOStream(ostream & newOS)
   {
@@ -51,6 +51,8 @@ public:
 	return "Unable to open file.";
       case SG::UNKNOWN_PARAM:
 	return "Could not recognize parameter name.";
+      case SG::BAD_PARAM_VALUE:
+	return "Invalid parameter value.";
       case SG::TUPLE_SIZE_MISMATCH:
 	return "You tried to perform an arithmetic operation on tuples of different sizes";
       case SG::OUT_OF_BOUNDS:
@@ -27,16 +27,20 @@
 #include "sgexception.hpp"
 #include "sgtuple.hpp"
 #include "sgabstractgame.hpp"
+#include "sggameaccessor.hpp"
 #include <boost/archive/text_iarchive.hpp>
 #include <boost/archive/text_oarchive.hpp>
 #include <boost/serialization/utility.hpp>
 
 //! Describes a stochastic game
-/*! This class contains members that describe a stochastic game. 
+/*! This class contains members that describe a stochastic game. The
+    payoffs and transition probabilities are stored in dense arrays,
+    so that SGGame is the fastest implementation of SGGameAccessor
+    when the game fits in memory.
   
   \ingroup src
  */
-class SGGame
+class SGGame : public SGGameAccessor
 {
 private:
   double delta; /*!< The discount factor. */
@@ -88,9 +92,50 @@ private:
                                  algorithm will not impose incentive
                                  compatibility as a constraint for
                                  player i. */
-  
+
+  mutable bool reverseTransitionsValid; /*!< True if the reverse
+                                           transition index below is
+                                           consistent with
+                                           SGGame::probabilities. */
+  mutable vector<int> reverseStarts; /*!< Column offsets of the reverse
+                                        transition index. The pairs
+                                        that reach state s' with
+                                        positive probability are at
+                                        positions reverseStarts[s']
+                                        to reverseStarts[s'+1]-1 of
+                                        the arrays below. */
+  mutable vector<int> reverseStates; /*!< Origin state of each entry of
+                                        the reverse transition
+                                        index. */
+  mutable vector<int> reverseActions; /*!< Action profile of each entry
+                                         of the reverse transition
+                                         index. */
+  mutable vector<double> reverseProbabilities; /*!< Transition
+                                                  probability of each
+                                                  entry of the reverse
+                                                  transition index. */
+
+  //! Builds the reverse transition index
+  /*! Constructs the compressed column form of SGGame::probabilities,
+      so that for each state s' the (state,action) pairs that
+      transition into s' with positive probability are stored
+      contiguously. Only runs if the index has been invalidated. */
+  void buildReverseTransitions() const;
+
+  //! Copies one state of an SGAbstractGame
+  /*! Fills in SGGame::payoffs, SGGame::probabilities, and
+      SGGame::eqActions for the given state. The nonzero transition
+      probabilities are also returned in compressed row form in
+      rowStarts, rowStates, and rowProbabilities. Only touches data
+      belonging to the given state, so different states can be
+      converted concurrently. */
+  void convertState(const SGAbstractGame & game, int state,
+		    vector<int> & rowStarts,
+		    vector<int> & rowStates,
+		    vector<double> & rowProbabilities);
+
   //! Serializes the game using boost.
-  template <class Archive> 
+  template <class Archive>
   void serialize(Archive& ar, const unsigned int version)
   {
     ar & delta;
@@ -102,6 +147,8 @@ private:
     ar & probabilities;
     ar & eqActions;
     ar & unconstrained;
+
+    reverseTransitionsValid = false;
   }
 
 public:
@@ -114,7 +161,8 @@ public:
     probabilities(1,vector< vector<double> > (1,vector<double> (1,1))),
     delta(0.9),
     numPlayers(2),
-    unconstrained(2,false)
+    unconstrained(2,false),
+    reverseTransitionsValid(false)
   {}
 
   //! Converts an SGAbstractGame into a SGGame
@@ -124,8 +172,15 @@ public:
       payoffs and probability methods into arrays. Storing this data
       in arrays provides for faster access by SGApprox and it allows
       the game to be serialized. See risksharing.hpp and
-      risksharing.cpp for an example. */
-  SGGame(const SGAbstractGame & game);
+      risksharing.cpp for an example.
+
+      Rows of transition probabilities are requested one at a time
+      through SGAbstractGame::probabilities, and states are divided
+      among numThreads threads. If numThreads is zero, one thread is
+      used for each available core. The reverse transition index is
+      assembled from the nonzero entries found along the way, so it
+      does not need another pass over the dense table. */
+  SGGame(const SGAbstractGame & game, int numThreads = 1);
     
   ~SGGame() {}
   //! Constructor excluding eqActions
@@ -177,6 +232,12 @@ public:
   //! Returns a const reference to the payoffs
   const vector< vector<SGPoint> > & getPayoffs() const
   { return payoffs; }
+  //! Returns the payoffs of the given action profile
+  const SGPoint & getPayoff(int state, int action) const
+  { return payoffs[state][action]; }
+  //! Returns the transition probabilities of the given action profile
+  const vector<double> & getTransitions(int state, int action) const
+  { return probabilities[state][action]; }
   //! Returns a const reference to the equilibrium actions
   const vector< list<int> > & getEquilibriumActions() const
   { return eqActions; }
@@ -188,6 +249,26 @@ public:
   const vector<bool> & getConstrained() const
   { return unconstrained; }
 
+  //! Returns the column offsets of the reverse transition index
+  /*! The (state,action) pairs that transition into state s' with
+      positive probability are stored at positions
+      getReverseStarts()[s'] through getReverseStarts()[s'+1]-1 of
+      getReverseStates(), getReverseActions(), and
+      getReverseProbabilities(). The index is built on the first call
+      after the transition probabilities change, so the first call
+      should not be made concurrently from several threads. */
+  const vector<int> & getReverseStarts() const
+  { buildReverseTransitions(); return reverseStarts; }
+  //! Returns the origin states of the reverse transition index
+  const vector<int> & getReverseStates() const
+  { buildReverseTransitions(); return reverseStates; }
+  //! Returns the action profiles of the reverse transition index
+  const vector<int> & getReverseActions() const
+  { buildReverseTransitions(); return reverseActions; }
+  //! Returns the probabilities of the reverse transition index
+  const vector<double> & getReverseProbabilities() const
+  { buildReverseTransitions(); return reverseProbabilities; }
+
   //! Set discount factor.
   /*! Method for setting the discount factor. */
   bool setDiscountFactor(double newDelta);
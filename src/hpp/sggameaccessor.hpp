@@ -0,0 +1,71 @@
+// This file is part of the SGSolve library for stochastic games
+// Copyright (C) 2016 Benjamin A. Brooks
+// 
+// SGSolve free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// SGSolve is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see
+// <http://www.gnu.org/licenses/>.
+// 
+// Benjamin A. Brooks
+// ben@benjaminbrooks.net
+// Chicago, IL
+
+#ifndef _SGGAMEACCESSOR_HPP
+#define _SGGAMEACCESSOR_HPP
+
+#include "sgcommon.hpp"
+#include "sgpoint.hpp"
+
+//! Interface through which the solver reads a game
+/*! SGApprox and SGAction only need the primitives of the game one
+    state and action profile at a time. This class lists the methods
+    that they use, so that the game can either be stored in dense
+    arrays (SGGame) or generated on demand from an SGAbstractGame
+    (SGLazyGame).
+
+  \ingroup src
+ */
+class SGGameAccessor
+{
+public:
+  virtual ~SGGameAccessor() {}
+
+  //! Returns the discount factor
+  virtual double getDelta() const = 0;
+  //! Returns the number of players (always 2)
+  virtual int getNumPlayers() const = 0;
+  //! Returns the number of states
+  virtual int getNumStates() const = 0;
+  //! Returns the number of each player's actions in each state
+  virtual const vector< vector<int> > & getNumActions() const = 0;
+  //! Returns the total number of action profiles in each state
+  virtual const vector<int> & getNumActions_total() const = 0;
+  //! Returns the action profiles that can be played in equilibrium
+  virtual const vector< list<int> > & getEquilibriumActions() const = 0;
+  //! Returns the vector of flags for unconstrained players
+  virtual const vector<bool> & getConstrained() const = 0;
+  //! Sets the arguments equal to upper and lower bounds on the
+  //! payoffs, respectively.
+  virtual void getPayoffBounds(SGPoint & UB, SGPoint & LB) const = 0;
+
+  //! Returns the flow payoffs of the given action profile
+  virtual const SGPoint & getPayoff(int state, int action) const = 0;
+  //! Returns the transition probabilities of the given action profile
+  /*! Element s' of the returned vector is the probability of moving
+      to state s' when the given action profile is played in the given
+      state. The reference is only guaranteed to be valid until the
+      next call to getTransitions. */
+  virtual const vector<double> & getTransitions(int state,
+						int action) const = 0;
+};
+
+#endif
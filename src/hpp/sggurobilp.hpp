@@ -0,0 +1,223 @@
+// This file is part of the SGSolve library for stochastic games
+// Copyright (C) 2016 Benjamin A. Brooks
+// 
+// SGSolve free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// SGSolve is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see
+// <http://www.gnu.org/licenses/>.
+// 
+// Benjamin A. Brooks
+// ben@benjaminbrooks.net
+// Chicago, IL
+
+#ifndef _SGGUROBILP_HPP
+#define _SGGUROBILP_HPP
+
+#include "sgcommon.hpp"
+#include "sglp.hpp"
+#include "sgexception.hpp"
+#include "gurobi_c++.h"
+
+//! Implementation of SGLP that calls Gurobi
+/*! This file has no associated cpp file, so that libsg does not have
+    to link to Gurobi. It is used in place of SGSimplex when SGGUROBI
+    is defined; see sglpbackend.hpp.
+
+    Gurobi keeps the basis of the last solve by itself, so warm starts
+    come for free. The model uses the default simplex based method so
+    that basis statuses and right hand side ranging are available.
+
+  \ingroup src
+ */
+class SGGurobiLP : public SGLP
+{
+private:
+  GRBEnv env; /*!< The Gurobi environment. */
+  mutable GRBModel model; /*!< The Gurobi model. Mutable because not
+                             all of Gurobi's accessors are const. */
+  mutable vector<GRBVar> vars; /*!< The variables. */
+  mutable vector<GRBConstr> constrs; /*!< The constraints. */
+  Status status; /*!< Status of the last solve. */
+
+  //! Converts a bound to Gurobi's convention for infinity
+  static double toGRB(double bound)
+  {
+    if (bound >= INF)
+      return GRB_INFINITY;
+    if (bound <= -INF)
+      return -GRB_INFINITY;
+    return bound;
+  }
+  //! Converts a bound from Gurobi's convention for infinity
+  static double fromGRB(double bound)
+  {
+    if (bound >= GRB_INFINITY)
+      return INF;
+    if (bound <= -GRB_INFINITY)
+      return -INF;
+    return bound;
+  }
+
+public:
+  //! Constructor
+  SGGurobiLP():
+    env(),
+    model(env),
+    status(NOT_SOLVED)
+  {
+    model.getEnv().set(GRB_IntParam_OutputFlag,0);
+    model.getEnv().set(GRB_DoubleParam_OptimalityTol,1e-9);
+    model.getEnv().set(GRB_DoubleParam_FeasibilityTol,1e-9);
+    model.getEnv().set(GRB_DoubleParam_MarkowitzTol,0.999);
+  }
+
+  //! Returns the Gurobi model, e.g., for setting parameters
+  GRBModel & getModel() { return model; }
+
+  int addVariables(int num, double lb = 0.0, double ub = INF)
+  {
+    int first = vars.size();
+    GRBVar * newVars = model.addVars(num);
+    model.update();
+    for (int k = 0; k < num; k++)
+      {
+	newVars[k].set(GRB_DoubleAttr_LB,toGRB(lb));
+	newVars[k].set(GRB_DoubleAttr_UB,toGRB(ub));
+	vars.push_back(newVars[k]);
+      }
+    delete[] newVars;
+    status = NOT_SOLVED;
+    return first;
+  } // addVariables
+
+  int addConstraint(const SGLinExpr & expr, Sense sense, double rhs)
+  {
+    GRBLinExpr lhs = 0;
+    for (int k = 0; k < expr.size(); k++)
+      lhs += expr.coefs[k]*vars[expr.vars[k]];
+
+    char grbSense = GRB_EQUAL;
+    if (sense == LESSEQUAL)
+      grbSense = GRB_LESS_EQUAL;
+    else if (sense == GREATEREQUAL)
+      grbSense = GRB_GREATER_EQUAL;
+
+    constrs.push_back(model.addConstr(lhs,grbSense,rhs-expr.constant));
+    status = NOT_SOLVED;
+    return constrs.size()-1;
+  } // addConstraint
+
+  void removeConstraints(int first, int num)
+  {
+    for (int k = first; k < first+num; k++)
+      model.remove(constrs[k]);
+    constrs.erase(constrs.begin()+first,constrs.begin()+first+num);
+    model.update();
+    status = NOT_SOLVED;
+  } // removeConstraints
+
+  void setRHS(int constr, double rhs)
+  {
+    constrs[constr].set(GRB_DoubleAttr_RHS,rhs);
+    status = NOT_SOLVED;
+  }
+
+  void setBounds(int var, double lb, double ub)
+  {
+    vars[var].set(GRB_DoubleAttr_LB,toGRB(lb));
+    vars[var].set(GRB_DoubleAttr_UB,toGRB(ub));
+    status = NOT_SOLVED;
+  }
+
+  void setObjective(const SGLinExpr & expr, bool maximize)
+  {
+    GRBLinExpr obj = expr.constant;
+    for (int k = 0; k < expr.size(); k++)
+      obj += expr.coefs[k]*vars[expr.vars[k]];
+    model.setObjective(obj,maximize? GRB_MAXIMIZE: GRB_MINIMIZE);
+    status = NOT_SOLVED;
+  }
+
+  Status solve()
+  {
+    try
+      {
+	model.optimize();
+	switch (model.get(GRB_IntAttr_Status))
+	  {
+	  case GRB_OPTIMAL:
+	    status = OPTIMAL;
+	    break;
+	  case GRB_INFEASIBLE:
+	  case GRB_INF_OR_UNBD:
+	    status = INFEASIBLE;
+	    break;
+	  case GRB_UNBOUNDED:
+	    status = UNBOUNDED;
+	    break;
+	  case GRB_ITERATION_LIMIT:
+	    status = ITERATION_LIMIT;
+	    break;
+	  default:
+	    status = NOT_SOLVED;
+	  }
+      }
+    catch (GRBException & e)
+      {
+	cout << "GRB Exception caught: " << e.getMessage() << endl;
+	status = NOT_SOLVED;
+      }
+    return status;
+  } // solve
+
+  int getNumVariables() const { return vars.size(); }
+  int getNumConstraints() const { return constrs.size(); }
+  double getLowerBound(int var) const
+  { return fromGRB(vars[var].get(GRB_DoubleAttr_LB)); }
+  double getUpperBound(int var) const
+  { return fromGRB(vars[var].get(GRB_DoubleAttr_UB)); }
+  Status getStatus() const { return status; }
+  double getObjectiveValue() const
+  { return model.get(GRB_DoubleAttr_ObjVal); }
+  double getValue(int var) const
+  { return vars[var].get(GRB_DoubleAttr_X); }
+  int getBasisStatus(int var) const
+  { return vars[var].get(GRB_IntAttr_VBasis); }
+  void getRHSRange(int constr, double & low, double & high) const
+  {
+    low = fromGRB(constrs[constr].get(GRB_DoubleAttr_SARHSLow));
+    high = fromGRB(constrs[constr].get(GRB_DoubleAttr_SARHSUp));
+  }
+  void getBasis(vector<int> & basis) const
+  {
+    basis.resize(vars.size()+constrs.size());
+    for (int j = 0; j < vars.size(); j++)
+      basis[j] = vars[j].get(GRB_IntAttr_VBasis);
+    // Gurobi reports nonbasic slacks as -1 regardless of the sense.
+    for (int i = 0; i < constrs.size(); i++)
+      basis[vars.size()+i] = constrs[i].get(GRB_IntAttr_CBasis);
+  }
+  void setBasis(const vector<int> & basis)
+  {
+    if (basis.size() != vars.size()+constrs.size())
+      throw(SGException(SG::BAD_PARAM_VALUE));
+    model.update();
+    for (int j = 0; j < vars.size(); j++)
+      vars[j].set(GRB_IntAttr_VBasis,basis[j]);
+    for (int i = 0; i < constrs.size(); i++)
+      constrs[i].set(GRB_IntAttr_CBasis,
+		     basis[vars.size()+i] == BASIC? 0: -1);
+    status = NOT_SOLVED;
+  }
+};
+
+#endif
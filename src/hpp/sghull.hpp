@@ -0,0 +1,152 @@
+// This file is part of the SGSolve library for stochastic games
+// Copyright (C) 2016 Benjamin A. Brooks
+// 
+// SGSolve free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// SGSolve is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see
+// <http://www.gnu.org/licenses/>.
+// 
+// Benjamin A. Brooks
+// ben@benjaminbrooks.net
+// Chicago, IL
+
+
+#ifndef _SGHULL_HPP
+#define _SGHULL_HPP
+
+#include "sgcommon.hpp"
+#include <unordered_map>
+
+//! Convex hull of points in three dimensions
+/*! Builds the convex hull of a set of points with the quickhull
+    algorithm. Each facet keeps the points that are above it, and the
+    hull is grown by adding the furthest point above some facet:
+    the facets that the point can see are removed, the horizon of
+    those facets is joined to the point with new triangles, and the
+    points above the removed facets are handed to the new ones or
+    dropped if they are now inside. Since the furthest points come
+    first, points that are close to the hull are usually inside by
+    the time they would be added, which keeps thin triangles out of
+    the hull when many of the points lie on common lines and planes.
+
+    Points are read from a contiguous array of coordinates. The
+    facets, their point lists, and the map from edges to facets are
+    kept between calls to SGHull::build, and dead facets are recycled,
+    so that repeated builds do not allocate once the workspace has
+    grown. Only the storage is reused: each build computes the hull of
+    its points from scratch. Quickhull can only add points to a hull,
+    and SGSolverND's polytopes shrink from one iteration to the next,
+    so the previous hull is not a valid starting point.
+
+    Facets are triangles with outward normals of unit length. Points
+    within a relative tolerance of a facet's plane are treated as
+    inside of it, so coplanar points are not added as vertices. A
+    flat face of the hull may be split into several triangles, which
+    SGHull::getFacets merges back into one plane.
+
+  \ingroup src
+ */
+class SGHull
+{
+private:
+  //! A triangular facet
+  struct Facet
+  {
+    int vertices[3]; /*!< Indices of the vertices, counterclockwise
+                        when viewed from outside. */
+    double normal[3]; /*!< Outward unit normal. */
+    double level; /*!< Level of the facet's plane in the direction
+                     of the normal. */
+    double area; /*!< Area of the triangle. */
+    bool alive; /*!< False if the facet has been removed. */
+    vector<int> outside; /*!< Points that are above the facet and
+                            have not been added yet. */
+  };
+
+  const double * points; /*!< Coordinates of the points, three per
+                            point. */
+  int numPoints; /*!< Number of points. */
+  double tol; /*!< Distance from a facet below which a point is
+                 considered to be on it. */
+
+  vector<Facet> facets; /*!< Facets of the hull, including dead
+                           ones. */
+  vector<int> freeFacets; /*!< Indices of dead facets that can be
+                             reused. */
+  std::unordered_map<long long,int> edges; /*!< Maps the directed edge
+                                              (a,b) to the facet that
+                                              has it. */
+  vector<int> visible; /*!< Workspace for the facets that a new point
+                          can see. */
+  vector<int> horizon; /*!< Workspace for the horizon edges, two
+                          vertices per edge. */
+  vector<int> newFacets; /*!< Workspace for the facets joined to a
+                            new point. */
+  vector<int> orphans; /*!< Workspace for the points above the
+                          removed facets. */
+  vector<int> pending; /*!< Facets that may have points above
+                          them. */
+  vector<char> isVisible; /*!< isVisible[f] is true if facet f is in
+                             SGHull::visible. */
+
+  //! Returns a pointer to the coordinates of point k
+  const double * point(int k) const { return points+3*k; }
+  //! Key for the directed edge from a to b
+  long long edgeKey(int a, int b) const
+  { return static_cast<long long>(a)*numPoints+b; }
+  //! Adds the facet (a,b,c) and returns its index
+  /*! The orientation is given by the order of the vertices. */
+  int addFacet(int a, int b, int c);
+  //! Removes the facet and its edges
+  void removeFacet(int f);
+  //! Signed distance of point k above the plane through a, b and c
+  /*! The plane is oriented by the right hand rule. Returns the
+      largest double if a, b and c are collinear. */
+  double height(int a, int b, int c, int k) const;
+  //! Signed distance of point k above facet f
+  double height(int f, int k) const;
+  //! Adds the furthest point above facet f to the hull
+  void expand(int f);
+  //! Gives point k to the facet among candidates that it is furthest
+  //! above
+  /*! Returns false if k is not above any of them. */
+  bool assign(int k, const vector<int> & candidates);
+
+public:
+  //! Default constructor
+  SGHull(): points(NULL), numPoints(0), tol(0) {}
+
+  //! Builds the hull of the given points
+  /*! _points holds three coordinates for each of the _numPoints
+      points. Returns false if the points do not span three
+      dimensions, in which case the hull is empty. The points must
+      stay in place while the hull is in use. */
+  bool build(const double * _points, int _numPoints);
+
+  //! Returns the number of facets
+  int getNumFacets() const { return facets.size()-freeFacets.size(); }
+  //! Returns the planes of the faces of the hull
+  /*! Four entries for each plane: the outward unit normal and the
+      level, so that the hull is the set of x with normal*x<=level
+      for every plane. Adjacent facets whose vertices lie on each
+      other's planes are merged into one plane, which has the normal
+      of the largest of them and passes through the highest of the
+      points. */
+  void getFacets(vector<double> & planes) const;
+  //! Returns the indices of the vertices of the hull in increasing order
+  void getVertices(vector<int> & vertices) const;
+  //! Returns the volume of the hull
+  double volume() const;
+
+}; // SGHull
+
+#endif
@@ -63,16 +63,16 @@ public:
   //! Default constructor
   SGIteration_V2() {}
 
-  // //! Initializes a new SGIteration_V2 object with data on the current
-  // //! iteration
-  // /*! By default, the constructor will also copy the data in
-  //     SGApprox::actions, so that the user can later recover the test
-  //     directions that were available at the given iteration. If the
-  //     second argument is false, then these actions will not be
-  //     stored. For large games, storing the actions can take a large
-  //     amount of memory. */
-  // SGIteration_V2(const SGApprox & approx,
-  // 	      bool storeActions = true);
+  //! Initializes a new SGIteration_V2 object with data on the last
+  //! revolution
+  /*! By default, the constructor will also copy the data in
+      SGApprox_V2::actions, so that the user can later recover the
+      binding continuation values that were available at the given
+      iteration. If the second argument is false, then these actions
+      will not be stored. For large games, storing the actions can
+      take a large amount of memory. */
+  SGIteration_V2(const SGApprox_V2 & approx,
+		 bool storeActions = true);
 
   //! Get method for the iteration.
   int getIteration() const { return iteration; } 
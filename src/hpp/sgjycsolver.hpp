@@ -26,27 +26,81 @@
 #include "sgutilities.hpp"
 #include "sggame.hpp"
 #include "sgexception.hpp"
-#include "gurobi_c++.h"
+#include "sglpbackend.hpp"
+#include <memory>
 
-//! Class that implements the JYC algorithm using Gurobi
+//! Class that implements the JYC algorithm
 /*! This class implements the generalization of the algorithm of Judd,
   Yeltekin, and Conklin (2002) for solving stochastic games.
 
-  This file has no associated cpp file, so that libsg does not have to
-  link to Gurobi. 
+  The linear programs are solved with SGDefaultLP, which is the
+  bundled SGSimplex unless SGGUROBI is defined, in which case Gurobi
+  is used. This file has no associated cpp file, so that libsg does
+  not have to link to Gurobi.
+
+  There is one linear program for each state and equilibrium action,
+  which shares the feasibility constraints with all of the others and
+  differs only in its incentive constraints. Since the incentive
+  constraints do not change between iterations, they are built once
+  in SGJYCSolver::initialize, and the optimal basis of each action's
+  program is stored, so that the next iteration restarts from it
+  after only the right hand sides of the feasibility constraints have
+  changed.
+
+  Given the bounds from the previous iteration, the programs of
+  different actions are independent. When numThreads is not one,
+  the actions are divided among threads, each of which has its own
+  copy of the model, and the new bounds are combined once all of the
+  threads have finished.
+
+  With two players, each program maximizes a linear function of the
+  expected continuation value, which ranges over the polygon
+  \f$\sum_{s'}\pi(s')W(s')\f$, subject to a lower bound on each
+  player's coordinate. When the method is SG_SWEEP, this polygon is
+  constructed directly from the bounds and clipped by the incentive
+  constraints, and its support function is evaluated in all
+  directions in one pass around its vertices, so that no linear
+  programs are solved. In this method, the threat for each player is
+  their minimum payoff in each state, as in SGSolver, rather than a
+  point that is common to the two players.
+
+  The directions start out equally spaced. If maxDirections is larger
+  than the initial number of directions, then each time the bounds
+  converge, SGJYCSolver::refineDirections bisects the angles between
+  adjacent directions where the outer approximation may be far from
+  the correspondence, and the iterations continue from the refined
+  bounds. This stops when the bound on the Hausdorff distance falls
+  below refineTol or when there are maxDirections directions.
 
   \ingroup src
  */
 class SGJYCSolver
 {
+public:
+  //! Methods for solving the directional maximization problems
+  enum SGJYCMethod
+    {
+      SG_LINEARPROGRAM, /*!< One linear program for each action and
+			   direction. */
+      SG_SWEEP /*!< Closed form solution on the polygon of expected
+		  continuation values. */
+    };
+
 private:
   //! Const reference to the game being solved.
   const SGGame & game;
 
-  //! The Gurobi environment.
-  GRBEnv env;
-  //! The Gurobi model.
-  GRBModel model;
+  //! The method for the directional maximization problems.
+  SGJYCMethod method;
+
+  //! Number of threads used by SGJYCSolver::iterate.
+  int numWorkers;
+
+  //! The linear programs, one for each thread.
+  vector< std::shared_ptr<SGDefaultLP> > models;
+
+  //! Number of threads requested, or zero for one per core.
+  int numThreads;
 
   //! Payoff bounds.
   vector< vector<double> > bounds;
@@ -57,36 +111,147 @@ private:
   //! Number of gradients
   int numDirections;
 
+  //! Number of equally spaced gradients at the start of the solve
+  int numInitialDirections;
+  //! Largest number of gradients after refinement
+  int maxDirections;
+  //! Hausdorff distance at which refinement stops
+  double refineTol;
+
+  //! Incentive constraints
+  /*! icConstraints[state][action] are the left hand sides of the
+      incentive constraints of the given action, which must be
+      non-negative. Only filled in for equilibrium actions. */
+  vector< vector< vector<SGLinExpr> > > icConstraints;
+
+  //! Stored bases
+  /*! bases[state][action] is the optimal basis for the first
+      direction in the last iteration, in the format of SGLP::getBasis,
+      or is empty if there is none. */
+  vector< vector< vector<int> > > bases;
+
+  //! The (state,action) pairs whose programs are solved in each
+  //! iteration.
+  vector< pair<int,int> > eqActions;
+
+  //! Adds the variables and feasibility constraints to an empty model
+  void buildModel(SGLP & model) const;
+
+  //! Solves the programs of one action for all directions
+  /*! The incentive constraints of the action are added to model,
+      which must already have up to date feasibility constraints, and
+      are removed again at the end. For each direction, newBounds is
+      raised to the value of the program if that is larger. */
+  void solveAction(SGLP & model, int state, int action,
+		   vector< vector<double> > & newBounds);
+
+  //! Support function of each state's polygon for SG_SWEEP
+  /*! stateSupport[s][dir] is the largest value of directions[dir]
+      over the points that satisfy bounds[s]. */
+  vector< vector<double> > stateSupport;
+  //! Minimum payoffs of each player in each state for SG_SWEEP
+  vector<SGPoint> stateThreats;
+  //! False if the polygon of some state is empty
+  bool statesFeasible;
+
+  //! Computes stateSupport, stateThreats, and statesFeasible
+  void sweepStates();
+
+  //! Solves the problems of one action for all directions using the
+  //! polygon of expected continuation values
+  void sweepAction(int state, int action,
+		   vector< vector<double> > & newBounds) const;
+
+  //! Intersection of half planes
+  /*! Sets vertices to the counter-clockwise list of vertices of the
+      polygon of points x with normals[k]*x<=levels[k] for all k. The
+      normals must be in counter-clockwise order and positively span
+      the plane. Returns false if the polygon is empty. */
+  static bool intersectHalfPlanes(const vector<SGPoint> & normals,
+				  const vector<double> & levels,
+				  vector<SGPoint> & vertices);
+  //! Support function of a convex polygon
+  /*! Sets support[k] to the largest value of directions[k] over
+      vertices. Both vertices and directions must be in
+      counter-clockwise order, in which case the maximizing vertex
+      only moves forward as the direction rotates. */
+  static void polygonSupport(const vector<SGPoint> & vertices,
+			     const vector<SGPoint> & directions,
+			     vector<double> & support);
+  //! Intersection of the lines normal0*x=level0 and normal1*x=level1
+  static SGPoint intersectLines(const SGPoint & normal0, double level0,
+				const SGPoint & normal1, double level1);
+  //! Clips a convex polygon to the points with x[coord]>=level
+  static void clipPolygon(vector<SGPoint> & vertices,
+			  int coord, double level);
+
 public:
   //! Constructor
-  SGJYCSolver(const SGGame & _game, int _numDirections):
-    env(),
-    model(env),
+  /*! The programs are solved by _numThreads threads, or by one thread
+      per core if _numThreads is zero. */
+  SGJYCSolver(const SGGame & _game, int _numDirections,
+	      int _numThreads = 1):
+    numThreads(_numThreads),
+    numWorkers(1),
+    method(SG_LINEARPROGRAM),
     game(_game),
     bounds(vector< vector<double> > (game.getNumStates(),
 				     vector<double>(_numDirections,0))),
     directions(_numDirections),
-    numDirections(_numDirections)
-  {
-    env.set(GRB_IntParam_Method,2); // barrier
-    env.set(GRB_IntParam_Crossover,0); // disable crossover
-    env.set(GRB_DoubleParam_BarConvTol,1e-12);
-    env.set(GRB_DoubleParam_OptimalityTol,1e-9);
-    env.set(GRB_DoubleParam_MarkowitzTol,0.999);
-    env.set(GRB_DoubleParam_FeasibilityTol,1e-9);
-    env.set(GRB_IntParam_OutputFlag,0);
-  }
+    numDirections(_numDirections),
+    numInitialDirections(_numDirections),
+    maxDirections(_numDirections),
+    refineTol(1e-6),
+    icConstraints(game.getNumStates()),
+    bases(game.getNumStates())
+  {}
 
   //! Returns the current game
   const SGGame & getGame() const { return game; }
-  //! Returns the environment
-  GRBEnv & getEnv() {return env; }
+  //! Returns the linear program of the given thread
+  /*! The models are created by SGJYCSolver::initialize, unless the
+      method is SG_SWEEP. */
+  SGDefaultLP & getModel(int thread = 0) {return *models[thread]; }
+  //! Returns the number of threads requested
+  int getNumThreads() const { return numThreads; }
+  //! Sets the number of threads, or zero for one per core
+  /*! Takes effect at the next call to SGJYCSolver::initialize. */
+  bool setNumThreads(int _numThreads)
+  {
+    if (_numThreads < 0)
+      return false;
+    numThreads = _numThreads;
+    return true;
+  }
+  //! Returns the method for the directional maximization problems
+  SGJYCMethod getMethod() const { return method; }
+  //! Sets the method for the directional maximization problems
+  /*! Takes effect at the next call to SGJYCSolver::initialize. */
+  bool setMethod(SGJYCMethod _method)
+  {
+    method = _method;
+    return true;
+  }
   //! Returns payoff bounds
   const vector< vector<double> > & getBounds() const { return bounds; }
   //! Return directions
   const vector<SGPoint> & getDirections() const { return directions; }
   //! Return numDirections
   int getNumDirections() const { return numDirections; }
+  //! Sets the parameters of the direction refinement
+  /*! Directions are added until there are _maxDirections of them or
+      until the bound on the Hausdorff distance between the outer
+      approximation and the correspondence is below
+      _refineTol. Refinement is off if _maxDirections is at most the
+      initial number of directions, which is the default. */
+  bool setRefinement(int _maxDirections, double _refineTol)
+  {
+    if (_maxDirections < 0 || _refineTol < 0)
+      return false;
+    maxDirections = _maxDirections;
+    refineTol = _refineTol;
+    return true;
+  }
   
   //! Solve routine
   void solve();
@@ -96,6 +261,20 @@ public:
   
   //! Runs one iteration
   double iterate();
+
+  //! Adds directions where the outer approximation is coarsest
+  /*! In each state, the bounds of adjacent directions dir and dir+1
+      meet at a vertex of the outer approximation. When every bound
+      is attained, the correspondence touches both of the edges at
+      that vertex, so its distance from the vertex is at most the
+      distance from the vertex to the segment joining its two
+      neighbours. The angles whose vertices are farther than
+      refineTol from that segment in some state are bisected, worst
+      first and up to maxDirections in total. The bound for a new
+      direction is attained at the vertex, so the outer approximation
+      itself does not change. Returns the number of directions
+      added. */
+  int refineDirections();
 };
 
 void SGJYCSolver::solve()
@@ -105,21 +284,28 @@ void SGJYCSolver::solve()
   int numIterations = 0;
 
   initialize();
-  
-  while (error > errorTol)
+
+  do
     {
-      error = iterate();
-      cout << "Iteration: " << numIterations
-	   << ", error: " << error << endl;
+      error = 1.0;
+      while (error > errorTol)
+	{
+	  error = iterate();
+	  cout << "Iteration: " << numIterations
+	       << ", error: " << error << endl;
 
-      numIterations++;
-    }
+	  numIterations++;
+	}
+    } while (refineDirections() > 0);
 }
 
 void SGJYCSolver::initialize()
 {
 
   // Set directions to be equally spaced
+  numDirections = numInitialDirections;
+  directions.resize(numDirections);
+  bounds.assign(game.getNumStates(),vector<double>(numDirections,0));
   for (int dir = 0; dir < numDirections; dir++)
     {
       double theta = 2.0*dir/numDirections*PI;
@@ -127,22 +313,6 @@ void SGJYCSolver::initialize()
 				std::sin(theta));
     }
 
-  // Variables 
-  GRBVar *  var = model.addVars(4*game.getNumStates()); // One variable for each
-					      // player/state in
-					      // equilibrium and one
-					      // variable for each
-					      // player/state as the
-					      // threat
-  for (int varCtr = 0; varCtr < model.get(GRB_IntAttr_NumVars); varCtr++)
-    {
-      var[varCtr].set(GRB_DoubleAttr_LB,-1e20);
-    }
-
-  // First 2*numStates variables correspond to eq payoffs, second
-  // 2*numStates are threats.
-  model.update();
-
   // Calculate initial bounds. 
   SGPoint NE, SW;
   game.getPayoffBounds(NE,SW);
@@ -162,80 +332,43 @@ void SGJYCSolver::initialize()
 	bounds[state][dir] = bounds[0][dir];
     } // direction
 
-  // Add feasibility constraints.
-  for (int state = 0; state < game.getNumStates(); state++)
-    {
-      // Equilibrium payoffs
-      for (int dir = 0; dir < numDirections; dir++)
-	{
-	  model.addConstr(var[2*state]*directions[dir][0]
-			  + var[2*state+1]*directions[dir][1]
-			  <= bounds[state][dir]);
-	} // direction
-
-      // Threat points
-      for (int dir = 0; dir < numDirections; dir++)
-	{
-	  model.addConstr(var[2*game.getNumStates()+2*state]*directions[dir][0]
-			  + var[2*game.getNumStates()+2*state+1]*directions[dir][1]
-			  <= bounds[state][dir]);
-	} // direction
-    } // state
-  model.update();
-  
-  delete[] var;
-}
-
-double SGJYCSolver::iterate()
-{
-  vector<int> actions, deviations;
-  int deviation;
-
+  // Build the incentive constraints for each equilibrium action. The
+  // sweep only needs the list of actions.
   const vector< vector< SGPoint> > & payoffs = game.getPayoffs();
   const vector< vector< vector<double> > > & prob = game.getProbabilities();
   const vector< vector<int> > & numActions = game.getNumActions();
-  const vector< int > & numActions_total = game.getNumActions_total();
   int numStates = game.getNumStates();
   double delta = game.getDelta();
+  vector<int> actions, deviations;
+  int deviation;
 
-  GRBVar * var = model.getVars();
-
-  GRBConstr * constr = model.getConstrs();
-
-  // Update feasibility constraints.
+  eqActions.clear();
   for (int state = 0; state < numStates; state++)
     {
-      // Equilibrium payoffs
-      for (int dir = 0; dir < numDirections; dir++)
-  	{
-  	  constr[2*state*numDirections+dir].set(GRB_DoubleAttr_RHS,bounds[state][dir]);
-  	  constr[(2*state+1)*numDirections+dir].set(GRB_DoubleAttr_RHS,bounds[state][dir]);
-  	} // direction
-    } // state
+      icConstraints[state].assign(game.getNumActions_total()[state],
+				  vector<SGLinExpr>());
+      bases[state].assign(game.getNumActions_total()[state],
+			  vector<int>());
 
-  vector< vector<double> > 
-    newBounds(numStates,
-	      vector<double>(numDirections,
-			     -numeric_limits<double>::max()));
-  for (int state = 0; state < numStates; state++)
-    {
       for (list<int>::const_iterator actionIter = game.getEquilibriumActions()[state].begin(); 
 	   actionIter != game.getEquilibriumActions()[state].end(); 
 	   ++actionIter)
 	{
 	  int action = *actionIter;
+	  eqActions.push_back(make_pair(state,action));
+	  if (method == SG_SWEEP)
+	    continue;
+
 	  indexToVector(action,actions,numActions[state]);
 	  
 	  deviations = actions;
 
-	  // Implement incentive constraints for this action
 	  for (int player = 0; player < 2; player ++)
 	    {
-	      
-	      GRBLinExpr lhs = 0;
+	      SGLinExpr lhs;
 	      lhs += (1-delta)*payoffs[state][action][player];
 	      for (int sp = 0; sp < numStates; sp++)
-	  	lhs += delta*prob[state][action][sp]*var[2*sp+player];
+	  	lhs.add(2*sp+player,delta*prob[state][action][sp]);
 
 	      for (int dev = 0; dev < numActions[state][player]; dev++)
 	  	{
@@ -246,63 +379,129 @@ double SGJYCSolver::iterate()
 	  	  deviation = vectorToIndex(deviations,
 	  				    numActions[state]);
 
-	  	  GRBLinExpr rhs = 0; // deviation payoff
-	  	  rhs += (1-delta)*payoffs[state][deviation][player];
+	  	  SGLinExpr ic = lhs; // minus the deviation payoff
+	  	  ic += -(1-delta)*payoffs[state][deviation][player];
 	  	  for (int sp = 0; sp < numStates; sp++)
 	  	    {
-	  	      rhs += delta*prob[state][deviation][sp]*var[2*numStates
-	  						       +2*sp+player];
+	  	      ic.add(2*numStates+2*sp+player,
+			     -delta*prob[state][deviation][sp]);
 	  	    }
 		  
-	  	  model.addConstr(lhs >= rhs);
+		  icConstraints[state][action].push_back(ic);
 	  	} // dev
 
 	      deviations[player] = actions[player];
 	    } // player
+	} // action
+    } // state
 
-	  model.update();
+  // One model for each thread.
+  int threads = numWorkerThreads(numThreads,eqActions.size());
+  numWorkers = threads;
+  models.clear();
+  if (method == SG_LINEARPROGRAM)
+    {
+      for (int thread = 0; thread < threads; thread++)
+	{
+	  models.push_back(std::shared_ptr<SGDefaultLP>(new SGDefaultLP()));
+	  buildModel(*models.back());
+	}
+    }
+} // initialize
 
-	  for (int dir = 0; dir < numDirections; dir++)
+void SGJYCSolver::buildModel(SGLP & model) const
+{
+  // Variables 
+  model.addVariables(4*game.getNumStates(),
+		     -SGLP::INF,SGLP::INF); // One variable for each
+					      // player/state in
+					      // equilibrium and one
+					      // variable for each
+					      // player/state as the
+					      // threat
+
+  // First 2*numStates variables correspond to eq payoffs, second
+  // 2*numStates are threats.
+
+  // Add feasibility constraints.
+  for (int state = 0; state < game.getNumStates(); state++)
+    {
+      // Equilibrium payoffs
+      for (int dir = 0; dir < numDirections; dir++)
+	{
+	  SGLinExpr lhs;
+	  lhs.add(2*state,directions[dir][0]);
+	  lhs.add(2*state+1,directions[dir][1]);
+	  model.addConstraint(lhs,SGLP::LESSEQUAL,bounds[state][dir]);
+	} // direction
+
+      // Threat points
+      for (int dir = 0; dir < numDirections; dir++)
+	{
+	  SGLinExpr lhs;
+	  lhs.add(2*game.getNumStates()+2*state,directions[dir][0]);
+	  lhs.add(2*game.getNumStates()+2*state+1,directions[dir][1]);
+	  model.addConstraint(lhs,SGLP::LESSEQUAL,bounds[state][dir]);
+	} // direction
+    } // state
+} // buildModel
+
+double SGJYCSolver::iterate()
+{
+  int numStates = game.getNumStates();
+  int threads = numWorkers;
+
+  if (method == SG_SWEEP)
+    sweepStates();
+
+  // Each thread raises its own copy of the new bounds, and the
+  // copies are combined at the end.
+  vector< vector< vector<double> > >
+    threadBounds(threads,
+		 vector< vector<double> >(numStates,
+					  vector<double>(numDirections,
+							 -numeric_limits<double>::max())));
+
+  if (method == SG_LINEARPROGRAM)
+    {
+      // Update feasibility constraints.
+      for (int thread = 0; thread < threads; thread++)
+	{
+	  SGLP & model = *models[thread];
+	  for (int state = 0; state < numStates; state++)
 	    {
-	      GRBLinExpr obj = 0;
-	      for (int sp = 0; sp < numStates; sp++)
-		{
-		  for (int player = 0; player < 2; player++)
-		    obj += directions[dir][player]*prob[state][action][sp]
-		      *var[2*sp+player];
-		  
-		}
-	      
-	      model.setObjective(obj);
-	      model.getEnv().set(GRB_IntParam_OutputFlag,0);
-	      model.set(GRB_IntAttr_ModelSense,-1); // maximize
-	      model.optimize();
-
-	      if (model.get(GRB_IntAttr_Status)==GRB_OPTIMAL)
+	      for (int dir = 0; dir < numDirections; dir++)
 		{
-		  double val = (1-delta)*payoffs[state][action]*directions[dir]
-		    + delta * model.get(GRB_DoubleAttr_ObjVal);
-
-		  if (val > newBounds[state][dir])
-		    newBounds[state][dir] = val;
-		}
-	      else
-		break;
-	    } // direction
-
-	  // Remove IC constraints.
-	  constr = model.getConstrs();
-	  for (int constrCtr = 2*numStates*numDirections; 
-	       constrCtr < model.get(GRB_IntAttr_NumConstrs);
-	       constrCtr++)
-	    model.remove(constr[constrCtr]);
-
-	  model.update();
-	  // delete[] constr;
-	} // action
-    } // state
+		  model.setRHS(2*state*numDirections+dir,bounds[state][dir]);
+		  model.setRHS((2*state+1)*numDirections+dir,bounds[state][dir]);
+		} // direction
+	    } // state
+	} // thread
+    }
 
-  delete[] var;
+  // Actions have different numbers of incentive constraints, so
+  // threads take the next unsolved action rather than a fixed block
+  // of actions.
+  parallelFor(eqActions.size(),threads,[&](int k, int thread)
+	      {
+		if (method == SG_SWEEP)
+		  sweepAction(eqActions[k].first,eqActions[k].second,
+			      threadBounds[thread]);
+		else
+		  solveAction(*models[thread],eqActions[k].first,
+			      eqActions[k].second,threadBounds[thread]);
+	      });
+
+  vector< vector<double> > & newBounds = threadBounds[0];
+  for (int thread = 1; thread < threads; thread++)
+    {
+      for (int state = 0; state < numStates; state++)
+	{
+	  for (int dir = 0; dir < numDirections; dir++)
+	    newBounds[state][dir] = std::max(newBounds[state][dir],
+					     threadBounds[thread][state][dir]);
+	} // state
+    } // thread
 
   double dist = 0.0;
   for (int state = 0; state < numStates; state++)
@@ -315,4 +514,403 @@ double SGJYCSolver::iterate()
   return dist;
 } // iterate
 
-#endif 
+void SGJYCSolver::solveAction(SGLP & model, int state, int action,
+			      vector< vector<double> > & newBounds)
+{
+  const vector< vector< SGPoint> > & payoffs = game.getPayoffs();
+  const vector< vector< vector<double> > > & prob = game.getProbabilities();
+  int numStates = game.getNumStates();
+  double delta = game.getDelta();
+  int numFeasConstrs = 2*numStates*numDirections;
+
+  // Implement incentive constraints for this action
+  const vector<SGLinExpr> & ics = icConstraints[state][action];
+  for (int k = 0; k < ics.size(); k++)
+    model.addConstraint(ics[k],SGLP::GREATEREQUAL,0.0);
+
+  // Restart from the last iteration's basis.
+  if (!bases[state][action].empty())
+    model.setBasis(bases[state][action]);
+
+  for (int dir = 0; dir < numDirections; dir++)
+    {
+      SGLinExpr obj;
+      for (int sp = 0; sp < numStates; sp++)
+	{
+	  for (int player = 0; player < 2; player++)
+	    obj.add(2*sp+player,
+		    directions[dir][player]*prob[state][action][sp]);
+	}
+
+      model.setObjective(obj,true); // maximize
+
+      if (model.solve()==SGLP::OPTIMAL)
+	{
+	  double val = (1-delta)*payoffs[state][action]*directions[dir]
+	    + delta * model.getObjectiveValue();
+
+	  if (val > newBounds[state][dir])
+	    newBounds[state][dir] = val;
+
+	  if (dir == 0)
+	    model.getBasis(bases[state][action]);
+	}
+      else
+	{
+	  bases[state][action].clear();
+	  break;
+	}
+    } // direction
+
+  // Remove IC constraints.
+  model.removeConstraints(numFeasConstrs,
+			  model.getNumConstraints()-numFeasConstrs);
+} // solveAction
+
+int SGJYCSolver::refineDirections()
+{
+  int numStates = game.getNumStates();
+  if (numDirections >= maxDirections)
+    return 0;
+
+  // vertices[state][dir] is where the bounds of dir and dir+1 meet.
+  vector< vector<SGPoint> > vertices(numStates);
+  vector<bool> feasible(numStates,true);
+  vector<double> errors(numDirections,0.0);
+  for (int state = 0; state < numStates; state++)
+    {
+      for (int dir = 0; dir < numDirections; dir++)
+	{
+	  if (bounds[state][dir] == -numeric_limits<double>::max())
+	    feasible[state] = false;
+	}
+      if (!feasible[state])
+	continue;
+
+      for (int dir = 0; dir < numDirections; dir++)
+	{
+	  int next = (dir+1)%numDirections;
+	  vertices[state].push_back(intersectLines(directions[dir],
+						   bounds[state][dir],
+						   directions[next],
+						   bounds[state][next]));
+	}
+
+      for (int dir = 0; dir < numDirections; dir++)
+	{
+	  const SGPoint & vertex = vertices[state][dir];
+	  const SGPoint & prev
+	    = vertices[state][(dir+numDirections-1)%numDirections];
+	  const SGPoint & next = vertices[state][(dir+1)%numDirections];
+
+	  // Distance from vertex to the segment from prev to next.
+	  SGPoint chord = next-prev;
+	  double length2 = chord*chord;
+	  double t = (length2 > 0? (vertex-prev)*chord/length2: 0);
+	  t = std::max(0.0,std::min(1.0,t));
+	  SGPoint gap = vertex-(prev+t*chord);
+	  errors[dir] = std::max(errors[dir],gap.norm());
+	} // dir
+    } // state
+
+  vector< pair<double,int> > candidates;
+  for (int dir = 0; dir < numDirections; dir++)
+    {
+      if (errors[dir] > refineTol)
+	candidates.push_back(make_pair(-errors[dir],dir));
+    }
+  sort(candidates.begin(),candidates.end());
+  if (candidates.size() > maxDirections-numDirections)
+    candidates.resize(maxDirections-numDirections);
+  if (candidates.empty())
+    return 0;
+
+  vector<bool> split(numDirections,false);
+  for (int k = 0; k < candidates.size(); k++)
+    split[candidates[k].second] = true;
+
+  vector<SGPoint> newDirections;
+  vector< vector<double> > newBounds(numStates);
+  for (int dir = 0; dir < numDirections; dir++)
+    {
+      newDirections.push_back(directions[dir]);
+      for (int state = 0; state < numStates; state++)
+	newBounds[state].push_back(bounds[state][dir]);
+
+      if (!split[dir])
+	continue;
+
+      SGPoint bisector = directions[dir]
+	+ directions[(dir+1)%numDirections];
+      bisector.normalize();
+      newDirections.push_back(bisector);
+      for (int state = 0; state < numStates; state++)
+	newBounds[state].push_back(feasible[state]?
+				   bisector*vertices[state][dir]:
+				   -numeric_limits<double>::max());
+    } // dir
+
+  directions = newDirections;
+  bounds = newBounds;
+  numDirections = directions.size();
+
+  // The feasibility constraints and the stored bases depend on the
+  // directions.
+  for (int thread = 0; thread < models.size(); thread++)
+    {
+      models[thread] = std::shared_ptr<SGDefaultLP>(new SGDefaultLP());
+      buildModel(*models[thread]);
+    }
+  for (int state = 0; state < numStates; state++)
+    {
+      for (int action = 0; action < bases[state].size(); action++)
+	bases[state][action].clear();
+    }
+
+  return candidates.size();
+} // refineDirections
+
+void SGJYCSolver::sweepStates()
+{
+  int numStates = game.getNumStates();
+  stateSupport.assign(numStates,vector<double>(numDirections,0));
+  stateThreats.assign(numStates,SGPoint(0,0));
+  statesFeasible = true;
+
+  vector<SGPoint> vertices;
+  for (int state = 0; state < numStates; state++)
+    {
+      if (!intersectHalfPlanes(directions,bounds[state],vertices))
+	{
+	  statesFeasible = false;
+	  return;
+	}
+      polygonSupport(vertices,directions,stateSupport[state]);
+
+      stateThreats[state] = vertices[0];
+      for (int k = 1; k < vertices.size(); k++)
+	{
+	  for (int player = 0; player < 2; player++)
+	    stateThreats[state][player]
+	      = std::min(stateThreats[state][player],vertices[k][player]);
+	}
+    } // state
+} // sweepStates
+
+void SGJYCSolver::sweepAction(int state, int action,
+			      vector< vector<double> > & newBounds) const
+{
+  const vector< vector< SGPoint> > & payoffs = game.getPayoffs();
+  const vector< vector< vector<double> > > & prob = game.getProbabilities();
+  const vector< vector<int> > & numActions = game.getNumActions();
+  int numStates = game.getNumStates();
+  double delta = game.getDelta();
+
+  // Every state's polygon has to be non-empty, as in the linear
+  // program.
+  if (!statesFeasible)
+    return;
+
+  // The expected continuation values form the weighted Minkowski sum
+  // of the states' polygons, whose support function is the weighted
+  // sum of their support functions.
+  vector<double> levels(numDirections,0.0);
+  for (int sp = 0; sp < numStates; sp++)
+    {
+      double p = prob[state][action][sp];
+      if (p == 0)
+	continue;
+      for (int dir = 0; dir < numDirections; dir++)
+	levels[dir] += p*stateSupport[sp][dir];
+    } // sp
+
+  vector<SGPoint> vertices;
+  if (!intersectHalfPlanes(directions,levels,vertices))
+    return;
+
+  // Implement incentive constraints for this action. Player i's
+  // expected continuation value has to be at least the gain from the
+  // best deviation divided by delta, plus the expected threat after
+  // that deviation.
+  vector<int> actions, deviations;
+  indexToVector(action,actions,numActions[state]);
+  for (int player = 0; player < 2; player++)
+    {
+      if (numActions[state][player] < 2)
+	continue;
+
+      deviations = actions;
+      double minIC = -numeric_limits<double>::max();
+      for (int dev = 0; dev < numActions[state][player]; dev++)
+	{
+	  if (dev == actions[player])
+	    continue;
+
+	  deviations[player] = dev;
+	  int deviation = vectorToIndex(deviations,numActions[state]);
+
+	  double threat = 0;
+	  for (int sp = 0; sp < numStates; sp++)
+	    threat += prob[state][deviation][sp]*stateThreats[sp][player];
+
+	  minIC = std::max(minIC,
+			   (1-delta)/delta*(payoffs[state][deviation][player]
+					    -payoffs[state][action][player])
+			   + threat);
+	} // dev
+
+      clipPolygon(vertices,player,minIC);
+      if (vertices.empty())
+	return;
+    } // player
+
+  vector<double> support;
+  polygonSupport(vertices,directions,support);
+  for (int dir = 0; dir < numDirections; dir++)
+    {
+      double val = (1-delta)*payoffs[state][action]*directions[dir]
+	+ delta * support[dir];
+
+      if (val > newBounds[state][dir])
+	newBounds[state][dir] = val;
+    } // direction
+} // sweepAction
+
+bool SGJYCSolver::intersectHalfPlanes(const vector<SGPoint> & normals,
+				      const vector<double> & levels,
+				      vector<SGPoint> & vertices)
+{
+  int n = normals.size();
+  vertices.clear();
+
+  // Intersection of the boundaries of half planes k0 and k1.
+  auto intersect = [&](int k0, int k1)
+    {
+      return intersectLines(normals[k0],levels[k0],
+			    normals[k1],levels[k1]);
+    };
+  // True if point is strictly outside of half plane k.
+  auto outside = [&](int k, const SGPoint & point)
+    {
+      return normals[k]*point > levels[k] + 1e-10*(1+abs(levels[k]));
+    };
+
+  // The half planes are already sorted by angle, so one pass with a
+  // double ended queue removes the redundant ones.
+  vector<int> queue(n);
+  int front = 0, back = 0;
+  for (int k = 0; k < n; k++)
+    {
+      while (back-front > 1
+	     && outside(k,intersect(queue[back-2],queue[back-1])))
+	back--;
+      while (back-front > 1
+	     && outside(k,intersect(queue[front],queue[front+1])))
+	front++;
+
+      if (back-front > 0)
+	{
+	  const SGPoint & last = normals[queue[back-1]];
+	  if (abs(last[0]*normals[k][1]-last[1]*normals[k][0]) < 1e-12)
+	    {
+	      // Opposite half planes with nothing in between, so the
+	      // intersection is at most a line.
+	      if (last*normals[k] < 0)
+		return false;
+	      // Same direction, so only the tighter one matters.
+	      if (levels[k] < levels[queue[back-1]])
+		queue[back-1] = k;
+	      continue;
+	    }
+	}
+      queue[back++] = k;
+    } // for k
+
+  while (back-front > 2
+	 && outside(queue[front],intersect(queue[back-2],queue[back-1])))
+    back--;
+  while (back-front > 2
+	 && outside(queue[back-1],intersect(queue[front],queue[front+1])))
+    front++;
+
+  if (back-front < 3)
+    return false;
+
+  for (int k = front; k < back; k++)
+    vertices.push_back(intersect(queue[k],
+				 queue[k+1 < back? k+1: front]));
+  return true;
+} // intersectHalfPlanes
+
+SGPoint SGJYCSolver::intersectLines(const SGPoint & normal0, double level0,
+				    const SGPoint & normal1, double level1)
+{
+  double det = normal0[0]*normal1[1]-normal0[1]*normal1[0];
+  return SGPoint((level0*normal1[1]-level1*normal0[1])/det,
+		 (normal0[0]*level1-normal1[0]*level0)/det);
+} // intersectLines
+
+void SGJYCSolver::polygonSupport(const vector<SGPoint> & vertices,
+				 const vector<SGPoint> & directions,
+				 vector<double> & support)
+{
+  int numVertices = vertices.size();
+  support.assign(directions.size(),-numeric_limits<double>::max());
+  if (numVertices == 0)
+    return;
+
+  int best = 0;
+  for (int v = 1; v < numVertices; v++)
+    {
+      if (vertices[v]*directions[0] > vertices[best]*directions[0])
+	best = v;
+    }
+
+  for (int dir = 0; dir < directions.size(); dir++)
+    {
+      // Walk forward from the last maximizer until the value drops,
+      // stepping over vertices that tie up to rounding errors. Many
+      // bounds can pass through the same corner, and the vertices
+      // computed from nearly parallel pairs of them differ by much
+      // more than machine precision.
+      double bestVal = vertices[best]*directions[dir];
+      int current = best;
+      for (int step = 1; step < numVertices; step++)
+	{
+	  current = (current+1)%numVertices;
+	  double val = vertices[current]*directions[dir];
+	  if (val < bestVal - 1e-9*(1+abs(bestVal)))
+	    break;
+	  if (val > bestVal)
+	    {
+	      best = current;
+	      bestVal = val;
+	    }
+	}
+      support[dir] = bestVal;
+    } // for dir
+} // polygonSupport
+
+void SGJYCSolver::clipPolygon(vector<SGPoint> & vertices,
+			      int coord, double level)
+{
+  double tol = 1e-10*(1+abs(level));
+  vector<SGPoint> clipped;
+  for (int v = 0; v < vertices.size(); v++)
+    {
+      const SGPoint & p = vertices[v];
+      const SGPoint & q = vertices[(v+1)%vertices.size()];
+      bool pInside = p[coord] >= level - tol;
+      bool qInside = q[coord] >= level - tol;
+      if (pInside)
+	clipped.push_back(p);
+      if (pInside != qInside)
+	{
+	  double t = (level-p[coord])/(q[coord]-p[coord]);
+	  clipped.push_back(p + t*(q-p));
+	}
+    } // for v
+  vertices.swap(clipped);
+} // clipPolygon
+
+#endif
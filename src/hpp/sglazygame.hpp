@@ -0,0 +1,129 @@
+// This file is part of the SGSolve library for stochastic games
+// Copyright (C) 2016 Benjamin A. Brooks
+// 
+// SGSolve free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// SGSolve is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see
+// <http://www.gnu.org/licenses/>.
+// 
+// Benjamin A. Brooks
+// ben@benjaminbrooks.net
+// Chicago, IL
+
+#ifndef _SGLAZYGAME_HPP
+#define _SGLAZYGAME_HPP
+
+#include "sgcommon.hpp"
+#include "sgexception.hpp"
+#include "sggameaccessor.hpp"
+#include "sgabstractgame.hpp"
+#include <unordered_map>
+
+//! A game whose transition probabilities are generated on demand
+/*! SGLazyGame keeps a reference to an SGAbstractGame and computes
+    rows of transition probabilities only when SGApprox or SGAction
+    asks for them. The most recently used rows are kept in a cache of
+    at most cacheSize rows, so that memory scales with the set of
+    action profiles that the algorithm is working with rather than
+    with the size of the whole game. This is useful when
+    probabilities[s][a][s'] would be too large to store as in SGGame.
+
+    Payoffs are tabulated when the object is constructed, since they
+    are needed for the payoff bounds anyway and take up only one
+    SGPoint per action profile.
+
+    The referenced SGAbstractGame must outlive the SGLazyGame. The
+    cache is updated by const methods, so an SGLazyGame should not be
+    shared between threads.
+
+  \ingroup src
+ */
+class SGLazyGame : public SGGameAccessor
+{
+private:
+  const SGAbstractGame & game; /*!< The game that generates the
+                                  primitives. */
+  double delta; /*!< The discount factor. */
+  int numPlayers; /*!< The number of players, always 2. */
+  int numStates; /*!< The number of states. */
+  vector< vector<int> > numActions; /*!< Numbers of each player's
+                                       actions in each state. */
+  vector<int> numActions_total; /*!< Total number of action profiles
+                                   for each state. */
+  vector<long> actionOffsets; /*!< Linear index of the first action
+                                profile of each state, used as the
+                                key of the row cache. */
+  vector< vector<SGPoint> > payoffs; /*!< Payoffs of each action
+                                        profile. */
+  vector< list<int> > eqActions; /*!< Action profiles that can be
+                                    played in equilibrium. */
+  vector<bool> unconstrained; /*!< Flags for players that are not
+                                 incentive constrained. */
+  SGPoint payoffUB; /*!< Upper bound on payoffs. */
+  SGPoint payoffLB; /*!< Lower bound on payoffs. */
+
+  int cacheSize; /*!< Maximum number of cached rows. */
+  //! Cached rows, most recently used first
+  mutable list< pair<long,vector<double> > > rows;
+  //! Position of each cached row in SGLazyGame::rows
+  mutable unordered_map<long, list< pair<long,vector<double> > >::iterator> rowIndex;
+  mutable long numRowEvaluations; /*!< Number of rows computed by the
+                                     SGAbstractGame. */
+
+public:
+  //! Constructor
+  /*! Tabulates payoffs and equilibrium actions of game, and sets the
+      capacity of the row cache to _cacheSize rows. */
+  SGLazyGame(const SGAbstractGame & _game, int _cacheSize = 10000);
+
+  //! Returns the discount factor
+  double getDelta() const { return delta; }
+  //! Returns the number of players (always 2)
+  int getNumPlayers() const { return numPlayers; }
+  //! Returns the number of states
+  int getNumStates() const { return numStates; }
+  //! Returns the number of each player's actions in each state
+  const vector< vector<int> > & getNumActions() const
+  { return numActions; }
+  //! Returns the total number of action profiles in each state
+  const vector<int> & getNumActions_total() const
+  { return numActions_total; }
+  //! Returns the action profiles that can be played in equilibrium
+  const vector< list<int> > & getEquilibriumActions() const
+  { return eqActions; }
+  //! Returns the vector of flags for unconstrained players
+  const vector<bool> & getConstrained() const
+  { return unconstrained; }
+  //! Sets the arguments equal to tight upper and lower bounds on the
+  //! payoffs, respectively.
+  void getPayoffBounds(SGPoint & UB, SGPoint & LB) const
+  { UB = payoffUB; LB = payoffLB; }
+  //! Returns the payoffs of the given action profile
+  const SGPoint & getPayoff(int state, int action) const
+  { return payoffs[state][action]; }
+  //! Returns the transition probabilities of the given action profile
+  /*! Returns the cached row if there is one. Otherwise, the row is
+      computed with SGAbstractGame::probabilities and the least
+      recently used row is evicted if the cache is full. */
+  const vector<double> & getTransitions(int state, int action) const;
+
+  //! Returns the maximum number of cached rows
+  int getCacheSize() const { return cacheSize; }
+  //! Returns the number of rows that have been computed so far
+  long getNumRowEvaluations() const { return numRowEvaluations; }
+  //! Sets the maximum number of cached rows
+  bool setCacheSize(int newCacheSize);
+  //! Empties the row cache
+  void clearCache() const;
+};
+
+#endif
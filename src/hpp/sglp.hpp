@@ -0,0 +1,208 @@
+// This file is part of the SGSolve library for stochastic games
+// Copyright (C) 2016 Benjamin A. Brooks
+// 
+// SGSolve free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// SGSolve is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see
+// <http://www.gnu.org/licenses/>.
+// 
+// Benjamin A. Brooks
+// ben@benjaminbrooks.net
+// Chicago, IL
+
+#ifndef _SGLP_HPP
+#define _SGLP_HPP
+
+#include "sgcommon.hpp"
+
+class SGLP;
+
+//! A linear expression in the variables of an SGLP
+/*! Stores a constant plus a list of (variable,coefficient)
+    terms. The same variable may appear in several terms, in which
+    case the coefficients are added together when the expression is
+    passed to an SGLP.
+
+  \ingroup src
+ */
+class SGLinExpr
+{
+public:
+  vector<int> vars; /*!< Indices of the variables in each term. */
+  vector<double> coefs; /*!< Coefficients of each term. */
+  double constant; /*!< The constant term. */
+
+  //! Constructor
+  SGLinExpr(double _constant = 0.0): constant(_constant) {}
+
+  //! Adds coef times variable var to the expression
+  void add(int var, double coef)
+  {
+    vars.push_back(var);
+    coefs.push_back(coef);
+  }
+  //! Adds another expression scaled by coef
+  void add(const SGLinExpr & expr, double coef = 1.0)
+  {
+    for (int k = 0; k < expr.vars.size(); k++)
+      add(expr.vars[k],coef*expr.coefs[k]);
+    constant += coef*expr.constant;
+  }
+  //! Adds a constant
+  SGLinExpr & operator+=(double c)
+  {
+    constant += c;
+    return *this;
+  }
+  //! Removes all terms and sets the constant to zero
+  void clear()
+  {
+    vars.clear();
+    coefs.clear();
+    constant = 0.0;
+  }
+  //! Returns the number of terms
+  int size() const { return vars.size(); }
+  //! Evaluates the expression at the last solution of lp
+  double getValue(const SGLP & lp) const;
+};
+
+//! Abstract interface to a linear programming backend
+/*! SGJYCSolver and SGSolver_V3 formulate their subproblems through
+    this interface, so that they do not depend on a particular LP
+    solver. Variables and constraints are referred to by the indices
+    returned when they are added. Each constraint is of the form
+    expr (sense) rhs, and variables have lower and upper bounds that
+    may be infinite.
+
+    Implementations are expected to keep the optimal basis between
+    calls to solve, so that re-solving after changing the right hand
+    sides, bounds, or objective starts from the previous
+    solution. SGSimplex is the implementation that is bundled with
+    the library, and SGGurobiLP wraps Gurobi when it is available.
+
+  \ingroup src
+ */
+class SGLP
+{
+public:
+  //! Senses of constraints
+  enum Sense
+    {
+      LESSEQUAL, /*!< expr <= rhs */
+      GREATEREQUAL, /*!< expr >= rhs */
+      EQUAL /*!< expr == rhs */
+    };
+  //! Outcomes of SGLP::solve
+  enum Status
+    {
+      OPTIMAL, /*!< An optimal solution was found. */
+      INFEASIBLE, /*!< The constraints cannot be satisfied. */
+      UNBOUNDED, /*!< The objective is unbounded. */
+      ITERATION_LIMIT, /*!< The iteration limit was reached. */
+      NOT_SOLVED /*!< The model has not been solved since it was last
+		    changed, or the backend failed. */
+    };
+  //! Status of a variable in the optimal basis
+  /*! The values are the same as those of Gurobi's VBasis
+      attribute. */
+  enum BasisStatus
+    {
+      BASIC = 0, /*!< The variable is basic. */
+      AT_LOWER = -1, /*!< Nonbasic at its lower bound. */
+      AT_UPPER = -2, /*!< Nonbasic at its upper bound. */
+      SUPERBASIC = -3 /*!< Nonbasic and free, with value zero. */
+    };
+
+  //! Bounds with at least this magnitude are treated as infinite
+  static constexpr double INF = 1e30;
+
+  virtual ~SGLP() {}
+
+  //! Adds num variables with the given bounds
+  /*! Returns the index of the first new variable. The new variables
+      have objective coefficients of zero. */
+  virtual int addVariables(int num, double lb = 0.0, double ub = INF) = 0;
+  //! Adds the constraint expr (sense) rhs
+  /*! The constant of expr is moved to the right hand side. Returns
+      the index of the new constraint. */
+  virtual int addConstraint(const SGLinExpr & expr, Sense sense,
+			    double rhs) = 0;
+  //! Removes num constraints starting at first
+  /*! The indices of the constraints that follow are decreased by
+      num. */
+  virtual void removeConstraints(int first, int num) = 0;
+  //! Sets the right hand side of a constraint
+  virtual void setRHS(int constr, double rhs) = 0;
+  //! Sets the bounds of a variable
+  virtual void setBounds(int var, double lb, double ub) = 0;
+  //! Sets the objective
+  /*! Replaces the objective with expr, to be maximized if maximize
+      is true and minimized otherwise. */
+  virtual void setObjective(const SGLinExpr & expr, bool maximize) = 0;
+
+  //! Solves the model
+  /*! Starts from the basis of the previous solve when there is one. */
+  virtual Status solve() = 0;
+
+  //! Returns the number of variables
+  virtual int getNumVariables() const = 0;
+  //! Returns the number of constraints
+  virtual int getNumConstraints() const = 0;
+  //! Returns the lower bound of a variable
+  virtual double getLowerBound(int var) const = 0;
+  //! Returns the upper bound of a variable
+  virtual double getUpperBound(int var) const = 0;
+  //! Returns the status of the last solve
+  virtual Status getStatus() const = 0;
+  //! Returns the optimal objective value
+  virtual double getObjectiveValue() const = 0;
+  //! Returns the optimal value of a variable
+  virtual double getValue(int var) const = 0;
+  //! Returns the basis status of a variable
+  /*! Returns one of the values of SGLP::BasisStatus. */
+  virtual int getBasisStatus(int var) const = 0;
+  //! Right hand side ranging
+  /*! Sets low and high to the smallest and largest right hand sides
+      of the given constraint for which the optimal basis stays
+      primal feasible, and hence optimal. */
+  virtual void getRHSRange(int constr, double & low, double & high) const = 0;
+  //! Returns the current basis
+  /*! Sets basis to the SGLP::BasisStatus of every variable, followed
+      by the status of the slack of every constraint. A constraint
+      whose slack is BASIC need not be binding. */
+  virtual void getBasis(vector<int> & basis) const = 0;
+  //! Sets the basis from which the next solve starts
+  /*! The argument has the layout that is returned by
+      SGLP::getBasis. This is the way to warm start a model whose
+      constraints have been removed and added back since the basis
+      was recorded. Throws an exception if the size of basis does
+      not match the model. */
+  virtual void setBasis(const vector<int> & basis) = 0;
+
+  //! Sets the lower bound of a variable
+  void setLowerBound(int var, double lb)
+  { setBounds(var,lb,getUpperBound(var)); }
+  //! Sets the upper bound of a variable
+  void setUpperBound(int var, double ub)
+  { setBounds(var,getLowerBound(var),ub); }
+};
+
+inline double SGLinExpr::getValue(const SGLP & lp) const
+{
+  double value = constant;
+  for (int k = 0; k < vars.size(); k++)
+    value += coefs[k]*lp.getValue(vars[k]);
+  return value;
+} // getValue
+
+#endif
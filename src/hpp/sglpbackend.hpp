@@ -0,0 +1,39 @@
+// This file is part of the SGSolve library for stochastic games
+// Copyright (C) 2016 Benjamin A. Brooks
+// 
+// SGSolve free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// SGSolve is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see
+// <http://www.gnu.org/licenses/>.
+// 
+// Benjamin A. Brooks
+// ben@benjaminbrooks.net
+// Chicago, IL
+
+#ifndef _SGLPBACKEND_HPP
+#define _SGLPBACKEND_HPP
+
+//! \file sglpbackend.hpp Selects the LP solver used by SGJYCSolver
+//! and SGSolver_V3.
+/*! SGDefaultLP is SGSimplex, which is part of libsg. Compiling with
+    SGGUROBI defined switches it to SGGurobiLP, in which case the
+    program has to be linked against Gurobi. */
+
+#ifdef SGGUROBI
+#include "sggurobilp.hpp"
+typedef SGGurobiLP SGDefaultLP;
+#else
+#include "sgsimplex.hpp"
+typedef SGSimplex SGDefaultLP;
+#endif
+
+#endif
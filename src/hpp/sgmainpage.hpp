@@ -179,6 +179,17 @@
   algorithm of Judd, Yeltekin, and Conklin (2003) that was implemented
   using Gurobi.
 
+  Finally, sgsolve.cpp builds a command line program that solves games
+  saved with SGGame::save without writing any code. Parameters can be
+  given on the command line or in a config file, many games can be
+  listed in a manifest and solved concurrently, and a CSV or JSON
+  record with the timing and convergence of each solve is written to
+  standard output, e.g.,
+
+  \code
+  sgsolve --param errorTol=1e-9 --stats json --output-dir out pd.sgm
+  \endcode
+
   \section conclusionsec Final thoughts
 
   The package has many more features that the user will no doubt
@@ -405,6 +416,17 @@
   (SGSolution::load). See risksharing.cpp for an example of how these
   are used. Serialized SGSolution objects can be loaded by SGViewer.
 
+  \section srccapisec Calling the library from other languages
+
+  The header sgcapi.h declares a C interface to the library, for use
+  from languages that can call C functions, such as Python (through
+  ctypes or cffi) or Julia (through ccall). Games, SGEnv parameters,
+  solvers, and solutions are represented by opaque handles, and games
+  and results are passed in and out as flat arrays in buffers provided
+  by the caller. Parameters are set by name, using the names in
+  SGEnv::getParamTable. Calling "make shared" in the lib directory
+  builds the shared library lib/shared/libsg.so.
+
   \section srcfurthertopics Further topics
   
   A brief comment is in order on the style in which the package is
@@ -464,14 +486,16 @@
   payoff tables, the model is SGPayoffTableModel, which adds methods
   for generating header data to indicate action profiles and also
   defines setData/getData methods for interfacing with the SGGame
-  object. For probability tables, the model is
-  SGProbabilityTableModel, which derives from SGPayoffTableModel. This
-  class adds a new data member, which is the tomorrow's state, and
-  redefines setData and getData to access the relevant probability
-  data in SGGame. When the current state is changed by the user,
-  SGGameHandler simply updates the state parameters of all of the
-  table models and sends out signals to update the displayed
-  data. 
+  object. The transition probabilities of the current state are shown
+  in a single table, whose model is SGProbabilityTableModel. Its rows
+  are action profiles and its columns are tomorrow's states, and it
+  reads the probabilities from SGGame only when the view asks for
+  them, so large games can be edited without building a table for
+  every state. Zero probabilities are left blank, and the columns can
+  optionally be restricted to the states that are reachable from the
+  current state. When the current state is changed by the user,
+  SGGameHandler simply updates the state parameters of the table
+  models and sends out signals to update the displayed data. 
 
   The game tab also has controls for changing the numbers of actions
   and states. When these options are selected, SGGameHandler simply
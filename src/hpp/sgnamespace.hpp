@@ -134,6 +134,10 @@ namespace SG
       TUPLERESERVESIZE, /*!< The amount by which the extremeTuples
                           member of SGApproximation is incremented
                           when the capacity is reached. */
+      PRUNEPASSES, /*!< Maximum number of passes of the bounds-based
+                     action elimination that SGApprox::initialize
+                     carries out before the first iteration. Zero
+                     disables the elimination. */
       NUMINTPARAMS /*!< Used internally to indicate the number of
 		     enumerated int parameters. */
     };
@@ -0,0 +1,207 @@
+// This file is part of the SGSolve library for stochastic games
+// Copyright (C) 2016 Benjamin A. Brooks
+// 
+// SGSolve free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// SGSolve is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see
+// <http://www.gnu.org/licenses/>.
+// 
+// Benjamin A. Brooks
+// ben@benjaminbrooks.net
+// Chicago, IL
+
+#ifndef _SGSIMPLEX_HPP
+#define _SGSIMPLEX_HPP
+
+#include "sgcommon.hpp"
+#include "sglp.hpp"
+#include "sgexception.hpp"
+
+//! The LP solver that is bundled with SGSolve
+/*! A bounded variable revised simplex method. The constraint matrix
+    is stored by columns in sparse form, and the inverse of the basis
+    matrix is stored densely and updated in product form after each
+    pivot. It is recomputed from scratch every refactorFrequency
+    pivots, or when constraints are added or removed.
+
+    Every constraint i has a logical variable r_i equal to its left
+    hand side, whose bounds encode the sense and the right hand side,
+    so that the model is always of the form A x - r = 0 with bounds
+    on x and r. The basis of the last solve is kept, which makes the
+    following warm starts cheap:
+    - After right hand sides or bounds change, the old basis is still
+      dual feasible, and the dual simplex method is used to restore
+      primal feasibility.
+    - After the objective changes, the old basis is still primal
+      feasible, and the primal simplex method picks up from there.
+    Otherwise, the primal simplex method minimizes the sum of
+    infeasibilities before optimizing the objective.
+
+  \ingroup src
+ */
+class SGSimplex : public SGLP
+{
+private:
+  int numVars; /*!< Number of structural variables. */
+  int numConstrs; /*!< Number of constraints. */
+
+  vector<double> lower; /*!< Lower bounds of the structural
+                           variables. */
+  vector<double> upper; /*!< Upper bounds of the structural
+                           variables. */
+  vector<double> cost; /*!< Objective coefficients of the structural
+                          variables. */
+  double objConstant; /*!< Constant term of the objective. */
+  bool maximize; /*!< True if the objective is maximized. */
+
+  vector< vector<int> > colRows; /*!< colRows[j] are the constraints
+                                    in which variable j has a nonzero
+                                    coefficient. */
+  vector< vector<double> > colVals; /*!< colVals[j] are the
+                                       corresponding coefficients. */
+
+  vector<Sense> senses; /*!< Senses of the constraints. */
+  vector<double> rhs; /*!< Right hand sides of the constraints. */
+  vector<double> rowLower; /*!< Lower bounds of the logical
+                              variables. */
+  vector<double> rowUpper; /*!< Upper bounds of the logical
+                              variables. */
+
+  vector<double> x; /*!< Values of the structural variables,
+                       followed by the logical variables. */
+  vector<int> varStatus; /*!< SGLP::BasisStatus of each structural
+                            and logical variable. */
+  vector<int> head; /*!< head[p] is the variable in position p of the
+                       basis. */
+  vector<double> Binv; /*!< Inverse of the basis matrix, stored by
+                          rows. */
+  bool factorValid; /*!< False if Binv and head have to be rebuilt
+                       from varStatus. */
+  int pivotsSinceFactor; /*!< Number of product form updates applied
+                            to Binv. */
+
+  Status status; /*!< Status of the last solve. */
+  double objValue; /*!< Objective value of the last solve. */
+  int numIterations; /*!< Simplex iterations in the last solve. */
+  int iterationLimit; /*!< Maximum iterations in one solve. */
+  int refactorFrequency; /*!< Pivots between refactorizations. */
+  double feasTol; /*!< Primal feasibility tolerance. */
+  double optTol; /*!< Dual feasibility tolerance. */
+  double pivotTol; /*!< Smallest admissible pivot element. */
+  double maxCost; /*!< Largest objective coefficient in absolute
+                     value. */
+  double scaledOptTol; /*!< Dual feasibility tolerance used by the
+                          current solve, which is optTol or a small
+                          multiple of maxCost, whichever is
+                          larger. */
+
+  //! Lower bound of structural or logical variable j
+  double lb(int j) const
+  { return j < numVars? lower[j]: rowLower[j-numVars]; }
+  //! Upper bound of structural or logical variable j
+  double ub(int j) const
+  { return j < numVars? upper[j]: rowUpper[j-numVars]; }
+  //! Objective coefficient of variable j, in minimization form
+  double phaseTwoCost(int j) const
+  { return j < numVars? (maximize? -cost[j]: cost[j]): 0.0; }
+  //! Sets the bounds of the logical variable of constraint i
+  void setRowBounds(int i);
+  //! Computes w = Binv times the column of variable j
+  void ftran(int j, vector<double> & w) const;
+  //! Inner product of y with the column of variable j
+  double dotColumn(const double * y, int j) const;
+  //! Computes y = cB' times Binv
+  void btran(const vector<double> & cB, vector<double> & y) const;
+  //! Moves a nonbasic variable to the bound given by its status
+  void placeNonbasic(int j);
+  //! Rebuilds head and Binv from varStatus
+  /*! Basic variables whose columns are dependent are made nonbasic,
+      and the logicals of uncovered constraints are made basic in
+      their place. */
+  void factorize();
+  //! Recomputes the values of the basic variables
+  void computePrimal();
+  //! Replaces the variable in basis position r with variable q
+  void pivot(int r, int q, const vector<double> & w);
+  //! Returns true if the basic variables are within bounds
+  bool primalFeasible() const;
+  //! Returns true if the reduced costs have the optimal signs
+  bool dualFeasible();
+  //! Primal simplex method
+  Status primal();
+  //! Dual simplex method
+  Status dual();
+  
+public:
+  //! Constructor
+  SGSimplex():
+    numVars(0),
+    numConstrs(0),
+    objConstant(0),
+    maximize(false),
+    factorValid(false),
+    pivotsSinceFactor(0),
+    status(NOT_SOLVED),
+    objValue(0),
+    numIterations(0),
+    iterationLimit(1000000),
+    refactorFrequency(100),
+    feasTol(1e-9),
+    optTol(1e-9),
+    pivotTol(1e-9),
+    maxCost(0),
+    scaledOptTol(1e-9)
+  {}
+
+  int addVariables(int num, double lb = 0.0, double ub = INF);
+  int addConstraint(const SGLinExpr & expr, Sense sense, double rhs);
+  void removeConstraints(int first, int num);
+  void setRHS(int constr, double rhs);
+  void setBounds(int var, double lb, double ub);
+  void setObjective(const SGLinExpr & expr, bool maximize);
+
+  Status solve();
+
+  int getNumVariables() const { return numVars; }
+  int getNumConstraints() const { return numConstrs; }
+  double getLowerBound(int var) const { return lower[var]; }
+  double getUpperBound(int var) const { return upper[var]; }
+  Status getStatus() const { return status; }
+  double getObjectiveValue() const { return objValue; }
+  double getValue(int var) const { return x[var]; }
+  int getBasisStatus(int var) const { return varStatus[var]; }
+  void getRHSRange(int constr, double & low, double & high) const;
+  void getBasis(vector<int> & basis) const { basis = varStatus; }
+  void setBasis(const vector<int> & basis);
+
+  //! Returns the number of simplex iterations in the last solve
+  int getNumIterations() const { return numIterations; }
+  //! Sets the maximum number of iterations in one solve
+  bool setIterationLimit(int limit)
+  {
+    if (limit < 1)
+      return false;
+    iterationLimit = limit;
+    return true;
+  }
+  //! Sets the primal and dual feasibility tolerances
+  bool setTolerances(double _feasTol, double _optTol)
+  {
+    if (_feasTol <= 0 || _optTol <= 0)
+      return false;
+    feasTol = _feasTol;
+    optTol = _optTol;
+    return true;
+  }
+};
+
+#endif
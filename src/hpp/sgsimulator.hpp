@@ -23,9 +23,13 @@
 #define _SGSIMULATOR_HPP
 
 #include "sgsolution.hpp"
+#include "sgutilities.hpp"
 #include <chrono>
 #include <random>
 #include <utility>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
 
 
 //! Class for forward simulating equilibria
@@ -52,15 +56,18 @@
   Having constructed the transition table, the equilibrium can be
   forward simulated using SGSimulator::simulate. The arguments to the
   simulate method are the number of periods for which to simulate, the
-  initial state, and the initial tuple. When forward simulating, the
-  class keeps track of the distributions of tuples (in the final
-  revolution), states, and actions in each state. These can be
-  retrieved using their various get
-  methods. SGSimulator::getLongRunPayoffs will compute average payoffs
-  for the players over the course of the simulation. The class will
-  save a text version of the transition table in transitionTableSS,
-  and it will save a text version of the first 200 periods of the
-  simulation in SS. 
+  initial state, and the initial tuple. The simulations are
+  independent, so an overload of SGSimulator::simulate runs them on
+  several threads, reports progress to a callback while the
+  distributions fill in, and can be canceled from that callback. When
+  forward simulating, the class keeps track of the distributions of
+  tuples (in the final revolution), states, and actions in each state.
+  These can be retrieved using their various get methods.
+  SGSimulator::getLongRunPayoffs will compute average payoffs for the
+  players over the course of the simulation. The class will save a
+  text version of the transition table in transitionTableSS, and it
+  will save a text version of the first 200 periods of the simulation
+  in SS. 
 
   TODO: Refine the procedure for constructing the transition table
   when both incentive constraints bind.
@@ -116,6 +123,19 @@ private:
   //! Contains a text description of the transition table.
   std::stringstream transitionTableSS;
   
+  //! Runs one simulation and adds its frequencies to the counts.
+  /*! Does not change any member other than ss, which is only written
+      for simulation 0, so different simulations can run on different
+      threads. Stops early if canceled becomes true. */
+  void simulateOne(int sim,
+		   int initialState,
+		   list<SGIteration>::const_iterator initialTupleIt,
+		   std::default_random_engine & generator,
+		   vector<int> & stateCounts,
+		   vector<int> & tupleCounts,
+		   vector< vector<int> > & actionCounts,
+		   const std::atomic<bool> & canceled);
+
 public:
   //! Constructor
   SGSimulator(const SGSolution & _soln): 
@@ -148,10 +168,36 @@ public:
   //! Forward simulates the equilibrium.
   void simulate(int _numSim, int _numIter, int initialState, int initialTuple);
 
+  //! Forward simulates the equilibrium on several threads.
+  /*! Runs the _numSim simulations on numThreads threads, or on one
+      thread per core if numThreads is 0. Each thread adds its counts
+      to the distributions at most once every progressMilliseconds,
+      and progress is called on the calling thread about as often
+      with the number of finished simulations. The distributions are
+      not changed while progress runs, so it can read them. If
+      progress returns false, the remaining simulations are
+      canceled. Returns true if all of the simulations finished. */
+  bool simulate(int _numSim, int _numIter, int initialState, int initialTuple,
+		int numThreads,
+		const std::function<bool(int)> & progress,
+		int progressMilliseconds = 100);
+
+  //! Returns the number of periods counted in the distributions.
+  /*! Equal to the number of simulations times the number of
+      periods, unless the simulation was canceled. */
+  long getNumPeriods() const
+  {
+    long numPeriods = 0;
+    for (int state = 0; state < stateDistr.size(); state++)
+      numPeriods += stateDistr[state];
+    return numPeriods;
+  }
+
   //! Returns the long run action distribution
   SGPoint getLongRunPayoffs()
   {
     SGPoint payoffs(0.0,0.0);
+    double numPeriods = std::max(1L,getNumPeriods());
     for (int state = 0; 
 	 state < soln.getGame().getNumStates(); 
 	 state++)
@@ -160,7 +206,7 @@ public:
 	     action < soln.getGame().getNumActions_total()[state];
 	     action++)
 	  {
-	    payoffs += (1.0*actionDistr[state][action])/(1.0*numIter*numSim)
+	    payoffs += (1.0*actionDistr[state][action])/numPeriods
 	      * soln.getGame().getPayoffs()[state][action];
 	  }
       } // state
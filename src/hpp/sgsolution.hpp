@@ -24,6 +24,7 @@
 
 #include "sggame.hpp"
 #include "sgiteration.hpp"
+#include "sgutilities.hpp"
 #include <boost/archive/text_iarchive.hpp>
 #include <boost/archive/text_oarchive.hpp>
 #include <boost/serialization/utility.hpp>
@@ -32,6 +33,12 @@
 /*! This class contains a copy of the game used by SGSolver, a list of
     iterations and a list of extreme tuples generated by
     SGSolver::solve(). 
+
+    The iterations are also indexed by a vector of iterators into the
+    list, so that SGSolution::findIteration and
+    SGSolution::findRevolution take constant time rather than walking
+    the list. The index is rebuilt when the object is copied or
+    loaded.
     
     \ingroup src
 */
@@ -45,6 +52,36 @@ private:
   list<SGTuple> extremeTuples; /*!< The trajectory of the pivot tuple
                                   generated by SGSolver::solve(). */
 
+  vector< list<SGIteration>::const_iterator > iterationIndex;
+  /*!< Iterators to the elements of SGSolution::iterations, in
+     order. */
+  vector<int> revolutionIndex; /*!< Position in iterationIndex of the
+                                  first iteration of each revolution,
+                                  counting from the revolution of the
+                                  first iteration. */
+
+  //! Adds iter, the next element of SGSolution::iterations, to the index.
+  void indexIteration(list<SGIteration>::const_iterator iter)
+  {
+    int revolution = iter->getRevolution()
+      - iterations.front().getRevolution();
+    while (static_cast<int>(revolutionIndex.size()) <= revolution)
+      revolutionIndex.push_back(iterationIndex.size());
+    iterationIndex.push_back(iter);
+  }
+
+  //! Rebuilds the index from scratch.
+  void indexIterations()
+  {
+    iterationIndex.clear();
+    revolutionIndex.clear();
+    iterationIndex.reserve(iterations.size());
+    for (list<SGIteration>::const_iterator iter = iterations.begin();
+	 iter != iterations.end();
+	 ++iter)
+      indexIteration(iter);
+  }
+
 public:
   //! Default constructor
   SGSolution() {}
@@ -52,6 +89,26 @@ public:
   SGSolution(const SGGame& _game):
     game(_game)
   {}
+  //! Copy constructor
+  /*! Rebuilds the index, which would otherwise point into soln. */
+  SGSolution(const SGSolution & soln):
+    game(soln.game),
+    iterations(soln.iterations),
+    extremeTuples(soln.extremeTuples)
+  { indexIterations(); }
+  //! Assignment operator
+  /*! Rebuilds the index, which would otherwise point into soln. */
+  SGSolution & operator=(const SGSolution & soln)
+  {
+    if (this != &soln)
+      {
+	game = soln.game;
+	iterations = soln.iterations;
+	extremeTuples = soln.extremeTuples;
+	indexIterations();
+      }
+    return *this;
+  }
 
   //! Get method for the game
   const SGGame & getGame() const { return game; }
@@ -59,13 +116,66 @@ public:
   const list<SGIteration> & getIterations() const { return iterations; }
   //! Get method for the extremeTuples
   const list<SGTuple> & getExtremeTuples() const { return extremeTuples; }
+  //! Get method for the index of the iterations
+  const vector< list<SGIteration>::const_iterator > & getIterationIndex() const
+  { return iterationIndex; }
+
+  //! Finds an iteration by its number
+  /*! Returns the last iteration whose number is at most iteration,
+      or the first iteration if there is none. Takes constant time
+      when the iterations are numbered consecutively, which is how
+      SGApprox numbers them, and logarithmic time otherwise. Returns
+      SGSolution::getIterations().end() if there are no
+      iterations. */
+  list<SGIteration>::const_iterator findIteration(int iteration) const
+  {
+    if (iterationIndex.empty())
+      return iterations.end();
+
+    int position = iteration - iterations.front().getIteration();
+    if (position >= 0 && position < iterationIndex.size()
+	&& iterationIndex[position]->getIteration() == iteration)
+      return iterationIndex[position];
+
+    vector< list<SGIteration>::const_iterator >::const_iterator iter
+      = std::upper_bound(iterationIndex.begin(),iterationIndex.end(),
+			 iteration,
+			 [](int n, list<SGIteration>::const_iterator it)
+			 { return n < it->getIteration(); });
+    if (iter != iterationIndex.begin())
+      --iter;
+    return *iter;
+  } // findIteration
+
+  //! Finds the first iteration of a revolution
+  /*! Returns SGSolution::getIterations().end() if no iteration
+      belongs to the revolution. */
+  list<SGIteration>::const_iterator findRevolution(int revolution) const
+  {
+    if (iterationIndex.empty())
+      return iterations.end();
+
+    int position = revolution - iterations.front().getRevolution();
+    if (position < 0 || position >= revolutionIndex.size()
+	|| iterationIndex[revolutionIndex[position]]->getRevolution()
+	!= revolution)
+      return iterations.end();
+    return iterationIndex[revolutionIndex[position]];
+  } // findRevolution
   
   //! Resets the SGSolution object by clearing the iterations and
   //! extremeTuples lists.
-  void clear() {iterations.clear(); extremeTuples.clear();}
+  void clear()
+  {
+    iterations.clear(); extremeTuples.clear();
+    iterationIndex.clear(); revolutionIndex.clear();
+  }
   //! Adds a new iteration to the back of SGSolution::iterations
   void push_back(const SGIteration & iteration)
-  { iterations.push_back(iteration); }
+  {
+    iterations.push_back(iteration);
+    indexIteration(--iterations.end());
+  }
   //! Adds a new tuple to the back of SGSolution::extremeTuples
   void push_back(const SGTuple & tuple)
   { extremeTuples.push_back(tuple); }
@@ -78,6 +188,8 @@ public:
   void serialize(Archive &ar, const unsigned int version)
   {
     ar & game & iterations & extremeTuples;
+    if (Archive::is_loading::value)
+      indexIterations();
   }
 
   //! Static method for saving an SGSolution object to the file filename.
@@ -107,6 +219,27 @@ public:
       throw(SGException(SG::FAILED_OPEN));
   }
 
+  //! Loads an SGSolution object and reports progress
+  /*! Same as the other SGSolution::load, but calls progress with the
+      fraction of the file that has been read as the archive is
+      parsed. progress is called on the loading thread. */
+  static void load(SGSolution & soln, const char* filename,
+		   const std::function<void(double)> & progress)
+  {
+    std::ifstream ifs(filename,std::fstream::in);
+    if (!ifs.good() || !ifs.is_open())
+      throw(SGException(SG::FAILED_OPEN));
+
+    ifs.seekg(0,std::ios::end);
+    std::streamsize size = ifs.tellg();
+    ifs.seekg(0,std::ios::beg);
+
+    SGProgressStreambuf progressBuf(ifs.rdbuf(),size,progress);
+    std::istream is(&progressBuf);
+    boost::archive::text_iarchive ia(is);
+    ia >> soln;
+  }
+
   friend class boost::serialization::access;
 }; // SGSolution
 
@@ -26,9 +26,11 @@
 #include "sgutilities.hpp"
 #include "sgenv.hpp"
 #include "sggame.hpp"
+#include "sglazygame.hpp"
 #include "sgapprox.hpp"
 #include "sgexception.hpp"
 #include "sgsolution.hpp"
+#include <functional>
 
 //! Class for solving stochastic games
 /*! This class contains parameters for the algorithm, the solve
@@ -46,9 +48,15 @@ private:
   //! SGEnv object to hold parameters
   const SGEnv & env;
   //! Constant reference to the game to be solved.
-  const SGGame & game; 
+  const SGGameAccessor & game; 
   //! SGSolution object used by SGApprox to store data.
   SGSolution soln;
+  //! Number of iterations in the last call to solve.
+  int numIterations;
+  //! Number of revolutions in the last call to solve.
+  int numRevolutions;
+  //! Error level at the end of the last call to solve.
+  double errorLevel;
 
 public:
   //! Default constructor
@@ -60,18 +68,49 @@ public:
   SGSolver(const SGEnv & _env, 
 	   const SGGame & _game);
 
+  //! Constructor for games that are not stored as an SGGame
+  /*! Solves a game that is accessed through some other
+      implementation of SGGameAccessor, e.g., an SGLazyGame. Since the
+      game cannot be copied into the solution, SGSolution::getGame()
+      will return a default SGGame. */
+  SGSolver(const SGEnv & _env, 
+	   const SGGameAccessor & _game);
+
   //! Destructor
   ~SGSolver() {}
 
   //! Solve routine
   /*! Initializes a new SGApproximation object and iteratively
       generates it until one of the stopping criteria have been
-      met. Stores progress in the data member. */
+      met. Stores progress in the data member. If no admissible
+      direction can be found, the extreme tuples reached so far are
+      still added to the solution before the SGException is
+      thrown. */
   void solve();
 
+  //! Solve routine with a progress hook
+  /*! Same as SGSolver::solve(), but calls progress with the
+      approximation each time it completes a revolution, e.g., to
+      report SGApprox::progressString() or to let the user
+      interrupt. If progress returns false, no more iterations are
+      generated, and the extreme tuples reached so far are added to
+      the solution as usual. Returns false if the solve was stopped
+      in this way. */
+  bool solve(const std::function<bool(const SGApprox &)> & progress);
+
   //! Returns a constant reference to the SGSolution object storing the
   //! output of the computation.
   const SGSolution& getSolution() const {return soln;}
+
+  //! Returns the number of iterations of the last solve.
+  int getNumIterations() const { return numIterations; }
+  //! Returns the number of revolutions of the last solve.
+  int getNumRevolutions() const { return numRevolutions; }
+  //! Returns the error level at the end of the last solve.
+  /*! The algorithm converged if this is at most the ERRORTOL
+      parameter, and otherwise stopped because it reached
+      MAXITERATIONS or because the progress hook returned false. */
+  double getErrorLevel() const { return errorLevel; }
 };
 
 
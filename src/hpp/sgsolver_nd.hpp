@@ -0,0 +1,236 @@
+// This file is part of the SGSolve library for stochastic games
+// Copyright (C) 2016 Benjamin A. Brooks
+// 
+// SGSolve free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// SGSolve is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see
+// <http://www.gnu.org/licenses/>.
+// 
+// Benjamin A. Brooks
+// ben@benjaminbrooks.net
+// Chicago, IL
+
+
+#ifndef _SGSOLVER_ND_HPP
+#define _SGSOLVER_ND_HPP
+
+#include "sgcommon.hpp"
+#include "sgenv.hpp"
+#include "sgexception.hpp"
+#include "sgutilities.hpp"
+#include "sghull.hpp"
+
+//! Solves repeated games with three players
+/*! This class implements the algorithm of Abreu and Sannikov (2014)
+  for repeated games with more than two players, in which the
+  equilibrium payoffs form a polytope rather than a polygon. Each
+  iteration generates a finite set of payoffs from the current
+  polytope \f$W\f$, and the next polytope is their convex hull.
+
+  For each action profile \f$a\f$, let \f$\underline{w}(a)\f$ be the
+  minimum incentive compatible continuation value, which is the
+  current threat point plus \f$(1-\delta)/\delta\f$ times each
+  player's largest gain from deviating. If the stage payoff
+  \f$g(a)\f$ satisfies these constraints, it is generated
+  directly. Otherwise, for each player \f$i\f$ whose constraint is
+  violated by \f$g(a)\f$, the slice of \f$W\f$ on which player i's
+  continuation value equals \f$\underline{w}_i(a)\f$ and the other
+  players' constraints hold is a polygon, and the payoffs
+  \f$(1-\delta)g(a)+\delta w\f$ are generated for each vertex
+  \f$w\f$ of that polygon. Profiles that generate no payoffs are
+  dropped for good. The threat point rises to the smallest generated
+  payoff of each player, and the algorithm stops when the volume of
+  the polytope changes by less than SG::ERRORTOL.
+
+  The polygons are computed in closed form by clipping a box with the
+  facets of \f$W\f$, so no linear programs are needed. The profiles
+  are divided among numThreads threads, and each thread clips in its
+  own SGSolverND::Workspace. Each profile has its own buffer of
+  generated payoffs. The storage of both is kept across iterations,
+  and the buffers are concatenated in order into one contiguous array
+  before the hull is taken. The hull is built by SGHull, whose
+  workspace is also kept across iterations.
+
+  Only three players are supported so far, since the slices are then
+  two dimensional.
+
+  \ingroup src
+ */
+class SGSolverND
+{
+private:
+  //! Buffers used by SGSolverND::generate
+  /*! Each thread has its own, so that profiles can be generated
+      without allocating once the buffers have grown. */
+  struct Workspace
+  {
+    vector<double> minCV; /*!< Minimum incentive compatible
+                             continuation value of each player. */
+    vector<double> point; /*!< Continuation value at a vertex of the
+                             slice. */
+    vector<double> polygon; /*!< The slice being clipped, two
+                               coordinates per vertex. */
+    vector<double> clipped; /*!< Output of SGSolverND::clipPolygon,
+                               swapped with polygon. */
+  };
+
+  const SGEnv & env; /*!< Parameters for the algorithm. */
+
+  int numPlayers; /*!< The number of players. */
+  vector<int> numActions; /*!< Number of actions of each player, or
+                             zeros if the gains were given
+                             directly. */
+  int numActions_total; /*!< The number of action profiles. */
+  vector<double> payoffs; /*!< Stage payoffs, numPlayers entries per
+                             action profile. */
+  vector<double> gains; /*!< Largest gain from deviating, numPlayers
+                           entries per action profile. */
+  double delta; /*!< The discount factor. */
+  int numThreads; /*!< Number of threads, or zero for one per
+                     core. */
+
+  vector<double> hyperplanes; /*!< Facets of the current polytope,
+                                 numPlayers+1 entries per facet: the
+                                 outward normal followed by the
+                                 level. */
+  vector<double> threats; /*!< Current threat point. */
+  vector<double> payoffLB; /*!< Smallest stage payoff of each
+                              player. */
+  vector<double> payoffUB; /*!< Largest stage payoff of each
+                              player. */
+  vector<char> available; /*!< available[a] is false once profile a
+                             can no longer be supported. */
+  int numAvailableActions; /*!< Number of profiles that are still
+                              available. */
+  int numIterations; /*!< Number of iterations so far. */
+  long numGenerated; /*!< Number of payoffs generated over all
+                        iterations. */
+  double volume; /*!< Volume of the current polytope. */
+  double volumeChange; /*!< Change in volume at the last
+                          iteration. */
+  bool degenerate; /*!< True if the generated payoffs did not span
+                      numPlayers dimensions. */
+
+  vector< vector<double> > actionPoints; /*!< Payoffs generated by each
+                                            profile at the current
+                                            iteration. */
+  vector< vector<int> > actionConstrs; /*!< For each payoff in
+                                          actionPoints, the player
+                                          whose constraint binds, or
+                                          numPlayers if none does. */
+  vector<double> points; /*!< Payoffs generated at the current
+                            iteration, numPlayers entries per
+                            payoff. */
+  vector<int> pointActions; /*!< Profile that generated each
+                               payoff. */
+  vector<int> pointConstrs; /*!< Binding constraint of each payoff, as
+                               in actionConstrs. */
+  vector<int> extPntIndex; /*!< Indices in points of the vertices of
+                              the current polytope. */
+  SGHull hull; /*!< Workspace for the convex hull. */
+  vector<Workspace> workspaces; /*!< Buffers for
+                                   SGSolverND::generate, one per
+                                   thread. */
+
+  //! Checks the inputs and stores the payoffs
+  void setPayoffs(const vector< vector<double> > & _payoffs);
+  //! Computes the largest gains from deviating
+  void computeGains();
+  //! Sets the bounds, threats, and facets of the feasible payoffs
+  void initialize();
+  //! Generates the payoffs of profile a from the current polytope
+  void generate(int a, Workspace & workspace,
+		vector<double> & newPoints,
+		vector<int> & newConstrs) const;
+  //! Intersects a convex polygon with the half plane normal*x<=level
+  static void clipPolygon(vector<double> & polygon,
+			  double normal0, double normal1, double level,
+			  vector<double> & workspace);
+
+public:
+  //! Constructor
+  /*! _payoffs[a][i] is player i's payoff from action profile a, where
+      the first player's action changes fastest, as in
+      SGGame. _numActions[i] is the number of actions of player
+      i. The gains from deviating are computed from the payoffs. */
+  SGSolverND(const SGEnv & _env,
+	     const vector<int> & _numActions,
+	     const vector< vector<double> > & _payoffs,
+	     double _delta,
+	     int _numThreads = 1);
+
+  //! Constructor
+  /*! Same as above, but with the largest gain of each player from
+      deviating from each profile given directly in _gains. */
+  SGSolverND(const SGEnv & _env,
+	     const vector< vector<double> > & _payoffs,
+	     const vector< vector<double> > & _gains,
+	     double _delta,
+	     int _numThreads = 1);
+
+  //! Runs iterations until the volume converges
+  /*! Returns the number of iterations. */
+  int solve();
+  //! Runs one iteration
+  /*! Returns the change in the volume of the polytope. */
+  double iterate();
+
+  //! Sets the number of threads, or zero for one per core
+  bool setNumThreads(int _numThreads)
+  {
+    if (_numThreads < 0)
+      return false;
+    numThreads = _numThreads;
+    return true;
+  }
+
+  //! Returns the number of players
+  int getNumPlayers() const { return numPlayers; }
+  //! Returns the number of iterations so far
+  int getNumIterations() const { return numIterations; }
+  //! Returns the number of payoffs generated over all iterations
+  long getNumGenerated() const { return numGenerated; }
+  //! Returns the number of profiles that are still available
+  int getNumAvailableActions() const { return numAvailableActions; }
+  //! Returns the facets of the current polytope
+  /*! numPlayers+1 entries per facet: the outward normal and the
+      level. */
+  const vector<double> & getHyperplanes() const { return hyperplanes; }
+  //! Returns the current threat point
+  const vector<double> & getThreats() const { return threats; }
+  //! Returns the volume of the current polytope
+  double getVolume() const { return volume; }
+  //! Returns the payoffs generated at the last iteration
+  /*! numPlayers entries per payoff. */
+  const vector<double> & getPoints() const { return points; }
+  //! Returns the profile that generated each payoff
+  const vector<int> & getPointActions() const { return pointActions; }
+  //! Returns the binding constraint of each payoff
+  /*! The player whose incentive constraint binds, or numPlayers if
+      the payoff is the stage payoff itself. */
+  const vector<int> & getPointConstrs() const { return pointConstrs; }
+  //! Returns the indices in getPoints() of the vertices
+  const vector<int> & getExtPntIndex() const { return extPntIndex; }
+  //! True if no profile can be supported
+  bool collapsed() const { return numAvailableActions == 0; }
+  //! True if the generated payoffs were not full dimensional
+  bool isDegenerate() const { return degenerate; }
+
+  //! Writes the game and the solution to a text file
+  /*! Uses the format of the threeplayer2 example: the game, then the
+      vertices with their indices, then all of the generated payoffs
+      with their profiles and binding constraints. */
+  void save(ofstream & ofs) const;
+
+}; // SGSolverND
+
+#endif
@@ -28,13 +28,17 @@
 #include "sggame.hpp"
 #include "sgapprox_v2.hpp"
 #include "sgexception.hpp"
-#include "sgsolution.hpp"
+#include "sgsolution_v2.hpp"
 
 //! Class for solving stochastic games
+//! Class for solving stochastic games with hyperplanes
 /*! This class contains parameters for the algorithm, the solve
   method, as well as the data structure produced by solve. It
   calculates the equilibrium payoff correspondence corresponding to an
-  SGGame object.
+  SGGame object using SGApprox_V2, which represents the
+  correspondence by hyperplanes rather than by the trajectory of the
+  pivot. The result is stored as a sequence of SGIteration_V2
+  objects, the last of which holds the final hyperplanes.
 
   \ingroup src
  */
@@ -47,8 +51,8 @@ private:
   const SGEnv & env;
   //! Constant reference to the game to be solved.
   const SGGame & game; 
-  //! SGSolution object used by SGApprox to store data.
-  SGSolution soln;
+  //! SGSolution_V2 object used by SGApprox_V2 to store data.
+  SGSolution_V2 soln;
 
 public:
   //! Default constructor
@@ -64,14 +68,15 @@ public:
   ~SGSolver_V2() {}
 
   //! Solve routine
-  /*! Initializes a new SGApproximation object and iteratively
+  /*! Initializes a new SGApprox_V2 object and iteratively
       generates it until one of the stopping criteria have been
-      met. Stores progress in the data member. */
+      met. If SG::STOREITERATIONS is 2, every revolution is stored in
+      the solution, and if it is 1, only the last one is. */
   void solve();
 
-  //! Returns a constant reference to the SGSolution object storing the
-  //! output of the computation.
-  const SGSolution& getSolution() const {return soln;}
+  //! Returns a constant reference to the SGSolution_V2 object
+  //! storing the output of the computation.
+  const SGSolution_V2& getSolution() const {return soln;}
 };
 
 
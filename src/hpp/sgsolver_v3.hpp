@@ -26,11 +26,14 @@
 #include "sgutilities.hpp"
 #include "sggame.hpp"
 #include "sgexception.hpp"
-#include "gurobi_c++.h"
+#include "sgaction.hpp"
+#include "sglpbackend.hpp"
 
-//! Class that implements the JYC algorithm using Gurobi
-/*! This file has no associated cpp file, so that libsg does not have
-  to link to Gurobi.
+//! Class that implements the JYC algorithm
+/*! The linear programs are solved with SGDefaultLP, which is the
+  bundled SGSimplex unless SGGUROBI is defined, in which case Gurobi
+  is used. This file has no associated cpp file, so that libsg does
+  not have to link to Gurobi.
 
   \ingroup src
 */
@@ -148,13 +151,13 @@ public:
 		 int & steps);
 
   void addBoundingHyperplane(SGPoint & currDir,
-			     GRBConstr & xConstr,
-			     GRBConstr & yConstr,
-			     GRBVar * valueFn,
+			     int xConstr,
+			     int yConstr,
+			     int valueFn,
 			     int numStates,
 			     list<SGPoint> & newDirections,
 			     list< vector<double> > & newBounds,
-			     GRBModel & model,
+			     SGLP & model,
 			     const bool addDirection);
   void printIteration(ofstream & ofs, int numIter);
 
@@ -173,7 +176,7 @@ void SGSolver_V3::solve()
 
   initialize();
 
-  threatTuple = SGTuple (game.getNumStates(),-GRB_INFINITY);
+  threatTuple = SGTuple (game.getNumStates(),-SGLP::INF);
 
   eqActions = game.getEquilibriumActions();
   
@@ -204,9 +207,9 @@ void SGSolver_V3::solve()
 	  printIteration(ofs, numIter);
 	} // while
     }
-  catch (GRBException & e)
+  catch (std::exception & e)
     {
-      cout << "GRB Exception caught: " << e.getMessage() << endl;
+      cout << "Exception caught: " << e.what() << endl;
     }
 
   ofs.close();
@@ -233,18 +236,7 @@ void SGSolver_V3::initialize()
 
 double SGSolver_V3::iterate(const SGSolverMode mode, int & steps)
 {
-  GRBEnv env;
-  // env.set(GRB_IntParam_Method,0); // primal simplex
-  // env.set(GRB_IntParam_Method,1); // dual simplex
-  env.set(GRB_IntParam_Method,5); // deterministic concurrent simplex; needs newer version of gurobi
-  // env.set(GRB_IntParam_Crossover,0); // disable crossover
-  // env.set(GRB_DoubleParam_BarConvTol,1e-12);
-  env.set(GRB_DoubleParam_OptimalityTol,1e-9);
-  env.set(GRB_DoubleParam_MarkowitzTol,0.999);
-  env.set(GRB_DoubleParam_FeasibilityTol,1e-9);
-  // env.set(GRB_IntParam_DualReductions,0);
-  env.set(GRB_IntParam_OutputFlag,0);
-  GRBModel model(env);
+  SGDefaultLP model;
 
   vector<int> actions, deviations;
   int deviation;
@@ -275,32 +267,37 @@ double SGSolver_V3::iterate(const SGSolverMode mode, int & steps)
   if (mode != SG_FEASIBLE)
     assert(numDirections>0);
 
-  GRBVar * valueFn = model.addVars(numStates);
-  GRBVar * contVals = model.addVars(numActions_grandTotal);
-  GRBVar * valueFunSlacks = model.addVars(numActions_grandTotal);
-  GRBVar * pseudoContVals = model.addVars(numActions_grandTotal);
-  GRBVar * recursiveContValSlacks = model.addVars(numActions_grandTotal);
-  GRBVar * APSContValSlacks = model.addVars(numActions_grandTotal);
-  GRBVar * APSContValVar = model.addVars(numActions_grandTotal);
-  GRBVar * feasMult = model.addVars(numActions_grandTotal*numDirections);
-  GRBVar * ICMult = model.addVars(numActions_grandTotal*numPlayers);
-  GRBVar * currDirVar = model.addVars(2);
-
-  model.update();
+  // Each block of variables is referred to by the index of its first
+  // variable.
+  const int valueFn = model.addVariables(numStates);
+  const int contVals = model.addVariables(numActions_grandTotal);
+  const int valueFunSlacks = model.addVariables(numActions_grandTotal);
+  const int pseudoContVals = model.addVariables(numActions_grandTotal);
+  const int recursiveContValSlacks = model.addVariables(numActions_grandTotal);
+  const int APSContValSlacks = model.addVariables(numActions_grandTotal);
+  const int APSContValVar = model.addVariables(numActions_grandTotal);
+  const int feasMult = model.addVariables(numActions_grandTotal*numDirections);
+  const int ICMult = model.addVariables(numActions_grandTotal*numPlayers);
+  const int currDirVar = model.addVariables(2,-SGLP::INF,SGLP::INF);
 
   SGPoint currDir(0,1);
-  currDirVar[0].set(GRB_DoubleAttr_LB,-GRB_INFINITY);
-  currDirVar[1].set(GRB_DoubleAttr_LB,-GRB_INFINITY);
 
-  GRBConstr xConstr = model.addConstr(currDirVar[0] == 0.0);
-  GRBConstr yConstr = model.addConstr(currDirVar[1] == 1.0);
-  vector< vector<GRBConstr> > valueFnConstr (numStates);
+  int xConstr, yConstr;
+  {
+    SGLinExpr lhs;
+    lhs.add(currDirVar,1.0);
+    xConstr = model.addConstraint(lhs,SGLP::EQUAL,0.0);
+    lhs.clear();
+    lhs.add(currDirVar+1,1.0);
+    yConstr = model.addConstraint(lhs,SGLP::EQUAL,1.0);
+  }
+  vector< vector<int> > valueFnConstr (numStates);
   for (int s = 0; s < numStates; s++)
     {
-      valueFnConstr[s] = vector<GRBConstr> (eqActions[s].size());
+      valueFnConstr[s] = vector<int> (eqActions[s].size());
     }
 
-  vector<GRBLinExpr> recursiveContVal(numActions_grandTotal,0);
+  vector<SGLinExpr> recursiveContVal(numActions_grandTotal);
   vector<SGRegimeStatus> regimeStatus(numActions_grandTotal,SG_RECURSIVE);
   vector<int> optActions(numStates,-1);
 
@@ -310,19 +307,19 @@ double SGSolver_V3::iterate(const SGSolverMode mode, int & steps)
 
   for (int ga = 0; ga < numActions_grandTotal; ga++)
     {
-      contVals[ga].set(GRB_DoubleAttr_LB,-2*payoffBound);
-      pseudoContVals[ga].set(GRB_DoubleAttr_LB,-2*payoffBound);
-      APSContValVar[ga].set(GRB_DoubleAttr_LB,-2*payoffBound);
+      model.setLowerBound(contVals+ga,-2*payoffBound);
+      model.setLowerBound(pseudoContVals+ga,-2*payoffBound);
+      model.setLowerBound(APSContValVar+ga,-2*payoffBound);
     }
   for (int s = 0; s < numStates; s++)
-    valueFn[s].set(GRB_DoubleAttr_LB,-GRB_INFINITY);
+    model.setLowerBound(valueFn+s,-SGLP::INF);
   
-  GRBLinExpr objective = 0;
+  SGLinExpr objective;
   {
     int ga = 0; // grandAction
     for (int s = 0; s < numStates; s++)
       {
-	objective += 1e10*valueFn[s];
+	objective.add(valueFn+s,1e10);
 
 	int actr = 0;
 	// Add feasibility constraints
@@ -330,9 +327,9 @@ double SGSolver_V3::iterate(const SGSolverMode mode, int & steps)
 	     a != eqActions[s].end(); a++)
 	  {
 	    for (int sp = 0; sp < numStates; sp++)
-	      recursiveContVal[ga] += prob[s][*a][sp]*valueFn[sp];
+	      recursiveContVal[ga].add(valueFn+sp,prob[s][*a][sp]);
 
-	    GRBLinExpr APSContVal = 0;
+	    SGLinExpr APSContVal;
 	    if (mode==SG_MAXMINMAX || mode==SG_APS)
 	      {
 		// Calculate minIC for each player.
@@ -340,7 +337,7 @@ double SGSolver_V3::iterate(const SGSolverMode mode, int & steps)
 		  {
 		    double minIC = SGAction::calculateMinIC(*a,s,p,
 							    game,threatTuple);
-		    APSContVal -= ICMult[p+2*ga]*minIC;
+		    APSContVal.add(ICMult+p+2*ga,-minIC);
 		  }
 
 		{
@@ -355,7 +352,8 @@ double SGSolver_V3::iterate(const SGSolverMode mode, int & steps)
 		      for (int sp = 0; sp < numStates; sp++)
 			expBnd += (*bnd)[sp] * prob[s][*a][sp];
 		      
-		      APSContVal += expBnd * feasMult[ga+dirCtr*numActions_grandTotal];
+		      APSContVal.add(feasMult+ga+dirCtr*numActions_grandTotal,
+				     expBnd);
 		    } // for bnd
 		}
 
@@ -364,38 +362,60 @@ double SGSolver_V3::iterate(const SGSolverMode mode, int & steps)
 		  int dirCtr;
 		  for (int p = 0; p < numPlayers; p++)
 		    {
-		      GRBLinExpr dualConstrLHS = 0;
+		      SGLinExpr dualConstrLHS;
 
-		      dualConstrLHS += ICMult[p+2*ga];
-		      dualConstrLHS += currDirVar[p];
+		      dualConstrLHS.add(ICMult+p+2*ga,1.0);
+		      dualConstrLHS.add(currDirVar+p,1.0);
 		      for (dir = directions.begin(),
 			     dirCtr = 0;
 			   dir != directions.end();
 			   ++dir,++dirCtr)
 			{
-			  dualConstrLHS -= (*dir)[p] * feasMult[ga+dirCtr*numActions_grandTotal];
+			  dualConstrLHS.add(feasMult+ga+dirCtr*numActions_grandTotal,
+					    -(*dir)[p]);
 			} // for dir
 		      
-		      model.addConstr(dualConstrLHS==0);
+		      model.addConstraint(dualConstrLHS,SGLP::EQUAL,0.0);
 		    } // for p
 		}
 	    
-		model.addConstr(pseudoContVals[ga] >= APSContVal);
-		model.addConstr(contVals[ga] == APSContVal+APSContValSlacks[ga]);
-		model.addConstr(APSContValVar[ga]==APSContVal);
+		SGLinExpr lhs;
+		lhs.add(pseudoContVals+ga,1.0);
+		lhs.add(APSContVal,-1.0);
+		model.addConstraint(lhs,SGLP::GREATEREQUAL,0.0);
+
+		lhs.clear();
+		lhs.add(contVals+ga,1.0);
+		lhs.add(APSContVal,-1.0);
+		lhs.add(APSContValSlacks+ga,-1.0);
+		model.addConstraint(lhs,SGLP::EQUAL,0.0);
+
+		lhs.clear();
+		lhs.add(APSContValVar+ga,1.0);
+		lhs.add(APSContVal,-1.0);
+		model.addConstraint(lhs,SGLP::EQUAL,0.0);
 	      } // if calculating subgame perfect
-	    model.addConstr(pseudoContVals[ga]
-			    >= recursiveContVal[ga]*(1.0+pseudoConstrTol));
-	    model.addConstr(contVals[ga] == recursiveContVal[ga]+recursiveContValSlacks[ga]);
-
-	    GRBLinExpr valueFnConstrRHS = 0;
+	    SGLinExpr lhs;
+	    lhs.add(pseudoContVals+ga,1.0);
+	    lhs.add(recursiveContVal[ga],-(1.0+pseudoConstrTol));
+	    model.addConstraint(lhs,SGLP::GREATEREQUAL,0.0);
+
+	    lhs.clear();
+	    lhs.add(contVals+ga,1.0);
+	    lhs.add(recursiveContVal[ga],-1.0);
+	    lhs.add(recursiveContValSlacks+ga,-1.0);
+	    model.addConstraint(lhs,SGLP::EQUAL,0.0);
+
+	    // valueFn[s] == flow payoff + delta*contVals[ga]
+	    // + valueFunSlacks[ga]
+	    lhs.clear();
+	    lhs.add(valueFn+s,1.0);
 	    for (int p = 0; p < numPlayers; p++)
-	      valueFnConstrRHS += (1-delta)*payoffs[s][*a][p]*currDirVar[p];
-
-	    valueFnConstrRHS += delta*contVals[ga];
+	      lhs.add(currDirVar+p,-(1-delta)*payoffs[s][*a][p]);
+	    lhs.add(contVals+ga,-delta);
+	    lhs.add(valueFunSlacks+ga,-1.0);
 	    
-	    valueFnConstr[s][actr] = model.addConstr(valueFn[s] == valueFnConstrRHS
-						     +valueFunSlacks[ga]);
+	    valueFnConstr[s][actr] = model.addConstraint(lhs,SGLP::EQUAL,0.0);
 
 	    actr++;
 	    
@@ -410,26 +430,26 @@ double SGSolver_V3::iterate(const SGSolverMode mode, int & steps)
 	{
 	  // Start with fixed constraints
 	  regimeStatus[ga] = SG_FIXED;
-	  APSContValSlacks[ga].set(GRB_DoubleAttr_LB,0);
-	  recursiveContValSlacks[ga].set(GRB_DoubleAttr_LB,-GRB_INFINITY);
+	  model.setLowerBound(APSContValSlacks+ga,0);
+	  model.setLowerBound(recursiveContValSlacks+ga,-SGLP::INF);
 	}
       else
 	{
 	  // Start with recursive constraints
-	  APSContValSlacks[ga].set(GRB_DoubleAttr_LB,-GRB_INFINITY);
-	  recursiveContValSlacks[ga].set(GRB_DoubleAttr_LB,0);
+	  model.setLowerBound(APSContValSlacks+ga,-SGLP::INF);
+	  model.setLowerBound(recursiveContValSlacks+ga,0);
 	}
     } // for ga
 
   // Finish setting up objective
   for (int ga = 0; ga < numActions_grandTotal; ga++)
     {
-      objective += pseudoContVals[ga];
-      // objective += contVals[ga];
-      objective += APSContValVar[ga];
+      objective.add(pseudoContVals+ga,1.0);
+      // objective.add(contVals+ga,1.0);
+      objective.add(APSContValVar+ga,1.0);
     } // for ga
 
-  model.setObjective(objective,GRB_MINIMIZE);
+  model.setObjective(objective,false); // minimize
 
   list< vector<double> > newBounds(0);
   list<SGPoint> newDirections(0);
@@ -459,18 +479,18 @@ double SGSolver_V3::iterate(const SGSolverMode mode, int & steps)
       while (regimesSubOptimal
 	     && regimeChangeIters < 10*numActions_grandTotal)
 	{
-	  model.optimize();
+	  model.solve();
 
-	  if (model.get(GRB_IntAttr_Status)!=GRB_OPTIMAL)
+	  if (model.getStatus()!=SGLP::OPTIMAL)
 	    {
 	      cout << "Warning: model not optimal. Code is: "
-		   << model.get(GRB_IntAttr_Status) << endl;
+		   << model.getStatus() << endl;
 	    }
-	  if (model.get(GRB_IntAttr_Status)==GRB_UNBOUNDED)
+	  if (model.getStatus()==SGLP::UNBOUNDED)
 	    {
 	      cout << "Warning: Unbounded model" << endl;
 	    }
-	  if (model.get(GRB_IntAttr_Status)==GRB_INFEASIBLE)
+	  if (model.getStatus()==SGLP::INFEASIBLE)
 	    {
 	      cout << "Warning: Infeasible model" << endl;
 	    }
@@ -485,8 +505,8 @@ double SGSolver_V3::iterate(const SGSolverMode mode, int & steps)
 	  for (int ga = 0; ga < numActions_grandTotal; ga++)
 	    {
 	      double tmp = 0;
-	      tmp = recursiveContVal[ga].getValue()
-		    -APSContValVar[ga].get(GRB_DoubleAttr_X);
+	      tmp = recursiveContVal[ga].getValue(model)
+		    -model.getValue(APSContValVar+ga);
 	      if (regimeStatus[ga]==SG_FIXED)
 		{
 		  tmp = -tmp;
@@ -512,27 +532,27 @@ double SGSolver_V3::iterate(const SGSolverMode mode, int & steps)
 		       a != eqActions[s].end(); a++)
 		    {
 		      // cout << " (a,vbasis)=(" << a
-		      // 	   << "," << valueFunSlacks[ga].get(GRB_IntAttr_VBasis) << ")";
-		      if (valueFunSlacks[ga].get(GRB_IntAttr_VBasis) == -1)
+		      // 	   << "," << model.getBasisStatus(valueFunSlacks+ga) << ")";
+		      if (model.getBasisStatus(valueFunSlacks+ga) == SGLP::AT_LOWER)
 			{
 			  numOptA++;
 			  optActions[s]=ga;
 			  if (regimeStatus[ga] == SG_FIXED
-			      && ICMult[2*ga].get(GRB_IntAttr_VBasis)==-1
-			      && ICMult[1+2*ga].get(GRB_IntAttr_VBasis)==-1)
+			      && model.getBasisStatus(ICMult+2*ga)==SGLP::AT_LOWER
+			      && model.getBasisStatus(ICMult+1+2*ga)==SGLP::AT_LOWER)
 			    {
 			      regimeStatus[ga] = SG_RECURSIVE;
 			      optICStatuses[s] = SG_NONE;
-			      APSContValSlacks[ga].set(GRB_DoubleAttr_LB,
-						       -GRB_INFINITY);
-			      recursiveContValSlacks[ga].set(GRB_DoubleAttr_LB,0.0);
+			      model.setLowerBound(APSContValSlacks+ga,
+						  -SGLP::INF);
+			      model.setLowerBound(recursiveContValSlacks+ga,0.0);
 			    } // if
 			  else if (regimeStatus[ga] == SG_FIXED)
 			    {
 			      // Update the number of IC statuses
-			      if (ICMult[1+2*ga].get(GRB_IntAttr_VBasis)==-1)
+			      if (model.getBasisStatus(ICMult+1+2*ga)==SGLP::AT_LOWER)
 				optICStatuses[s] = SG_BINDING0;
-			      else if (ICMult[2*ga].get(GRB_IntAttr_VBasis)==-1)
+			      else if (model.getBasisStatus(ICMult+2*ga)==SGLP::AT_LOWER)
 				optICStatuses[s] = SG_BINDING1;
 			      else
 				optICStatuses[s] = SG_BINDING01;
@@ -545,7 +565,7 @@ double SGSolver_V3::iterate(const SGSolverMode mode, int & steps)
 		  //assert(numOptA>=1);
 		} // for s
 	      // Optimize one last time with the correct regimes.
-	      model.optimize();
+	      model.solve();
 	      break;
 	    } // if
 	  else
@@ -558,14 +578,14 @@ double SGSolver_V3::iterate(const SGSolverMode mode, int & steps)
 		  switch (regimeStatus[ga])
 		    {
 		    case SG_RECURSIVE:
-		      if (recursiveContVal[ga].getValue()
-			  -APSContValVar[ga].get(GRB_DoubleAttr_X)
+		      if (recursiveContVal[ga].getValue(model)
+			  -model.getValue(APSContValVar+ga)
 			  >delta*maxSlack)
 			{
 			  regimeStatus[ga] = SG_FIXED;
-			  APSContValSlacks[ga].set(GRB_DoubleAttr_LB,0.0);
-			  recursiveContValSlacks[ga].set(GRB_DoubleAttr_LB,
-							 -GRB_INFINITY);
+			  model.setLowerBound(APSContValSlacks+ga,0.0);
+			  model.setLowerBound(recursiveContValSlacks+ga,
+					      -SGLP::INF);
 			}
 		  
 		      break;
@@ -576,14 +596,14 @@ double SGSolver_V3::iterate(const SGSolverMode mode, int & steps)
 
 		      // If this is the optimal action but no IC
 		      // constraint binds, switch to recursive
-		      if ( (-recursiveContVal[ga].getValue()
-			    +APSContValVar[ga].get(GRB_DoubleAttr_X)
+		      if ( (-recursiveContVal[ga].getValue(model)
+			    +model.getValue(APSContValVar+ga)
 			    > regimeChangeTol))
 			{
 			  regimeStatus[ga] = SG_RECURSIVE;
-			  APSContValSlacks[ga].set(GRB_DoubleAttr_LB,
-						   -GRB_INFINITY);
-			  recursiveContValSlacks[ga].set(GRB_DoubleAttr_LB,0.0);
+			  model.setLowerBound(APSContValSlacks+ga,
+					      -SGLP::INF);
+			  model.setLowerBound(recursiveContValSlacks+ga,0.0);
 			}
 		      break;
 		    } // switch
@@ -618,12 +638,13 @@ double SGSolver_V3::iterate(const SGSolverMode mode, int & steps)
       // (ii) Find how far we can rotate clockwise without violating
       // optimality. Add a new hyperplane for this face. Rotate the
       // objective and continue.
-      double tmp = 0;
+      double tmp = 0, rhsLow, rhsUp;
       switch (quadrant)
 	{
 	case SG_NORTHEAST:
 	  // Increasing currDirVar[0] and decreasing currDirVar[1]
-	  tmp = xConstr.get(GRB_DoubleAttr_SARHSUp);
+	  model.getRHSRange(xConstr,rhsLow,rhsUp);
+	  tmp = rhsUp;
 	  currDir[0] = tmp;
 	  	  
 	  addBoundingHyperplane(currDir,xConstr,yConstr,valueFn,
@@ -642,7 +663,8 @@ double SGSolver_V3::iterate(const SGSolverMode mode, int & steps)
 	  
 	case SG_SOUTHEAST:
 	  // Decreasing currDirVar[0] and decreasing currDirVar[1]
-	  tmp = yConstr.get(GRB_DoubleAttr_SARHSLow);
+	  model.getRHSRange(yConstr,rhsLow,rhsUp);
+	  tmp = rhsLow;
 	  currDir[1] = tmp;
 
 	  addBoundingHyperplane(currDir,xConstr,yConstr,valueFn,
@@ -667,7 +689,8 @@ double SGSolver_V3::iterate(const SGSolverMode mode, int & steps)
 	  
 	case SG_SOUTHWEST:
 	  // Decreasing currDirVar[0] and increasing currDirVar[1]
-	  tmp = xConstr.get(GRB_DoubleAttr_SARHSLow);
+	  model.getRHSRange(xConstr,rhsLow,rhsUp);
+	  tmp = rhsLow;
 	  currDir[0] = tmp;
 
 	  addBoundingHyperplane(currDir,xConstr,yConstr,valueFn,
@@ -693,7 +716,8 @@ double SGSolver_V3::iterate(const SGSolverMode mode, int & steps)
 	  
 	case SG_NORTHWEST:
 	  // Increasing currDirVar[0] and increasing currDirVar[1]
-	  tmp = yConstr.get(GRB_DoubleAttr_SARHSUp);
+	  model.getRHSRange(yConstr,rhsLow,rhsUp);
+	  tmp = rhsUp;
 	  currDir[1] = tmp;
 
 	  addBoundingHyperplane(currDir,xConstr,yConstr,valueFn,
@@ -726,7 +750,7 @@ double SGSolver_V3::iterate(const SGSolverMode mode, int & steps)
   // 	while (a != eqActions[s].end())
   // 	  {
   // 	    if (mode!=SG_FEASIBLE 
-  // 		&& (APSContValVar[ga].get(GRB_DoubleAttr_X)==-2*payoffBound) )
+  // 		&& (model.getValue(APSContValVar+ga)==-2*payoffBound) )
   // 	      {
   // 		eqActions[s].erase(a++);
   // 	      }
@@ -740,17 +764,6 @@ double SGSolver_V3::iterate(const SGSolverMode mode, int & steps)
   // cout << "Done with iteration!" << endl;
   // cout << "New threat tuple: " << newThreatTuple << endl;
   
-  delete [] valueFn;
-  delete [] contVals;
-  delete [] valueFunSlacks;
-  delete [] pseudoContVals;
-  delete [] recursiveContValSlacks;
-  delete [] APSContValSlacks;
-  delete [] APSContValVar;
-  delete [] feasMult;
-  delete [] ICMult;
-  delete [] currDirVar;
-
   double dist = 1.0;
   if (directions.size() == newDirections.size())
     {
@@ -783,13 +796,13 @@ double SGSolver_V3::iterate(const SGSolverMode mode, int & steps)
 } // iterate
 
 void SGSolver_V3::addBoundingHyperplane(SGPoint & currDir,
-					GRBConstr & xConstr,
-					GRBConstr & yConstr,
-					GRBVar * valueFn,
+					int xConstr,
+					int yConstr,
+					int valueFn,
 					int numStates,
 					list<SGPoint> & newDirections,
 					list< vector<double> > & newBounds,
-					GRBModel & model,
+					SGLP & model,
 					const bool addDirection)
 {
   int roundScale = 1e7;
@@ -797,14 +810,10 @@ void SGSolver_V3::addBoundingHyperplane(SGPoint & currDir,
   currDir.normalize();
   if (addDirection)
     {
-      xConstr.set(GRB_DoubleAttr_RHS,currDir[0]);
-      yConstr.set(GRB_DoubleAttr_RHS,currDir[1]);
-
-      // const double defaultLimit = model.getEnv().get(GRB_DoubleParam_IterationLimit);
-      // model.getEnv().set(GRB_DoubleParam_IterationLimit,1);
-      // model.optimize();
-      // model.getEnv().set(GRB_DoubleParam_IterationLimit,defaultLimit);
-      model.optimize();
+      model.setRHS(xConstr,currDir[0]);
+      model.setRHS(yConstr,currDir[1]);
+
+      model.solve();
       
       // currDir.roundPoint(1.0/roundScale);
 
@@ -831,7 +840,7 @@ void SGSolver_V3::addBoundingHyperplane(SGPoint & currDir,
 	  std::list<vector<double> >::const_reverse_iterator h1 = h0++;
 	  double distSum = 0;
 	  for (int s = 0; s < numStates; s++)
-	    distSum += abs(a*(*h0)[s]+b*(*h1)[s] - valueFn[s].get(GRB_DoubleAttr_X));
+	    distSum += abs(a*(*h0)[s]+b*(*h1)[s] - model.getValue(valueFn+s));
 	  // cout << "Checking for colinearity" << endl;
 	  // cout << distSum << endl;
 	  if (distSum < 1e-14)
@@ -847,7 +856,7 @@ void SGSolver_V3::addBoundingHyperplane(SGPoint & currDir,
       newBounds.push_back(vector<double>(numStates,0));
       for (int s = 0; s < numStates; s++)
 	{
-	  double tmp  = valueFn[s].get(GRB_DoubleAttr_X);
+	  double tmp  = model.getValue(valueFn+s);
 	  // tmp  = round(tmp*roundScale)/roundScale;
 	  assert(!isnan(tmp));
 	  newBounds.back()[s] = tmp;
@@ -857,8 +866,8 @@ void SGSolver_V3::addBoundingHyperplane(SGPoint & currDir,
   // SGPoint oldDir = currDir;
   currDir.rotateCW(minRotation);
   // cout << "Distance from rotation: " << setprecision(15) << SGPoint::distance(oldDir,currDir) << endl;
-  xConstr.set(GRB_DoubleAttr_RHS,currDir[0]);
-  yConstr.set(GRB_DoubleAttr_RHS,currDir[1]);
+  model.setRHS(xConstr,currDir[0]);
+  model.setRHS(yConstr,currDir[1]);
 } // addBoundingHyperlpane
 
 void SGSolver_V3::printIteration(ofstream & ofs, int numIter)
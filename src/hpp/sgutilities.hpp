@@ -23,6 +23,9 @@
 #define _SGUTILITIES_HPP
 
 #include "sgcommon.hpp"
+#include <thread>
+#include <atomic>
+#include <exception>
 /*! \file
   \ingroup src
  */
@@ -36,5 +39,118 @@ int indexToVector(int index,
 int vectorToIndex(const vector<int> & v,
 		  const vector<int> & sizes);
 
+//! Quotes a string for JSON output
+/*! Escapes quotes, backslashes, and control characters, so that
+    e.g. exception messages can be written as JSON strings. */
+string quoteJSON(const string & str);
+
+//! Quotes a string for CSV output
+/*! Doubles any quotes inside the string. */
+string quoteCSV(const string & str);
+
+//! Number of threads to use for numTasks tasks
+/*! numThreads is the requested number of threads, where zero or
+    less means one per hardware thread. The result is between 1 and
+    numTasks, so that callers can size per-thread storage before
+    calling runThreads or parallelFor. */
+int numWorkerThreads(int numThreads, int numTasks);
+
+//! Runs worker(thread) for thread = 0,...,numThreads-1 in parallel
+/*! Thread 0 runs on the calling thread and the others on new
+    threads, which are all joined before returning. An exception
+    thrown by a worker is caught on its thread, and once all of the
+    threads have finished, the exception of the lowest numbered
+    thread that threw is rethrown on the calling thread. */
+template<class Worker>
+void runThreads(int numThreads, Worker worker)
+{
+  vector<std::exception_ptr> errors(numThreads);
+  auto guardedWorker = [&](int thread)
+    {
+      try
+	{
+	  worker(thread);
+	}
+      catch (...)
+	{
+	  errors[thread] = std::current_exception();
+	}
+    };
+
+  vector<std::thread> threads;
+  for (int thread = 1; thread < numThreads; thread++)
+    threads.push_back(std::thread(guardedWorker,thread));
+  guardedWorker(0);
+  for (int thread = 0; thread < threads.size(); thread++)
+    threads[thread].join();
+
+  for (int thread = 0; thread < numThreads; thread++)
+    {
+      if (errors[thread])
+	std::rethrow_exception(errors[thread]);
+    }
+} // runThreads
+
+//! Runs task(k,thread) for k = 0,...,numTasks-1 on numThreads threads
+/*! Tasks often take different amounts of time, so rather than
+    splitting them into fixed blocks, each thread takes the next task
+    from a shared counter until there are none left. thread is the
+    number of the thread that runs the task, for indexing per-thread
+    storage. Once a task throws, no new tasks are started, and the
+    exception is rethrown as in runThreads. */
+template<class Task>
+void parallelFor(int numTasks, int numThreads, Task task)
+{
+  std::atomic<int> nextTask(0);
+  std::atomic<bool> failed(false);
+  runThreads(numThreads,[&](int thread)
+	     {
+	       try
+		 {
+		   int k;
+		   while (!failed && (k = nextTask++) < numTasks)
+		     task(k,thread);
+		 }
+	       catch (...)
+		 {
+		   failed = true;
+		   throw;
+		 }
+	     });
+} // parallelFor
+
+//! Stream buffer that reports how much of its source has been read
+/*! Wraps the stream buffer of an input stream with a known total
+    size, such as a file, and calls progress with the fraction of the
+    bytes read so far each time it refills its buffer, but only when
+    the fraction has moved by at least one percent. Used to report
+    the progress of boost deserialization, which reads its archive
+    sequentially.
+
+    \ingroup src
+ */
+class SGProgressStreambuf : public std::streambuf
+{
+private:
+  std::streambuf * source; /*!< The wrapped stream buffer. */
+  std::streamsize total; /*!< Total number of bytes in source. */
+  std::streamsize consumed; /*!< Bytes read from source so far. */
+  int lastPercent; /*!< Last percentage passed to progress. */
+  std::function<void(double)> progress; /*!< Progress callback. */
+  vector<char> buffer; /*!< Bytes read from source but not yet
+                          consumed. */
+
+protected:
+  //! Refills the buffer from source.
+  virtual int_type underflow();
+
+public:
+  //! Constructor
+  /*! total is the number of bytes that will be read from
+      source. */
+  SGProgressStreambuf(std::streambuf * _source,
+		      std::streamsize _total,
+		      const std::function<void(double)> & _progress);
+};
 
 #endif
@@ -100,13 +100,23 @@ SGGameHandler::SGGameHandler():
 
   payoffTableView = new SGTableView();
   payoffTableView->setSelectionMode(QAbstractItemView::ContiguousSelection);
-  probabilityTableViews = vector<SGTableView*>(1);
-  probabilityTableViews[0] = new SGTableView();
 
-  payoffModel = NULL;
+  probabilityTableView = new QTableView();
+  probabilityTableView->setSelectionMode(QAbstractItemView::ContiguousSelection);
+  probabilityTableView->setEditTriggers(QAbstractItemView::AllEditTriggers);
+  probabilityTableView->setSizePolicy(QSizePolicy::Expanding,
+				      QSizePolicy::Expanding);
+  probabilityTableView->horizontalHeader()
+    ->setSectionResizeMode(QHeaderView::Fixed);
+  probabilityTableView->horizontalHeader()->setDefaultSectionSize(65);
+  probabilityTableView->verticalHeader()
+    ->setSectionResizeMode(QHeaderView::Fixed);
+
+  sparseCheckBox = new QCheckBox(QString("Only show reachable states"));
+  sparseCheckBox->setToolTip(tr("Hide states that cannot be reached\nfrom the current state"));
 
-  probabilityTableLayout = new QVBoxLayout();
-  probabilityTableLayout->addWidget(probabilityTableViews[0]);
+  payoffModel = NULL;
+  probabilityModel = NULL;
 
   initializeModels();
 
@@ -202,19 +212,9 @@ SGGameHandler::SGGameHandler():
   payoffLayout->addWidget(new QLabel(tr("Stage payoffs:")));
   payoffLayout->addWidget(payoffTableView);
 
-  QScrollArea * probabilityScrollArea = new QScrollArea();
-  QWidget * probabilityWidget = new QWidget();
-
-  probabilityWidget->setLayout(probabilityTableLayout);
-  probabilityScrollArea->setWidget(probabilityWidget);
-
-  probabilityScrollArea->setWidgetResizable(true);
-  probabilityScrollArea->setSizePolicy(QSizePolicy::Expanding,
-				       QSizePolicy::Expanding);
-  probabilityScrollArea->setVerticalScrollBarPolicy(Qt::ScrollBarAlwaysOn);
-
   probabilityLayout->addWidget(new QLabel(tr("Transition probabilities:")));
-  probabilityLayout->addWidget(probabilityScrollArea);
+  probabilityLayout->addWidget(sparseCheckBox);
+  probabilityLayout->addWidget(probabilityTableView);
 
   tableLayout->addLayout(payoffLayout);
   tableLayout->addLayout(probabilityLayout);
@@ -254,6 +254,8 @@ SGGameHandler::SGGameHandler():
 
   connect(feasibleCheckBox,SIGNAL(stateChanged(int)),
 	  this,SLOT(setConstrained(int)));
+  connect(sparseCheckBox,SIGNAL(stateChanged(int)),
+	  this,SLOT(setSparse(int)));
 
   // qDebug() << "Finished sggamehandler constructor" << endl;
 
@@ -263,8 +265,8 @@ SGGameHandler::~SGGameHandler()
 {
   if (payoffModel != NULL)
     delete payoffModel;
-  for (int state = 0; state < game.getNumStates(); state++)
-    delete probabilityModels[state];
+  if (probabilityModel != NULL)
+    delete probabilityModel;
 }
 
 void SGGameHandler::setGame(const SGGame & _game)
@@ -311,6 +313,11 @@ void SGGameHandler::changeNumberOfStates(int newS)
 
 void SGGameHandler::initializeModels()
 {
+  // Detach the old models from the views before deleting them, so
+  // that the views do not use them in the meantime.
+  payoffTableView->setModel(NULL);
+  probabilityTableView->setModel(NULL);
+
   // Create new payoffModel
   delete payoffModel;
 
@@ -319,61 +326,14 @@ void SGGameHandler::initializeModels()
   payoffTableView->setModel(payoffModel);
   payoffTableView->resizeColumnsToContents();
 
-  // Now create new probabilityModels
-  for (int state = probabilityModels.size()-1;
-       state >= 0;
-       state --)
-    delete probabilityModels[state];
+  // Create new probabilityModel
+  delete probabilityModel;
 
-  // Clear out probabilityTableLayout
-  QLayoutItem * item;
-  while (item = probabilityTableLayout->takeAt(0))
-    delete item->widget();
-  
-  probabilityModels.clear();
-  probabilityTableViews.clear();
-
-  probabilityModels.reserve(game.getNumStates());
-  probabilityTableViews.reserve(game.getNumStates());
-
-  // Add new models/views
-  for (int state = 0;
-       state < game.getNumStates();
-       state++)
-    pushBackProbabilityTable(state);  
+  probabilityModel = new SGProbabilityTableModel(&game,0);
+  probabilityModel->setSparse(sparseCheckBox->isChecked());
+  probabilityTableView->setModel(probabilityModel);
 } // initializeModels
 
-
-void SGGameHandler::pushBackProbabilityTable(int newState)
-{
-  probabilityTableViews.push_back(new SGTableView());
-  probabilityTableViews.back()
-    ->verticalScrollBar()->setDisabled(true);
-  probabilityTableViews.back()
-    ->horizontalScrollBar()->setDisabled(true);
-
-  probabilityTableLayout->addWidget(new QLabel(QString("State ")
-					       +QString::number(newState)
-					       +QString(":")) );
-  probabilityTableLayout->addWidget(probabilityTableViews.back());
-
-  probabilityModels.push_back(new SGProbabilityTableModel(&game,0,newState));
-
-  probabilityTableViews.back()->setModel(probabilityModels.back());
-
-  probabilityTableViews.back()->resizeColumnsToContents();
-} // pushBackProbabilityTable
-
-void SGGameHandler::popBackProbabilityTable()
-{
-  delete probabilityModels.back();
-  probabilityModels.pop_back();
-
-  delete probabilityTableLayout->takeAt(probabilityTableLayout->count()-1)->widget();
-  delete probabilityTableLayout->takeAt(probabilityTableLayout->count()-1)->widget();
-  probabilityTableViews.pop_back();
-} // popBackProbabilityTable
-
 void SGGameHandler::setState(int state)
 {
   for (int player = 0; player < 2; player ++)
@@ -384,16 +344,8 @@ void SGGameHandler::setState(int state)
   payoffModel->emitLayoutChanged();
   payoffTableView->resizeColumnsToContents();
 
-  for (int nextState = 0; nextState < game.getNumStates(); nextState++)
-    {
-      probabilityModels[nextState]->setState(state);
-      probabilityModels[nextState]->emitLayoutChanged();
-
-      // sizeHint for the SGTableView objects has changed. Call
-      // updateGeometry.
-      probabilityTableViews[nextState]->resizeColumnsToContents();
-      probabilityTableViews[nextState]->updateGeometry();
-    }
+  probabilityModel->setState(state);
+  probabilityModel->refresh();
   
   disconnect(currentStateCombo,SIGNAL(currentIndexChanged(int)),
 	     this,SLOT(currentStateChanged(int)));
@@ -473,12 +425,7 @@ void SGGameHandler::actionAdded(int player)
   payoffModel->emitLayoutChanged();
   payoffTableView->resizeColumnToContents(newAction);
   // payoffTableView->updateGeometry();
-  for (int nextState = 0; nextState < game.getNumStates(); nextState++)
-    {
-      probabilityModels[nextState]->emitLayoutChanged();
-      probabilityTableViews[nextState]->resizeColumnToContents(newAction);
-      probabilityTableViews[nextState]->updateGeometry();
-    }
+  probabilityModel->refresh();
 }  // actionAdded
 
 void SGGameHandler::stateAdded()
@@ -487,7 +434,6 @@ void SGGameHandler::stateAdded()
   game.addState(newState);
   changeNumberOfStates(game.getNumStates());
   numStatesEdit->setText(QString::number(game.getNumStates()));
-  pushBackProbabilityTable(game.getNumStates()-1);
   
   setState(newState);
 } // stateAdded
@@ -524,11 +470,7 @@ void SGGameHandler::actionRemoved(int player)
 						   [state][player]));
 
   payoffModel->emitLayoutChanged();
-  for (int statep = 0; statep < game.getNumStates(); statep++)
-    {
-      probabilityModels[statep]->emitLayoutChanged();
-      probabilityTableViews[statep]->updateGeometry();
-    }
+  probabilityModel->refresh();
 }
 
 void SGGameHandler::stateRemoved()
@@ -538,8 +480,6 @@ void SGGameHandler::stateRemoved()
 
   int state = currentStateCombo->currentIndex();
 
-  popBackProbabilityTable();
-
   int newState;
   if (state > 0)
     newState = state-1;
@@ -569,3 +509,7 @@ void SGGameHandler::setConstrained(int newState)
     game.setConstrained(vector<bool>(2,false));
 }
 
+void SGGameHandler::setSparse(int newState)
+{
+  probabilityModel->setSparse(sparseCheckBox->isChecked());
+}
@@ -30,6 +30,25 @@ SGMainWindow::SGMainWindow()
   env->setParam(SG::PRINTTOCOUT,false);
 
   path = QString("./");
+
+  solverWorker = NULL;
+
+  // Solutions are loaded on a separate thread.
+  qRegisterMetaType< std::shared_ptr<const SGSolution> >();
+  loadProgressDialog = NULL;
+  solutionLoader = new SGSolutionLoader();
+  solutionLoader->moveToThread(&loaderThread);
+  connect(&loaderThread,SIGNAL(finished()),
+	  solutionLoader,SLOT(deleteLater()));
+  connect(this,SIGNAL(startLoad(QString)),
+	  solutionLoader,SLOT(load(QString)));
+  connect(solutionLoader,
+	  SIGNAL(loaded(std::shared_ptr<const SGSolution>,QString)),
+	  this,
+	  SLOT(solutionLoaded(std::shared_ptr<const SGSolution>,QString)));
+  connect(solutionLoader,SIGNAL(failed(QString,QString)),
+	  this,SLOT(solutionLoadFailed(QString,QString)));
+  loaderThread.start();
   
   gameHandler = new SGGameHandler();
 
@@ -156,6 +175,10 @@ SGMainWindow::SGMainWindow()
 
 void SGMainWindow::loadSolution()
 {
+  // Only one load at a time.
+  if (loadProgressDialog != NULL)
+    return;
+
   QString newPath = QFileDialog::getOpenFileName(this,tr("Select a solution file"),
 						 "./",
 						 tr("SGViewer solution files (*.sln)"));
@@ -164,37 +187,46 @@ void SGMainWindow::loadSolution()
   if (newPath.isEmpty())
     return;
 
-  qDebug() << "did I get to here? " << endl; 
-  path = newPath;
+  loadProgressDialog = new QProgressDialog(tr("Loading solution..."),
+					   QString(),0,100,this);
+  loadProgressDialog->setWindowModality(Qt::WindowModal);
+  loadProgressDialog->setMinimumDuration(500);
+  loadProgressDialog->setValue(0);
+  connect(solutionLoader,SIGNAL(progress(int)),
+	  loadProgressDialog,SLOT(setValue(int)));
 
-  try
-    {
-      QByteArray ba = newPath.toLocal8Bit();
-      const char * newPath_c = ba.data();
+  emit startLoad(newPath);
+} // loadSolution
 
-      SGSolution soln;
-      
-      SGSolution::load(soln,newPath_c);
+void SGMainWindow::solutionLoaded(std::shared_ptr<const SGSolution> soln,
+				  QString newPath)
+{
+  delete loadProgressDialog;
+  loadProgressDialog = NULL;
 
-      gameHandler->setGame(soln.getGame());
-      solutionHandler->setSolution(soln);
-      
-      tabWidget->setCurrentIndex(1);
+  path = newPath;
 
-      QFileInfo info(path);
+  gameHandler->setGame(soln->getGame());
+  solutionHandler->setSolution(soln);
       
-      QString newWindowTitle(tr("SGViewer - "));
-      newWindowTitle += info.fileName();
-      setWindowTitle(newWindowTitle);
+  tabWidget->setCurrentIndex(1);
+
+  QFileInfo info(path);
       
-    }
-  catch (...)
-    {
-      qDebug() << "Load solution didnt work :(" << endl;
-      QErrorMessage em(this);
-      em.showMessage(QString("Load solution didnt work :("));
-    }
-} // loadSolution
+  QString newWindowTitle(tr("SGViewer - "));
+  newWindowTitle += info.fileName();
+  setWindowTitle(newWindowTitle);
+} // solutionLoaded
+
+void SGMainWindow::solutionLoadFailed(QString newPath, QString message)
+{
+  delete loadProgressDialog;
+  loadProgressDialog = NULL;
+
+  qDebug() << "Load solution didnt work :(" << message << endl;
+  QErrorMessage em(this);
+  em.showMessage(QString("Load solution didnt work :("));
+} // solutionLoadFailed
 
 void SGMainWindow::saveSolution()
 {
@@ -312,6 +344,8 @@ void SGMainWindow::solveGame()
 	      solverWorker,SLOT(iterate()));
       connect(solverWorker,SIGNAL(resultReady(bool)),
       	      this,SLOT(iterationFinished(bool)));
+      connect(solverWorker,SIGNAL(revolutionsFinished(QString)),
+	      logTextEdit,SLOT(append(QString)));
       connect(solverWorker,SIGNAL(exceptionCaught()),
 	      this,SLOT(solverException()));
       solverThread.start();
@@ -331,6 +365,8 @@ void SGMainWindow::solveGame()
 void SGMainWindow::cancelSolve()
 {
   cancelSolveFlag = true;
+  if (solverWorker != NULL)
+    solverWorker->cancel();
 } // cancelSolve
 
 void SGMainWindow::iterationFinished(bool tf)
@@ -346,7 +382,9 @@ void SGMainWindow::iterationFinished(bool tf)
 	  str = solverWorker->getApprox().progressString();
 	  logTextEdit->append(QString(str.c_str()));
 	  logTextEdit->append(QString(""));
-	  logTextEdit->append(QString("Computation canceled."));
+	  logTextEdit->append(QString("Computation canceled after ")
+			      + QString::number(solverWorker->getNumIterations())
+			      + QString(" iterations."));
 
 	  tabWidget->setCurrentIndex(2);
 	  
@@ -354,12 +392,8 @@ void SGMainWindow::iterationFinished(bool tf)
 	}
       else
 	{
-	  if (solverWorker->getApprox().passedNorth())
-	    {
-	      string str = solverWorker->getApprox().progressString();
-	      logTextEdit->append(QString(str.c_str()));
-	    }
-
+	  // The worker has already sent the progress of the
+	  // revolutions in this batch, so just start the next one.
 	  emit startIteration();
 
 	  return;
@@ -418,6 +452,7 @@ void SGMainWindow::iterationFinished(bool tf)
   tabWidget->setCurrentIndex(1);
   
   delete solverWorker;
+  solverWorker = NULL;
 
 } // iterationFinished
 
@@ -426,6 +461,7 @@ void SGMainWindow::solverException()
   logTextEdit->append(QString("Unknown exception caught: Possibly no pure strategy equilibria exist."));
 
   delete solverWorker;
+  solverWorker = NULL;
 } // solverException
 
 void SGMainWindow::keyPressEvent(QKeyEvent * event)
@@ -42,11 +42,14 @@ SGPlotController::SGPlotController(QComboBox * _stateCombo,
 	  this,SLOT(changeMode(int)));
 } // Constructor
 
-void SGPlotController::setSolution(SGSolution * newSoln)
+void SGPlotController::setSolution(const SGSolution * newSoln,
+				   const SGSolutionLOD * newLOD)
 { 
   action=-1;
   state=-1;
   soln = newSoln; 
+  lod = newLOD;
+
   currentIter = soln->getIterations().end();
   --currentIter;
   iteration=currentIter->getIteration();
@@ -67,9 +70,7 @@ void SGPlotController::setSolution(SGSolution * newSoln)
   setSliderRanges(soln->getIterations().front().getIteration(),
 		  soln->getIterations().back().getIteration());
 
-  startOfLastRev = endIter;
-  while ((startOfLastRev--)->getRevolution()
-	 ==endIter->getRevolution()) {}
+  startOfLastRev = soln->findRevolution(endIter->getRevolution());
   
   mode = Progress;
   startSlider->setEnabled(mode==Progress);
@@ -149,12 +150,7 @@ bool SGPlotController::setIteration(int newIter)
       && newIter <= soln->getIterations().size())
     {
       iteration = newIter;
-      while (currentIter->getIteration() < iteration
-	     && currentIter != --(soln->getIterations().end()))
-	++currentIter;
-      while (currentIter->getIteration() > iteration
-	     && currentIter != soln->getIterations().begin())
-	--currentIter;
+      currentIter = soln->findIteration(iteration);
 
       setState(currentIter->getBestState());
       setAction(currentIter->getBestAction());
@@ -166,30 +162,25 @@ bool SGPlotController::setIteration(int newIter)
 
 void SGPlotController::setCurrentIteration(SGPoint point, int state)
 {
-  double minDistance = numeric_limits<double>::max();
+  int tuple = lod->nearestTuple(point,state,
+				startIter->getNumExtremeTuples()-1,
+				endIter->getNumExtremeTuples()-1);
 
-  int tupleC = 0;
-  
+  // The first iteration from startIter on that has more extreme
+  // tuples than the index of the nearest one.
   currentIter = startIter;
-  for (list<SGTuple>::const_iterator tuple = soln->getExtremeTuples().begin();
-       tuple != soln->getExtremeTuples().end();
-       ++tuple)
+  if (tuple >= 0)
     {
-      if (tupleC >= endIter->getNumExtremeTuples()-1)
-	break;
-      else if (tupleC >= startIter->getNumExtremeTuples()-1)
-	{
-	  double newDistance = ((*tuple)[state] - point)*((*tuple)[state] - point);
-	  if (newDistance < minDistance-1e-7)
-	    {
-	      minDistance = newDistance;
-	      while (currentIter->getNumExtremeTuples() <= tupleC)
-		currentIter++;
-	    } // if
-	} // if
-      
-      tupleC++;
-    } // for
+      const vector< list<SGIteration>::const_iterator > & iterIndex
+	= soln->getIterationIndex();
+      vector< list<SGIteration>::const_iterator >::const_iterator iter
+	= std::upper_bound(iterIndex.begin(),iterIndex.end(),tuple,
+			   [](int t, list<SGIteration>::const_iterator it)
+			   { return t < it->getNumExtremeTuples(); });
+      if (iter != iterIndex.end()
+	  && (*iter)->getIteration() > startIter->getIteration())
+	currentIter = *iter;
+    }
   
   setState(state);
   setAction(currentIter->getActionTuple()[state]);
@@ -205,14 +196,7 @@ void SGPlotController::synchronizeSliders()
   end = std::max(-1,std::max(start,end));
   iterSlider->setMinimum(std::max(start,-1));
   
-  while (currentIter->getIteration() < end
-	 && currentIter!=soln->getIterations().end())
-    ++currentIter;
-  while (currentIter->getIteration() > end
-	 && currentIter!=soln->getIterations().begin())
-    --currentIter;
-  if (currentIter == soln->getIterations().end())
-    --currentIter;
+  currentIter = soln->findIteration(end);
   
   if (mode==Progress)
     endIter = currentIter;
@@ -225,16 +209,7 @@ void SGPlotController::synchronizeSliders()
   if (start==-1)
     startIter = soln->getIterations().begin();
   else
-    {
-      while (startIter->getIteration() < start
-	     && startIter!=soln->getIterations().end())
-	++startIter;
-      while (startIter->getIteration() > start
-	     && startIter!=soln->getIterations().begin())
-	--startIter;
-      if (startIter == soln->getIterations().end())
-	--startIter;
-    }
+    startIter = soln->findIteration(start);
 
   if (currentIter == soln->getIterations().begin())
     currentIter++;
@@ -19,30 +19,81 @@
 // ben@benjaminbrooks.net
 // Chicago, IL
 
+
 #include <QtWidgets>
 #include "sgprobabilitytablemodel.hpp"
 
+void SGProbabilityTableModel::updateColumns()
+{
+  columns.clear();
+  if (!sparse)
+    return;
+
+  // Only the current state's rows are scanned.
+  vector<bool> reachable(game->getNumStates(),false);
+  const vector< vector<double> > & probabilities
+    = game->getProbabilities()[state];
+  for (int action = 0; action < probabilities.size(); action++)
+    {
+      for (int nextState = 0; nextState < probabilities[action].size();
+	   nextState++)
+	{
+	  if (probabilities[action][nextState] > 0)
+	    reachable[nextState] = true;
+	}
+    }
+  for (int nextState = 0; nextState < reachable.size(); nextState++)
+    {
+      if (reachable[nextState])
+	columns.push_back(nextState);
+    }
+} // updateColumns
+
 QVariant SGProbabilityTableModel::data(const QModelIndex & index,
 				  int role) const
 {
-  if (role == Qt::SizeHintRole)
-    return QSize(1,1);
-  else if (role == Qt::DisplayRole || role == Qt::EditRole)
+  if (role == Qt::DisplayRole || role == Qt::EditRole)
     {
-      int action = (index.column() * game->getNumActions()[state][0]
-		    + index.row() );
+      int action = index.row();
+      int nextState = getNextState(index.column());
 
-      assert(action < game->getNumActions()[state][0]
-	     *game->getNumActions()[state][1]);
+      assert(action < game->getNumActions_total()[state]);
       assert(nextState < game->getNumStates());
       assert(state < game->getNumStates());
-      
-      return QVariant(QString::number(game->getProbabilities()
-				      [state][action][nextState]));
+
+      double prob = game->getProbabilities()[state][action][nextState];
+      if (prob == 0 && role == Qt::DisplayRole)
+	return QVariant(QString(""));
+      return QVariant(QString::number(prob));
     }
   else
     return QVariant();
 } // data
+
+QVariant SGProbabilityTableModel::headerData(int section,
+					     Qt::Orientation orientation,
+					     int role) const
+{
+  if (role == Qt::DisplayRole)
+    {
+      switch (orientation)
+	{
+	case Qt::Horizontal:
+	  return QVariant(QString("State ")
+			  +QString::number(getNextState(section)));
+
+	case Qt::Vertical:
+	  {
+	    int numRows = game->getNumActions()[state][0];
+	    return QVariant(QString("R")
+			    +QString::number(section % numRows)
+			    +QString(" C")
+			    +QString::number(section / numRows));
+	  }
+	}
+    }
+  return QVariant();
+} // headerData
     
 bool SGProbabilityTableModel::setData(const QModelIndex & index,
 				      const QVariant & value, int role)
@@ -52,11 +103,10 @@ bool SGProbabilityTableModel::setData(const QModelIndex & index,
       QRegExp rx("[, ]");
       QStringList list = value.toString().split(rx,QString::SkipEmptyParts);
 
-      int action = (index.column() * game->getNumActions()[state][0]
-		    + index.row() );
+      int action = index.row();
+      int nextState = getNextState(index.column());
       
-      assert(action < game->getNumActions()[state][0]
-	     *game->getNumActions()[state][1]);
+      assert(action < game->getNumActions_total()[state]);
       assert(nextState < game->getNumStates());
       assert(state < game->getNumStates());
       
@@ -70,3 +120,15 @@ bool SGProbabilityTableModel::setData(const QModelIndex & index,
   return false;
 } // setData
 
+void SGProbabilityTableModel::setSparse(bool _sparse)
+{
+  sparse = _sparse;
+  refresh();
+} // setSparse
+
+void SGProbabilityTableModel::refresh()
+{
+  beginResetModel();
+  updateColumns();
+  endResetModel();
+} // refresh
@@ -79,6 +79,8 @@ SGSettingsHandler::SGSettingsHandler(QWidget * parent,
 		     new SGIntParamEdit(this,env,SG::TUPLERESERVESIZE));
   editLayout->addRow(QString("Store iterations:"),
 		     new SGIntParamEdit(this,env,SG::STOREITERATIONS));
+  editLayout->addRow(QString("Action elimination passes:"),
+		     new SGIntParamEdit(this,env,SG::PRUNEPASSES));
 
   // Construct and add boolean parameter edits.
   editLayout->addRow(QString("Merge tuples:"),
@@ -22,12 +22,12 @@
 #include "sgsimulationhandler.hpp"
 
 SGSimulationHandler::SGSimulationHandler(QWidget * parent, 
-					 const SGSolution & _soln,
+					 std::shared_ptr<const SGSolution> _soln,
 					 const SGPoint & _point,
 					 int _state)
   : QWidget(parent), soln(_soln), 
     point(_point), state(_state),
-    sim(soln)
+    sim(*soln)
 {
   setWindowFlags(Qt::Window);
   setWindowTitle(tr("SGViewer: Equilibrium simulation"));
@@ -60,13 +60,16 @@ SGSimulationHandler::SGSimulationHandler(QWidget * parent,
   controlLayout->addRow(new QLabel(tr("Number of periods:")),
 			iterationEdit);
 
-  QPushButton * simulateButton = new QPushButton(tr("Simulate"));
+  simulateButton = new QPushButton(tr("Simulate"));
+  cancelButton = new QPushButton(tr("Cancel"));
+  cancelButton->setEnabled(false);
 
   simEdit->setSizePolicy(QSizePolicy::Minimum,QSizePolicy::Maximum);
   iterationEdit->setSizePolicy(QSizePolicy::Minimum,QSizePolicy::Maximum);
   simulateButton->setSizePolicy(QSizePolicy::Maximum,QSizePolicy::Maximum);
+  cancelButton->setSizePolicy(QSizePolicy::Maximum,QSizePolicy::Maximum);
 
-  controlLayout->addRow(simulateButton);
+  controlLayout->addRow(simulateButton,cancelButton);
 
   QSplitter * editSplitter = new QSplitter();
   editSplitter->setOrientation(Qt::Vertical);
@@ -110,7 +113,7 @@ SGSimulationHandler::SGSimulationHandler(QWidget * parent,
   controlLayout->addRow(new QLabel(tr("Elapsed time (s):")),
 			timeEdit);
   
-  distrPlot = new SGSimulationPlot(soln.getGame().getNumStates());
+  distrPlot = new SGSimulationPlot(soln->getGame().getNumStates());
   distrPlot->setSizePolicy(QSizePolicy::Expanding,QSizePolicy::Expanding);
 
   QScrollArea * scrollArea = new QScrollArea();
@@ -137,16 +140,18 @@ SGSimulationHandler::SGSimulationHandler(QWidget * parent,
 	  this,SLOT(close()));
   connect(simulateButton,SIGNAL(clicked()),
 	  this,SLOT(simulate()));
+  connect(cancelButton,SIGNAL(clicked()),
+	  this,SLOT(cancelSimulation()));
 
   // Set up the simulator
   // Find the point that is closest for the given state.
   double minDistance = numeric_limits<double>::max();
 
-  for (list<SGIteration>::const_reverse_iterator iter = soln.getIterations().rbegin();
-       iter != soln.getIterations().rend();
+  for (list<SGIteration>::const_reverse_iterator iter = soln->getIterations().rbegin();
+       iter != soln->getIterations().rend();
        ++iter)
     {
-      if (iter->getRevolution() != soln.getIterations().back().getRevolution())
+      if (iter->getRevolution() != soln->getIterations().back().getRevolution())
 	break;
 
       double newDistance = ( (iter->getPivot()[state] - point)
@@ -162,6 +167,21 @@ SGSimulationHandler::SGSimulationHandler(QWidget * parent,
   sim.initialize();
   sim.setLogFlag(true);
 
+  simulating = false;
+  simWorker = new SGSimulationWorker(sim);
+  simWorker->moveToThread(&simThread);
+  connect(&simThread,SIGNAL(finished()),
+	  simWorker,SLOT(deleteLater()));
+  connect(this,SIGNAL(startSimulation(int,int,int,int)),
+	  simWorker,SLOT(simulate(int,int,int,int)));
+  connect(simWorker,SIGNAL(progress(int)),
+	  this,SLOT(simulationProgress(int)));
+  connect(simWorker,SIGNAL(finished(bool)),
+	  this,SLOT(simulationFinished(bool)));
+  connect(simWorker,SIGNAL(failed(QString)),
+	  this,SLOT(simulationFailed(QString)));
+  simThread.start();
+
   // Set up the plots
   stateBars = new QCPBars(distrPlot->xAxis,
 			  distrPlot->yAxis);
@@ -175,9 +195,9 @@ SGSimulationHandler::SGSimulationHandler(QWidget * parent,
   QVector<double> ticks;
   QVector<QString> labels;
   
-  int numStateTicks = min(soln.getGame().getNumStates(),20);
+  int numStateTicks = min(soln->getGame().getNumStates(),20);
 
-  for (int state = 0; state < soln.getGame().getNumStates(); state+=soln.getGame().getNumStates()/numStateTicks)
+  for (int state = 0; state < soln->getGame().getNumStates(); state+=soln->getGame().getNumStates()/numStateTicks)
     {
       ticks << state+1;
       labels << QString("S")+QString::number(state);
@@ -189,7 +209,7 @@ SGSimulationHandler::SGSimulationHandler(QWidget * parent,
   distrPlot->xAxis->setTickLabelRotation(60);
   distrPlot->xAxis->setSubTickCount(0);
   distrPlot->xAxis->setTickLength(0,4);
-  distrPlot->xAxis->setRange(0,soln.getGame().getNumStates()+1);
+  distrPlot->xAxis->setRange(0,soln->getGame().getNumStates()+1);
 
   // Tuple distribution
   distrPlot->plotLayout()
@@ -202,7 +222,7 @@ SGSimulationHandler::SGSimulationHandler(QWidget * parent,
   // Prep x axis with tuple labels
   QVector<double> tupleTicks;
   QVector<QString> tupleLabels;
-  int numTuplesInLastRev = soln.getIterations().size()-sim.getStartOfLastRev();
+  int numTuplesInLastRev = soln->getIterations().size()-sim.getStartOfLastRev();
   int numTupleTicks = min(numTuplesInLastRev,20);
   for (int tuple = 0; tuple < numTuplesInLastRev; 
        tuple+= numTuplesInLastRev/numTupleTicks)
@@ -222,12 +242,12 @@ SGSimulationHandler::SGSimulationHandler(QWidget * parent,
   tupleDistrRect->axis(QCPAxis::atBottom)->setSubTickCount(0);
   tupleDistrRect->axis(QCPAxis::atBottom)->setTickLength(0,4);
   tupleDistrRect->axis(QCPAxis::atBottom)->setRange(sim.getStartOfLastRev(),
-						    soln.getIterations().back().getIteration());
+						    soln->getIterations().back().getIteration());
 
   // Action distributions
-  actionBars = vector<QCPBars *>(soln.getGame().getNumStates());
-  actionDistrRects = vector<QCPAxisRect *>(soln.getGame().getNumStates());
-  for (int state = 0; state < soln.getGame().getNumStates(); state++)
+  actionBars = vector<QCPBars *>(soln->getGame().getNumStates());
+  actionDistrRects = vector<QCPAxisRect *>(soln->getGame().getNumStates());
+  for (int state = 0; state < soln->getGame().getNumStates(); state++)
     {
       distrPlot->plotLayout()->addElement(2*(state+2),0,
 					  new QCPPlotTitle(distrPlot,
@@ -240,10 +260,10 @@ SGSimulationHandler::SGSimulationHandler(QWidget * parent,
 
       QVector<double> actionTicks; 
       QVector<QString> actionLabels;
-      int numActionTicks = min(20,soln.getGame().getNumActions_total()[state]);
+      int numActionTicks = min(20,soln->getGame().getNumActions_total()[state]);
       for (int action = 0; 
-	   action < soln.getGame().getNumActions_total()[state];
-	   action += soln.getGame().getNumActions_total()[state]/numActionTicks)
+	   action < soln->getGame().getNumActions_total()[state];
+	   action += soln->getGame().getNumActions_total()[state]/numActionTicks)
 	{
 	  actionTicks << action+1;
 	  actionLabels << QString("A")+QString::number(action);
@@ -260,21 +280,94 @@ SGSimulationHandler::SGSimulationHandler(QWidget * parent,
       actionDistrRects[state]->axis(QCPAxis::atBottom)->setTickLabelRotation(60);
       actionDistrRects[state]->axis(QCPAxis::atBottom)->setSubTickCount(0);
       actionDistrRects[state]->axis(QCPAxis::atBottom)->setTickLength(0,4);
-      actionDistrRects[state]->axis(QCPAxis::atBottom)->setRange(0,soln.getGame().getNumActions_total()[state]+1);
+      actionDistrRects[state]->axis(QCPAxis::atBottom)->setRange(0,soln->getGame().getNumActions_total()[state]+1);
     } // for action
 } // constructor
 
 void SGSimulationHandler::simulate()
 {
-  QTime time;
+  if (simulating)
+    return;
+
+  simulating = true;
+  simulateButton->setEnabled(false);
+  cancelButton->setEnabled(true);
+  timeEdit->setText(QString(""));
+  failureMessage = QString("");
 
   time.start();
 
-  sim.simulate(simEdit->text().toInt(),
-	       iterationEdit->text().toInt(),
-	       state,initialTuple);
-  
-  SGPoint payoffs = sim.getLongRunPayoffs();
+  emit startSimulation(simEdit->text().toInt(),
+		       iterationEdit->text().toInt(),
+		       state,initialTuple);
+} // simulate
+
+void SGSimulationHandler::cancelSimulation()
+{
+  simWorker->cancel();
+} // cancelSimulation
+
+void SGSimulationHandler::simulationProgress(int numDone)
+{
+  vector<int> stateCounts, tupleCounts;
+  vector< vector<int> > actionCounts;
+  simWorker->getSnapshot(stateCounts,tupleCounts,actionCounts,numDone);
+
+  plotDistributions(stateCounts,tupleCounts,actionCounts);
+  timeEdit->setText(QString::number(time.elapsed()/1000.0)
+		    + QString(" (") + QString::number(numDone)
+		    + QString(" of ") + simEdit->text()
+		    + QString(" simulations)"));
+} // simulationProgress
+
+void SGSimulationHandler::simulationFinished(bool completed)
+{
+  // The simulation is over, so the simulator can be read directly.
+  simulating = false;
+  simulateButton->setEnabled(true);
+  cancelButton->setEnabled(false);
+
+  plotDistributions(sim.getStateDistr(),sim.getTupleDistr(),
+		    sim.getActionDistr());
+
+  textEdit->setText(QString::fromStdString(sim.getStringStream().str()));
+  transitionTableEdit->setText(QString::fromStdString(sim.getTransitionTableStringStream().str()));
+  QString timeString = QString::number(time.elapsed()/1000.0);
+  if (!failureMessage.isEmpty())
+    timeString += QString(" (failed: ") + failureMessage + QString(")");
+  else if (!completed)
+    timeString += QString(" (canceled)");
+  timeEdit->setText(timeString);
+} // simulationFinished
+
+void SGSimulationHandler::simulationFailed(QString message)
+{
+  failureMessage = message;
+} // simulationFailed
+
+void SGSimulationHandler::plotDistributions(const vector<int> & stateCounts,
+					    const vector<int> & tupleCounts,
+					    const vector< vector<int> > & actionCounts)
+{
+  if (stateCounts.empty())
+    return;
+
+  // Frequencies are relative to the number of periods simulated so
+  // far, which is less than the total while the simulation runs.
+  long numPeriods = 0;
+  for (int state = 0; state < stateCounts.size(); state++)
+    numPeriods += stateCounts[state];
+  if (numPeriods == 0)
+    return;
+
+  SGPoint payoffs(0.0,0.0);
+  for (int state = 0; state < soln->getGame().getNumStates(); state++)
+    {
+      for (int action = 0; action < soln->getGame().getNumActions_total()[state];
+	   action++)
+	payoffs += (1.0*actionCounts[state][action])/numPeriods
+	  * soln->getGame().getPayoffs()[state][action];
+    }
   longRunPayoffEdit->setText(QString("(")
 			     +QString::number(payoffs[0])
 			     +QString(",")
@@ -285,11 +378,11 @@ void SGSimulationHandler::simulate()
   QVector<double> stateDistr;
   QVector<double> ticks;
   double stateMax = 0.0;
-  for (int state = 0; state < soln.getGame().getNumStates(); state++)
+  for (int state = 0; state < soln->getGame().getNumStates(); state++)
     {
       ticks << state+1;
 
-      double tempProb = (1.0*sim.getStateDistr()[state])/(1.0*sim.getNumIter());
+      double tempProb = (1.0*stateCounts[state])/numPeriods;
       stateDistr << tempProb;
       stateMax = max(stateMax,tempProb);
     } // for state
@@ -300,9 +393,9 @@ void SGSimulationHandler::simulate()
   QVector<double> tupleDistr;
   QVector<double> tupleX;
   double tupleMax = 0.0;
-  for (int tuple = 0; tuple < sim.getTupleDistr().size(); tuple++)
+  for (int tuple = 0; tuple < tupleCounts.size(); tuple++)
     {
-      double tempProb = (1.0*sim.getTupleDistr()[tuple])/(1.0*sim.getNumIter());
+      double tempProb = (1.0*tupleCounts[tuple])/numPeriods;
       tupleDistr << tempProb;
       tupleX << sim.getStartOfLastRev()+tuple;
       tupleMax = max(tupleMax,tempProb);
@@ -312,18 +405,19 @@ void SGSimulationHandler::simulate()
   tupleBars->setData(tupleX,tupleDistr);
 
   // Action distributions
-  for (int state = 0; state < soln.getGame().getNumStates(); state++)
+  for (int state = 0; state < soln->getGame().getNumStates(); state++)
     {
       QVector<double> actionDistr;
       QVector<double> actionTicks; 
       double actionMax = 0.0;
 
-      for (int action = 0; action < soln.getGame().getNumActions_total()[state];
+      for (int action = 0; action < soln->getGame().getNumActions_total()[state];
 	   action++)
 	{
 	  actionTicks << action+1;
-	  double tempProb = (1.0*sim.getActionDistr()[state][action])/
-	    (1.0*sim.getStateDistr()[state]);
+	  double tempProb = (stateCounts[state] > 0
+			     ? (1.0*actionCounts[state][action])/stateCounts[state]
+			     : 0.0);
 	  actionDistr << tempProb;
 	  actionMax = max(actionMax,tempProb);
 	}
@@ -332,10 +426,5 @@ void SGSimulationHandler::simulate()
       actionBars[state]->setData(actionTicks,actionDistr);
     } // for action
 
-  textEdit->setText(QString::fromStdString(sim.getStringStream().str()));
-  transitionTableEdit->setText(QString::fromStdString(sim.getTransitionTableStringStream().str()));
-  timeEdit->setText(QString::number(time.elapsed()/1000.0));
-
   distrPlot->replot();
-  
-} // simulate
+} // plotDistributions
@@ -23,6 +23,7 @@
 
 SGSolutionHandler::SGSolutionHandler(QWidget * _parent): 
   parent(_parent),
+  soln(std::make_shared<const SGSolution>()),
   plotSettings()
 {
   // Set up the menu items. Added by SGMainWindow to the menubar.
@@ -159,7 +160,7 @@ SGSolutionHandler::SGSolutionHandler(QWidget * _parent):
   layout->addWidget(botSolutionPanel);
 } // constructor
 
-void SGSolutionHandler::setSolution(const SGSolution & newSoln)
+void SGSolutionHandler::setSolution(std::shared_ptr<const SGSolution> newSoln)
 {
   soln = newSoln;
   connect(detailPlot,SIGNAL(inspectPoint(SGPoint,int,bool)),
@@ -172,15 +173,15 @@ void SGSolutionHandler::setSolution(const SGSolution & newSoln)
     delete item->widget();
   
   statePlots.clear();
-  statePlots = vector<SGCustomPlot *>(soln.getGame().getNumStates());
+  statePlots = vector<SGCustomPlot *>(soln->getGame().getNumStates());
   
   SGPoint UB, LB;
-  soln.getGame().getPayoffBounds(UB,LB);
+  soln->getGame().getPayoffBounds(UB,LB);
   payoffBound = std::max(UB[0]-LB[0],
 			 UB[1]-LB[1]);
 
   for (int state = 0;
-       state < soln.getGame().getNumStates();
+       state < soln->getGame().getNumStates();
        state ++)
     {
       statePlots[state] =  new SGCustomPlot(state,false);
@@ -194,7 +195,8 @@ void SGSolutionHandler::setSolution(const SGSolution & newSoln)
       statePlotsLayout->addWidget(statePlots[state],state/2,state%2);
     }
 
-  controller->setSolution(&soln);
+  lod.setSolution(*soln);
+  controller->setSolution(soln.get(),&lod);
   
   solnLoaded = true;
 } // setSolution
@@ -213,7 +215,7 @@ void SGSolutionHandler::plotSolution()
 
   int end = endIter.getNumExtremeTuples()-1;
 
-  int numStates = soln.getGame().getNumStates();
+  int numStates = soln->getGame().getNumStates();
 
   detailPlot->clearPlottables();
   detailPlot->clearItems();
@@ -234,31 +236,12 @@ void SGSolutionHandler::plotSolution()
       const SGBaseAction & actionObject = pivotIter.getActions()[state][actionIndex];
 
       // Add expected set
-      QVector<double> expSetX(end-start),
-	expSetY(expSetX.size()),
-	expSetT(expSetX.size());
+      SGSolutionLOD::Polyline expSet;
+      lod.getExpectedPolyline(soln->getGame().getProbabilities()[state][action],
+			      start,end,expSet);
+      const QVector<double> & expSetX = expSet.x,
+	& expSetY = expSet.y, & expSetT = expSet.t;
 
-      int tupleC = 0;
-
-      for (list<SGTuple>::const_iterator tuple = soln.getExtremeTuples().begin();
-	   tuple != soln.getExtremeTuples().end();
-	   ++tuple)
-	{
-	  if (tupleC >= end)
-	    break;
-	  else if (tupleC >= start)
-	    {
-	      SGPoint expPoint
-		= tuple->expectation(soln.getGame().getProbabilities()
-				     [state][action]);
-	      expSetX[tupleC-start] = expPoint[0];
-	      expSetY[tupleC-start] = expPoint[1];
-	      expSetT[tupleC-start] = tupleC;
-	    }
-	  
-	  tupleC++;
-	}
-      
       QCPCurve * expCurve = new QCPCurve(detailPlot->xAxis,
 					 detailPlot->yAxis);
       expCurve->setData(expSetT,expSetX,expSetY);
@@ -269,12 +252,12 @@ void SGSolutionHandler::plotSolution()
       QCPRange xrange = getBounds(expSetX),
 	yrange = getBounds(expSetY);
 
-      SGPoint stagePayoffs = soln.getGame().getPayoffs()[state][action];
-      double delta = soln.getGame().getDelta();
+      SGPoint stagePayoffs = soln->getGame().getPayoffs()[state][action];
+      double delta = soln->getGame().getDelta();
       if (controller->getPlotMode() == SGPlotController::Directions)
 	{
 	  // Non-binding direction
-	  SGPoint expPivot = pivotIter.getPivot().expectation(soln.getGame().getProbabilities()
+	  SGPoint expPivot = pivotIter.getPivot().expectation(soln->getGame().getProbabilities()
 							 [state][action]);
 	  
 	  SGPoint nonBindingPayoff = (1-delta)*stagePayoffs + delta*expPivot;
@@ -404,33 +387,16 @@ void SGSolutionHandler::plotSolution(SGCustomPlot * plot, int state,
     start = controller->getStartIter().getNumExtremeTuples()-1;
   int end = controller->getEndIter().getNumExtremeTuples()-1;
 
-  QVector<double> x(end-start+1);
-  QVector<double> y(x.size());
-  QVector<double> t(x.size());
-  
   assert(end>=start);
 
-  int tupleC = 0;
-  
-  for (list<SGTuple>::const_iterator tuple = soln.getExtremeTuples().begin();
-       tuple != soln.getExtremeTuples().end();
-       ++tuple)
-    {
-      if (tupleC >= end)
-	break;
-      else if (tupleC >= start)
-	{
-	  x[tupleC-start] = (*tuple)[state][0];
-	  y[tupleC-start] = (*tuple)[state][1];
-	  t[tupleC-start] = tupleC;
-	}
-      
-      tupleC++;
-    }
+  SGSolutionLOD::Polyline line;
+  lod.getPolyline(state,start,end,line);
+  QVector<double> & x = line.x, & y = line.y, & t = line.t;
+
   const SGIteration & endIter = controller->getEndIter();
-  t[tupleC-start] = tupleC;
-  x[tupleC-start] = endIter.getPivot()[state][0];
-  y[tupleC-start] = endIter.getPivot()[state][1];
+  t.push_back(end);
+  x.push_back(endIter.getPivot()[state][0]);
+  y.push_back(endIter.getPivot()[state][1]);
   
   QCPRange xrange = getBounds(x),
     yrange = getBounds(y);
@@ -489,7 +455,7 @@ QString SGSolutionHandler::generatePlotTitle(int state, int action,
       if (action>-1)
 	{
 	  indexToVector(action,actions,
-			soln.getGame().getNumActions()[state]);
+			soln->getGame().getNumActions()[state]);
 	  titleString += QString(", (R");
 	  titleString += QString::number(actions[0]);
 	  titleString += QString(",C");
@@ -0,0 +1,304 @@
+// This file is part of the SGSolve library for stochastic games
+// Copyright (C) 2016 Benjamin A. Brooks
+//
+// SGSolve free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SGSolve is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see
+// <http://www.gnu.org/licenses/>.
+//
+// Benjamin A. Brooks
+// ben@benjaminbrooks.net
+// Chicago, IL
+
+#include "sgsolutionlod.hpp"
+
+void SGSolutionLOD::setSolution(const SGSolution & soln)
+{
+  numStates = soln.getGame().getNumStates();
+  numTuples = soln.getExtremeTuples().size();
+
+  levels = vector< vector<Polyline> > (numStates,vector<Polyline>(1));
+  for (int state = 0; state < numStates; state++)
+    {
+      Polyline & line = levels[state][0];
+      line.t.resize(numTuples);
+      line.x.resize(numTuples);
+      line.y.resize(numTuples);
+    }
+
+  int tupleC = 0;
+  for (list<SGTuple>::const_iterator tuple = soln.getExtremeTuples().begin();
+       tuple != soln.getExtremeTuples().end();
+       ++tuple)
+    {
+      for (int state = 0; state < numStates; state++)
+	{
+	  Polyline & line = levels[state][0];
+	  line.t[tupleC] = tupleC;
+	  line.x[tupleC] = (*tuple)[state][0];
+	  line.y[tupleC] = (*tuple)[state][1];
+	}
+      tupleC++;
+    } // for tuple
+
+  // Each level keeps every levelFactor-th point of the one below,
+  // until a level is small enough to be plotted in full.
+  for (int state = 0; state < numStates; state++)
+    {
+      vector<Polyline> & pyramid = levels[state];
+      while (pyramid.back().t.size() > maxPlotPoints)
+	{
+	  const Polyline & fine = pyramid.back();
+	  Polyline coarse;
+	  int numPoints = (fine.t.size()+levelFactor-1)/levelFactor;
+	  coarse.t.resize(numPoints);
+	  coarse.x.resize(numPoints);
+	  coarse.y.resize(numPoints);
+	  for (int j = 0; j < numPoints; j++)
+	    {
+	      coarse.t[j] = fine.t[j*levelFactor];
+	      coarse.x[j] = fine.x[j*levelFactor];
+	      coarse.y[j] = fine.y[j*levelFactor];
+	    }
+	  pyramid.push_back(coarse);
+	}
+    } // for state
+
+  grids = vector<Grid>(numStates);
+  for (int state = 0; state < numStates; state++)
+    buildGrid(levels[state][0],grids[state]);
+} // setSolution
+
+void SGSolutionLOD::buildGrid(const Polyline & line, Grid & grid)
+{
+  int numPoints = line.t.size();
+
+  grid.xmin = numeric_limits<double>::max();
+  grid.ymin = numeric_limits<double>::max();
+  double xmax = -numeric_limits<double>::max();
+  double ymax = -numeric_limits<double>::max();
+  for (int k = 0; k < numPoints; k++)
+    {
+      grid.xmin = std::min(grid.xmin,line.x[k]);
+      grid.ymin = std::min(grid.ymin,line.y[k]);
+      xmax = std::max(xmax,line.x[k]);
+      ymax = std::max(ymax,line.y[k]);
+    }
+  if (numPoints == 0)
+    {
+      grid.xmin = 0; grid.ymin = 0;
+      xmax = 0; ymax = 0;
+    }
+
+  // Aim for a couple of points per cell.
+  int side = std::max(1,std::min(1024,
+				 static_cast<int>(std::sqrt(numPoints/2.0))));
+  grid.numCols = side;
+  grid.numRows = side;
+  grid.cellWidth = (xmax > grid.xmin? (xmax-grid.xmin)/side: 1.0);
+  grid.cellHeight = (ymax > grid.ymin? (ymax-grid.ymin)/side: 1.0);
+
+  vector<int> cells(numPoints);
+  grid.cellStart.assign(side*side+1,0);
+  for (int k = 0; k < numPoints; k++)
+    {
+      int col = std::min(side-1,
+			 static_cast<int>((line.x[k]-grid.xmin)/grid.cellWidth));
+      int row = std::min(side-1,
+			 static_cast<int>((line.y[k]-grid.ymin)/grid.cellHeight));
+      cells[k] = row*side+col;
+      grid.cellStart[cells[k]+1]++;
+    }
+  for (int c = 0; c < side*side; c++)
+    grid.cellStart[c+1] += grid.cellStart[c];
+
+  // Filling in order of the tuples keeps each cell sorted.
+  vector<int> next(grid.cellStart.begin(),grid.cellStart.end()-1);
+  grid.cellIndex.resize(numPoints);
+  for (int k = 0; k < numPoints; k++)
+    grid.cellIndex[next[cells[k]]++] = k;
+} // buildGrid
+
+int SGSolutionLOD::selectLevel(int start, int end) const
+{
+  if (numStates == 0)
+    return 0;
+
+  int numLevels = levels[0].size();
+  int level = 0;
+  long stride = 1;
+  while (level+1 < numLevels
+	 && end-start > maxPlotPoints*stride)
+    {
+      level++;
+      stride *= levelFactor;
+    }
+  return level;
+} // selectLevel
+
+void SGSolutionLOD::getPolyline(int state, int start, int end,
+				Polyline & line) const
+{
+  vector<double> prob(numStates,0.0);
+  prob[state] = 1.0;
+  getExpectedPolyline(prob,start,end,line);
+} // getPolyline
+
+void SGSolutionLOD::getExpectedPolyline(const vector<double> & prob,
+					int start, int end,
+					Polyline & line) const
+{
+  line.t.clear();
+  line.x.clear();
+  line.y.clear();
+
+  start = std::max(start,0);
+  end = std::min(end,numTuples);
+  if (end <= start)
+    return;
+
+  int level = selectLevel(start,end);
+  int stride = 1;
+  for (int k = 0; k < level; k++)
+    stride *= levelFactor;
+
+  // Tuples of the range on the selected level, plus the first and
+  // last tuple of the range from the full trajectory.
+  vector<int> tuples;
+  if (start % stride != 0)
+    tuples.push_back(start);
+  for (int j = (start+stride-1)/stride; j*stride < end; j++)
+    tuples.push_back(j);
+  bool addLast = ((end-1) % stride != 0);
+
+  int numPoints = tuples.size() + addLast;
+  line.t.resize(numPoints);
+  line.x.resize(numPoints);
+  line.y.resize(numPoints);
+
+  int offset = (start % stride != 0);
+  for (int k = 0; k < tuples.size(); k++)
+    line.t[k] = (k < offset? start: tuples[k]*stride);
+  if (addLast)
+    line.t[numPoints-1] = end-1;
+  for (int k = 0; k < numPoints; k++)
+    {
+      line.x[k] = 0;
+      line.y[k] = 0;
+    }
+
+  for (int state = 0; state < numStates; state++)
+    {
+      double p = prob[state];
+      if (p == 0)
+	continue;
+
+      const Polyline & full = levels[state][0];
+      const Polyline & coarse = levels[state][level];
+      for (int k = 0; k < tuples.size(); k++)
+	{
+	  const Polyline & source = (k < offset? full: coarse);
+	  line.x[k] += p*source.x[tuples[k]];
+	  line.y[k] += p*source.y[tuples[k]];
+	}
+      if (addLast)
+	{
+	  line.x[numPoints-1] += p*full.x[end-1];
+	  line.y[numPoints-1] += p*full.y[end-1];
+	}
+    } // for state
+} // getExpectedPolyline
+
+int SGSolutionLOD::nearestTuple(const SGPoint & point, int state,
+				int start, int end) const
+{
+  start = std::max(start,0);
+  end = std::min(end,numTuples);
+  if (end <= start)
+    return -1;
+
+  const Polyline & line = levels[state][0];
+  double bestDistance = numeric_limits<double>::max();
+  int best = -1;
+  auto consider = [&](int k)
+    {
+      double dx = line.x[k]-point[0], dy = line.y[k]-point[1];
+      double distance = dx*dx+dy*dy;
+      if (distance < bestDistance
+	  || (distance == bestDistance && k < best))
+	{
+	  bestDistance = distance;
+	  best = k;
+	}
+    };
+
+  if (end-start <= linearSearchSize)
+    {
+      for (int k = start; k < end; k++)
+	consider(k);
+      return best;
+    }
+
+  // Search rings of cells around the point's cell. A cell in ring r
+  // is at least (r-1) cells away from the point, so the search stops
+  // once that distance exceeds the best one found.
+  const Grid & grid = grids[state];
+  int col = static_cast<int>(std::floor((point[0]-grid.xmin)/grid.cellWidth));
+  int row = static_cast<int>(std::floor((point[1]-grid.ymin)/grid.cellHeight));
+  col = std::max(0,std::min(grid.numCols-1,col));
+  row = std::max(0,std::min(grid.numRows-1,row));
+  double cellSize = std::min(grid.cellWidth,grid.cellHeight);
+
+  auto searchCell = [&](int c, int r)
+    {
+      if (c < 0 || c >= grid.numCols || r < 0 || r >= grid.numRows)
+	return;
+      int cell = r*grid.numCols+c;
+      vector<int>::const_iterator first
+	= grid.cellIndex.begin()+grid.cellStart[cell];
+      vector<int>::const_iterator last
+	= grid.cellIndex.begin()+grid.cellStart[cell+1];
+      for (first = std::lower_bound(first,last,start);
+	   first != last && *first < end;
+	   ++first)
+	consider(*first);
+    };
+
+  int maxRing = std::max(grid.numCols,grid.numRows);
+  for (int ring = 0; ring <= maxRing; ring++)
+    {
+      if (best >= 0 && ring > 0)
+	{
+	  double gap = (ring-1)*cellSize;
+	  if (gap*gap > bestDistance)
+	    break;
+	}
+
+      if (ring == 0)
+	{
+	  searchCell(col,row);
+	  continue;
+	}
+      for (int c = col-ring; c <= col+ring; c++)
+	{
+	  searchCell(c,row-ring);
+	  searchCell(c,row+ring);
+	}
+      for (int r = row-ring+1; r <= row+ring-1; r++)
+	{
+	  searchCell(col-ring,r);
+	  searchCell(col+ring,r);
+	}
+    } // for ring
+
+  return best;
+} // nearestTuple
@@ -59,8 +59,8 @@ private:
 
   //! The model for interfacing with payoffs
   SGPayoffTableModel* payoffModel;
-  //! Vector of models for interfacing with transition probabilities
-  vector<SGProbabilityTableModel*> probabilityModels;
+  //! The model for interfacing with transition probabilities
+  SGProbabilityTableModel* probabilityModel;
 
   //! Layout for the game tab.
   QVBoxLayout * layout;
@@ -87,14 +87,17 @@ private:
   // Tables
   //! Table for displaying stage payoffs
   QTableView * payoffTableView;
-  //! Vector of tables for displaying transition probabilities.
-  vector<SGTableView *> probabilityTableViews;
-  //! Layout for holding transition probability tables.
-  QVBoxLayout * probabilityTableLayout;
+  //! Table for displaying transition probabilities.
+  /*! Rows are action profiles and columns are tomorrow's
+      states. Sections have a fixed size, so the view never has to
+      measure cells that are off the screen. */
+  QTableView * probabilityTableView;
 
   // Check box  
   //! Check box for whether or not to calculate feasible set.
   QCheckBox * feasibleCheckBox;
+  //! Check box for only showing states that can be reached.
+  QCheckBox * sparseCheckBox;
 
 public:
   //! Constructor
@@ -139,11 +142,7 @@ private:
   //! Delete old data models and create new ones.
   /*! Called in constructor and whenever game changes. */
   void initializeModels();
-  //! Adds a new probability table model
-  void pushBackProbabilityTable(int newS);
-  //! Removes last probability table model
-  void popBackProbabilityTable();
-  //! Adds/removes models to achieve correct number of states.
+  //! Adds/removes states in the current state combo box.
   void changeNumberOfStates(int newS);
 				     
 private slots:
@@ -182,6 +181,8 @@ private slots:
 public slots:
   //! Changes whether or not feasible set will be calculated.
   void setConstrained(int newState);
+  //! Changes whether unreachable states are hidden.
+  void setSparse(int newState);
 
 };
 
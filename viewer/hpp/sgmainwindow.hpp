@@ -27,6 +27,7 @@
 #include "sggamehandler.hpp"
 #include "sgsolutionhandler.hpp"
 #include "sgsolverworker.hpp"
+#include "sgsolutionloader.hpp"
 #include "sgsettingshandler.hpp"
 #include "sg.hpp"
 #include "risksharing.hpp"
@@ -44,10 +45,11 @@ using namespace std;
     replicates the behavior of the SGSolver class in its solveGame
     routine. The reason is that SGSolver runs straight through. We
     want to provide updates in the log window as the solver proceeds,
-    which is facilitated by running SGSolverWorker one iteration at a
-    time, printing the output when each revolution finishes, and then
-    restarting the solve routine. Also allows the user to cancel a
-    computation when the next iteration finishes.
+    which is facilitated by running SGSolverWorker in short batches of
+    iterations, printing the output of the revolutions that finished
+    in each batch, and then restarting the solve routine. Also allows
+    the user to cancel a computation, which stops the worker before
+    its next iteration.
 
     \ingroup viewer
  */
@@ -64,10 +66,19 @@ private:
   SGEnv * env;
 
   //! Worker that handles solution.
+  /*! NULL when no computation is running. */
   SGSolverWorker * solverWorker;
   //! Separate thread for running solve routines, so gui doesn't hang.
   QThread solverThread;
 
+  //! Worker that loads solution files.
+  SGSolutionLoader * solutionLoader;
+  //! Separate thread for loading solutions, so gui doesn't hang.
+  QThread loaderThread;
+  //! Shows the progress of the current load.
+  /*! NULL when no solution is being loaded. */
+  QProgressDialog * loadProgressDialog;
+
   //! The object for interfacing with the solution.
   SGSolutionHandler * solutionHandler;
   //! The object for interfacing with the game.
@@ -82,7 +93,7 @@ private:
   //! Times progress of the algorithm.
   QTime timer;
 
-  //! Flag for canceling solve next time an iteration finishes.
+  //! Flag for canceling solve next time a batch finishes.
   bool cancelSolveFlag;
 
   //! Most recent path for saves/loads.
@@ -100,6 +111,8 @@ public:
   {
     solverThread.quit();
     solverThread.wait();
+    loaderThread.quit();
+    loaderThread.wait();
   }
   
 protected:
@@ -109,10 +122,19 @@ protected:
 signals:
   //! Signal for SGSolverThread to start next iteration.
   void startIteration();
+  //! Signal for SGSolutionLoader to load the solution in a file.
+  void startLoad(QString);
 					       
 private slots:
   //! Triggers a solution load
+  /*! The file is parsed by SGSolutionLoader on loaderThread, and
+      SGMainWindow::solutionLoaded is called when it is done. */
   void loadSolution();
+  //! Slot when SGSolutionLoader has loaded a solution.
+  void solutionLoaded(std::shared_ptr<const SGSolution> soln,
+		      QString newPath);
+  //! Slot when SGSolutionLoader could not load a solution.
+  void solutionLoadFailed(QString newPath, QString message);
   //! Triggers a solution save.
   void saveSolution();
   //! Triggers a game load.
@@ -136,12 +158,12 @@ private slots:
   void solveGame();
   //! Throws the cancel solution flag.
   void cancelSolve();
-  //! Slot when iteration finishes.
+  //! Slot when a batch of iterations finishes.
   /*! Checks if the algorithm has converged or if maximum number of
       iterations has finished. If the algorithm has finished, plots
       the solution. If the algorithm has not converged and the cancel
-      flag is false, the next iteration is started. If the cancel flag
-      is thrown, will not trigger the next iteration. */
+      flag is false, the next batch is started. If the cancel flag
+      is thrown, will not trigger the next batch. */
   void iterationFinished(bool);
   
   //! Triggers error message in log.
@@ -26,6 +26,7 @@
 #include <QComboBox>
 #include <QScrollBar>
 #include "sgsolution.hpp"
+#include "sgsolutionlod.hpp"
 
 //! Handles the plot settings for SGSolutionHandler
 /*! This class intermediates between the controllers (iterSlider,
@@ -72,7 +73,9 @@ private:
   int iteration;
 
   //! The current solution object
-  SGSolution * soln;
+  const SGSolution * soln;
+  //! Level of detail cache for soln, used for nearest point queries.
+  const SGSolutionLOD * lod;
   
   //! The current plot mode
   PlotMode plotMode;
@@ -138,7 +141,9 @@ public:
   //! Returns the current solution.
   const SGSolution * getSolution() const { return soln; }
   //! Sets the solution.
-  void setSolution(SGSolution * newSoln);
+  /*! newLOD has to have been built from newSoln. */
+  void setSolution(const SGSolution * newSoln,
+		   const SGSolutionLOD * newLOD);
   //! Sets the current state.
   bool setState(int newState);
   //! Sets the plot mode.
@@ -19,6 +19,7 @@
 // ben@benjaminbrooks.net
 // Chicago, IL
 
+
 #ifndef SGPROBABILITYTABLEMODEL_H
 #define SGPROBABILITYTABLEMODEL_H
 
@@ -26,55 +27,80 @@
 #include <QAbstractTableModel>
 #include <QTableView>
 #include "sggame.hpp"
-#include "sgpayofftablemodel.hpp"
+#include "sgtablemodel.hpp"
+
+/*! Model for the transition probabilities of the current state. Each
+    row is an action profile of the current state, and each column is
+    a state tomorrow, so SGGameHandler needs only one table for all of
+    the transition probabilities. Cells are read from the game
+    whenever the view asks for them, so the view only touches the
+    cells that are on the screen, and nothing has to be rebuilt when
+    actions or states are added.
 
-//! Reimplements SGPayoffTable model to specialize to probabilities.
-/*! An SGSolutionHandler object contains one of these objects for each
-    possible state tomorrow. The nextState member indicates which
-    state this object is associated with. 
+    Transitions in large games are typically sparse. Zero
+    probabilities are shown as blank cells, and when the model is
+    sparse, only the states that are reached with positive probability
+    from the current state get a column.
 
     \ingroup viewer
 */
-class SGProbabilityTableModel : public SGPayoffTableModel
+class SGProbabilityTableModel : public SGTableModel
 {
   Q_OBJECT
 
 private:
-  //! Tomorrow's state.
-  /*! This object interfaces with the probabilities of transitioning
-      to nextState tomorrow. */
-  int nextState;
+  //! True if only reachable states get a column.
+  bool sparse;
+  //! Tomorrow's state in each column, when the model is sparse.
+  vector<int> columns;
+
+  //! Recomputes SGProbabilityTableModel::columns.
+  void updateColumns();
 
 public:
   //! Constructor
-  /*! Constructor takes an additional argument, which is the nextState
-      whose transition probabilities this model will interface to. */
   SGProbabilityTableModel(SGGame * _game,
-			  int _state, int _nextState):
-    SGPayoffTableModel(_game,_state), nextState(_nextState)
+			  int _state):
+    SGTableModel(_game,_state), sparse(false)
   { }
 
+  //! Returns the number of action profiles in the current state.
+  int rowCount(const QModelIndex & parent = QModelIndex()) const Q_DECL_OVERRIDE
+  { return game->getNumActions_total()[state]; }
+  //! Returns the number of columns.
+  /*! This is the number of states, or the number of reachable states
+      if the model is sparse. */
+  int columnCount(const QModelIndex & parent = QModelIndex()) const Q_DECL_OVERRIDE
+  { return (sparse? columns.size(): game->getNumStates()); }
+
+  //! Returns tomorrow's state in the given column.
+  int getNextState(int column) const
+  { return (sparse? columns[column]: column); }
+
   //! Reimplements the data method
-  /*! Retrieves the probability of going to nextState from state, when
-      the action profile indicated by index is played. Retrieves the
-      data using SGGame::getProbabilities. */
+  /*! Retrieves the probability of going to the column's state from
+      state, when the row's action profile is played. */
   QVariant data(const QModelIndex & index,
 		int role) const Q_DECL_OVERRIDE;
+
+  //! Returns formatted header data
+  /*! Rows are labelled with the row and column players' actions, and
+      columns with tomorrow's state. */
+  QVariant headerData(int section,
+		      Qt::Orientation orientation,
+		      int role) const Q_DECL_OVERRIDE;
     
   //! Reimplements the setData method
-  /*! Sets the transition probability from state to nextState to
-      value, using SGGame::setProbability. */
+  /*! Sets the transition probability using SGGame::setProbability. */
   bool setData(const QModelIndex & index, const QVariant & value, int role);
 
-  //! Sets nextState
-  bool setNextState(int newState)
-  {
-    if (newState < 0 || newState > game->getNumStates())
-      return false;
-    nextState = newState;
-    return true;
-  }
-  
+  //! Sets whether only reachable states get a column.
+  void setSparse(bool _sparse);
+
+  //! Resets the model after the state or the game has changed.
+  /*! Recomputes the reachable states and tells the view that the
+      dimensions may have changed. */
+  void refresh();
 
 }; // SGProbabilityTableModel
 
@@ -26,8 +26,10 @@
 #include <QMenuBar>
 #include <QAction>
 #include <QFormLayout>
+#include <memory>
 #include "sg.hpp"
 #include "sgsimulator.hpp"
+#include "sgsimulationworker.hpp"
 #include "sgsimulationplot.hpp"
 #include "qcustomplot.h"
 
@@ -48,6 +50,10 @@
     distributions of tuples, states, actions, and average payoffs of
     the players over the course of the simulation. 
 
+    The simulations run on a separate thread through an
+    SGSimulationWorker, and the distributions are replotted as they
+    fill in. The user can cancel a simulation with the cancel button.
+
   \ingroup viewer
  */
 class SGSimulationHandler : public QWidget
@@ -55,8 +61,10 @@ class SGSimulationHandler : public QWidget
   Q_OBJECT;
 
 private:
-  //! Constant reference to the associated SGSolution object.
-  const SGSolution & soln;
+  //! The associated SGSolution object.
+  /*! Shared with SGSolutionHandler, so that the solution stays alive
+      while this window is open even if another one is loaded. */
+  std::shared_ptr<const SGSolution> soln;
   //! Discounted payoffs in the simulated equilibrium.
   /*! The widget will simulate an equilibrium that generates payoffs
       closest to this point. */
@@ -69,6 +77,23 @@ private:
   //! The initial tuple for the simulation.
   int initialTuple;
 
+  //! Runs the simulations on simThread.
+  SGSimulationWorker * simWorker;
+  //! Separate thread for running simulations.
+  QThread simThread;
+  //! True while a simulation is running.
+  bool simulating;
+  //! Times the current simulation.
+  QTime time;
+  //! Message of the exception that ended the current simulation.
+  /*! Empty unless the simulation failed. */
+  QString failureMessage;
+
+  //! Starts a simulation.
+  QPushButton * simulateButton;
+  //! Cancels the current simulation.
+  QPushButton * cancelButton;
+
   //! Displays the number of simulations to run.
   QLineEdit * simEdit;
   //! Displays the number of periods for which to simulate.
@@ -101,18 +126,49 @@ private:
 public:
   //! Constructor.
   SGSimulationHandler(QWidget * parent, 
-		      const SGSolution & _soln, 
+		      std::shared_ptr<const SGSolution> _soln, 
 		      const SGPoint & _point,
 		      int _state);
 
   //! Destructor.
-  virtual ~SGSimulationHandler() {}
+  /*! Cancels any running simulation and waits for the thread to
+      finish. */
+  virtual ~SGSimulationHandler()
+  {
+    simWorker->cancel();
+    simThread.quit();
+    simThread.wait();
+  }
+
+private:
+  //! Plots the distributions and the long run payoffs.
+  void plotDistributions(const vector<int> & stateCounts,
+			 const vector<int> & tupleCounts,
+			 const vector< vector<int> > & actionCounts);
+
+signals:
+  //! Signal for the SGSimulationWorker to start simulating.
+  void startSimulation(int numSim, int numIter,
+		       int initialState, int initialTuple);
 
 private slots:
   //! Triggers a new simulation
   /*! Causes the widget to run a new simulation for the number of
-      periods in iterationsEdit. */
+      periods in iterationsEdit. Returns immediately; the plots are
+      updated by SGSimulationHandler::simulationProgress and
+      SGSimulationHandler::simulationFinished. */
   void simulate();
+  //! Cancels the current simulation.
+  void cancelSimulation();
+  //! Replots the latest snapshot of the distributions.
+  void simulationProgress(int numDone);
+  //! Shows the final results of a simulation.
+  void simulationFinished(bool completed);
+  //! Records why a simulation failed.
+  /*! SGSimulationWorker emits failed before finished, so
+      SGSimulationHandler::simulationFinished shows the message in
+      timeEdit. */
+  void simulationFailed(QString message);
   
 };
 
@@ -0,0 +1,133 @@
+// This file is part of the SGSolve library for stochastic games
+// Copyright (C) 2016 Benjamin A. Brooks
+//
+// SGSolve free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SGSolve is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see
+// <http://www.gnu.org/licenses/>.
+//
+// Benjamin A. Brooks
+// ben@benjaminbrooks.net
+// Chicago, IL
+
+#ifndef SGSIMULATIONWORKER_HPP
+#define SGSIMULATIONWORKER_HPP
+
+#include <QtWidgets>
+#include <atomic>
+#include "sgsimulator.hpp"
+
+//! Class for running simulations within SGViewer
+/*! SGSimulationHandler moves this object to a separate thread and
+  starts simulations through the SGSimulationWorker::simulate slot,
+  so that the window stays responsive. The simulations themselves are
+  spread over all cores by SGSimulator::simulate. While they run, the
+  worker copies the distributions into a snapshot a few times per
+  second and emits progress, so the handler can plot the
+  distributions as they fill in. The simulation can be canceled at
+  any time with SGSimulationWorker::cancel.
+
+  \ingroup viewer
+*/
+class SGSimulationWorker : public QObject
+{
+  Q_OBJECT;
+
+private:
+  //! The simulator, which belongs to SGSimulationHandler.
+  SGSimulator & sim;
+  //! Set by SGSimulationWorker::cancel to stop the simulation.
+  std::atomic<bool> cancelFlag;
+
+  //! Protects the snapshot.
+  mutable QMutex snapshotMutex;
+  //! Copy of the state distribution.
+  vector<int> stateDistr;
+  //! Copy of the tuple distribution.
+  vector<int> tupleDistr;
+  //! Copy of the action distributions.
+  vector< vector<int> > actionDistr;
+  //! Number of simulations finished when the snapshot was taken.
+  int numDone;
+
+public:
+  //! Interval between snapshots, in milliseconds.
+  static const int progressMilliseconds = 200;
+
+  //! Constructor
+  SGSimulationWorker(SGSimulator & _sim):
+    sim(_sim), cancelFlag(false), numDone(0)
+  {}
+
+  //! Asks the worker to stop
+  /*! Safe to call from any thread. */
+  void cancel() { cancelFlag = true; }
+
+  //! Copies the latest snapshot of the distributions.
+  /*! Safe to call from any thread. */
+  void getSnapshot(vector<int> & _stateDistr,
+		   vector<int> & _tupleDistr,
+		   vector< vector<int> > & _actionDistr,
+		   int & _numDone) const
+  {
+    QMutexLocker locker(&snapshotMutex);
+    _stateDistr = stateDistr;
+    _tupleDistr = tupleDistr;
+    _actionDistr = actionDistr;
+    _numDone = numDone;
+  }
+
+public slots:
+  //! Runs the simulations.
+  /*! Emits progress with the number of finished simulations each
+      time a snapshot is taken, and finished when the simulations are
+      done, with true if none were canceled. If the simulator throws,
+      emits failed with the exception's message before finished. */
+  void simulate(int numSim, int numIter, int initialState, int initialTuple)
+  {
+    cancelFlag = false;
+    bool completed = false;
+    try
+      {
+	completed
+	  = sim.simulate(numSim,numIter,initialState,initialTuple,0,
+			 [this](int done)
+			 {
+			   {
+			     QMutexLocker locker(&snapshotMutex);
+			     stateDistr = sim.getStateDistr();
+			     tupleDistr = sim.getTupleDistr();
+			     actionDistr = sim.getActionDistr();
+			     numDone = done;
+			   }
+			   emit progress(done);
+			   return !cancelFlag;
+			 },
+			 progressMilliseconds);
+      }
+    catch (std::exception & e)
+      {
+	emit failed(QString(e.what()));
+      }
+    emit finished(completed);
+  } // simulate
+
+signals:
+  //! Signal that gets emitted when a new snapshot is available.
+  void progress(int);
+  //! Signal that gets emitted when the simulations end.
+  void finished(bool);
+  //! Signal that gets emitted with the message of a failed simulation.
+  void failed(QString);
+};
+
+#endif
@@ -22,11 +22,13 @@
 #ifndef SGSOLUTIONHANDLER_HPP
 #define SGSOLUTIONHANDLER_HPP
 
+#include <memory>
 #include "sgplotsettings.hpp"
 #include "sgsolution.hpp"
 #include "sgcustomplot.hpp"
 #include "sgsimulationhandler.hpp"
 #include "sgplotcontroller.hpp"
+#include "sgsolutionlod.hpp"
 #include "sgstatecombomodel.hpp"
 #include "sgactioncombomodel.hpp"
 
@@ -60,7 +62,9 @@
     a member SGPlotController object, which aggregates all of the
     user-provided specifications into a compact set of parameters that
     are used by SGSolutionHandler::plotSolution() to construct the
-    plots.
+    plots. The trajectories are drawn from an SGSolutionLOD, which is
+    built once when the solution is set, so that a redraw only
+    touches the tuples between the start and end iterations.
 
     See also \ref viewersolutionsec.
 
@@ -73,8 +77,11 @@ class SGSolutionHandler : public QObject
 private:
   //! Solution
   /*! Stores all of the information related to the result of the
-      computation. */
-  SGSolution soln;
+      computation. Shared with the SGSimulationHandler windows that
+      are opened from it, which can outlive it. */
+  std::shared_ptr<const SGSolution> soln;
+  //! Level of detail cache for plotting soln.
+  SGSolutionLOD lod;
   //! A pointer to the associated plot controller.
   SGPlotController * controller;
 
@@ -141,10 +148,11 @@ public:
   SGSolutionHandler(QWidget * parent = 0);
 
   //! Sets the solution to newSoln.
-  void setSolution(const SGSolution & newSoln);
+  /*! The solution is shared rather than copied. */
+  void setSolution(std::shared_ptr<const SGSolution> newSoln);
   //! Returns a const reference to the solution.
   const SGSolution & getSolution() const
-  {return soln;}
+  {return *soln;}
 
   //! Returns the layout
   QVBoxLayout * getLayout() const
@@ -0,0 +1,79 @@
+// This file is part of the SGSolve library for stochastic games
+// Copyright (C) 2016 Benjamin A. Brooks
+//
+// SGSolve free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SGSolve is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see
+// <http://www.gnu.org/licenses/>.
+//
+// Benjamin A. Brooks
+// ben@benjaminbrooks.net
+// Chicago, IL
+
+#ifndef SGSOLUTIONLOADER_HPP
+#define SGSOLUTIONLOADER_HPP
+
+#include <QtWidgets>
+#include <memory>
+#include "sgsolution.hpp"
+
+Q_DECLARE_METATYPE(std::shared_ptr<const SGSolution>)
+
+//! Class for loading solutions within SGViewer
+/*! Parsing a large solution file can take a long time, so
+  SGMainWindow moves this object to a separate thread and asks it to
+  load files through the SGSolutionLoader::load slot. The solution is
+  parsed directly into a shared pointer, which is passed to the main
+  process with the loaded signal and then shared with the handlers, so
+  the solution is never copied. Progress through the file is reported
+  with the progress signal. As with SGSolverWorker, communication
+  with SGMainWindow is through signals and slots.
+
+  \ingroup viewer
+*/
+class SGSolutionLoader : public QObject
+{
+  Q_OBJECT;
+
+public slots:
+  //! Loads the solution in the file path.
+  /*! Emits progress as the file is read, and then either loaded or
+      failed. */
+  void load(QString path)
+  {
+    try
+      {
+	QByteArray ba = path.toLocal8Bit();
+	std::shared_ptr<SGSolution> soln = std::make_shared<SGSolution>();
+
+	SGSolution::load(*soln,ba.data(),
+			 [this](double fraction)
+			 { emit progress(static_cast<int>(100*fraction)); });
+
+	emit loaded(std::shared_ptr<const SGSolution>(soln),path);
+      }
+    catch (std::exception & e)
+      {
+	emit failed(path,QString(e.what()));
+      }
+  } // load
+
+signals:
+  //! Percentage of the file that has been read.
+  void progress(int);
+  //! Signal that gets emitted when the solution in path is loaded.
+  void loaded(std::shared_ptr<const SGSolution> soln, QString path);
+  //! Signal that gets emitted when the file at path could not be loaded.
+  void failed(QString path, QString message);
+};
+
+#endif
@@ -0,0 +1,132 @@
+// This file is part of the SGSolve library for stochastic games
+// Copyright (C) 2016 Benjamin A. Brooks
+//
+// SGSolve free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SGSolve is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see
+// <http://www.gnu.org/licenses/>.
+//
+// Benjamin A. Brooks
+// ben@benjaminbrooks.net
+// Chicago, IL
+
+#ifndef SGSOLUTIONLOD_HPP
+#define SGSOLUTIONLOD_HPP
+
+#include <QVector>
+#include "sgsolution.hpp"
+
+//! Level of detail cache for plotting an SGSolution
+/*! The extreme tuples of an SGSolution are stored in a list, which
+    has to be walked from the beginning every time a range of tuples
+    is plotted. For solutions with millions of tuples, that makes
+    every redraw of SGSolutionHandler slow.
+
+    SGSolutionLOD copies the trajectory of the pivot in each state
+    into flat coordinate arrays once, when the solution is set, and
+    builds a pyramid of decimated polylines on top of them. Level k
+    of the pyramid keeps every levelFactor^k-th tuple. A range of
+    tuples is drawn from the coarsest level that still has at least
+    maxPlotPoints/levelFactor points in the range, so a redraw only
+    touches the tuples in the range and never more than roughly
+    maxPlotPoints of them. Expected continuation values are linear in
+    the tuples, so their curves are weighted sums of the states'
+    levels.
+
+    Nearest point queries for SGPlotController::setCurrentIteration
+    are served by a uniform grid over each state's pivots.
+
+    \ingroup viewer
+*/
+class SGSolutionLOD
+{
+public:
+  //! A polyline, in the format used by QCPCurve::setData.
+  struct Polyline
+  {
+    QVector<double> t; /*!< Index of the tuple of each point. */
+    QVector<double> x; /*!< Player 0's payoffs. */
+    QVector<double> y; /*!< Player 1's payoffs. */
+  };
+
+  //! Ratio of the number of points on successive levels.
+  static const int levelFactor = 4;
+  //! Target number of points in a plotted range.
+  static const int maxPlotPoints = 20000;
+  //! Ranges with fewer tuples than this are searched linearly.
+  static const int linearSearchSize = 4096;
+
+private:
+  //! Uniform grid of one state's pivots.
+  /*! Stored in compressed form: the tuples in cell c are
+      cellIndex[cellStart[c]] to cellIndex[cellStart[c+1]-1], in
+      increasing order. */
+  struct Grid
+  {
+    double xmin; /*!< Left edge of the grid. */
+    double ymin; /*!< Bottom edge of the grid. */
+    double cellWidth; /*!< Width of each cell. */
+    double cellHeight; /*!< Height of each cell. */
+    int numCols; /*!< Number of columns of cells. */
+    int numRows; /*!< Number of rows of cells. */
+    vector<int> cellStart; /*!< Offset of each cell in cellIndex. */
+    vector<int> cellIndex; /*!< Tuples sorted by cell. */
+  };
+
+  //! Number of states.
+  int numStates;
+  //! Number of extreme tuples.
+  int numTuples;
+  //! Decimated polylines.
+  /*! levels[state][k] keeps every levelFactor^k-th tuple, so
+      levels[state][0] is the whole trajectory. */
+  vector< vector<Polyline> > levels;
+  //! One grid for each state.
+  vector<Grid> grids;
+
+  //! Returns the level to use for the tuples in [start,end).
+  int selectLevel(int start, int end) const;
+  //! Builds the grid for one state.
+  static void buildGrid(const Polyline & line, Grid & grid);
+
+public:
+  //! Default constructor
+  SGSolutionLOD(): numStates(0), numTuples(0) {}
+
+  //! Rebuilds the cache for a new solution.
+  void setSolution(const SGSolution & soln);
+
+  //! Number of extreme tuples in the solution.
+  int getNumTuples() const { return numTuples; }
+
+  //! Returns the pivot in state as a polyline over [start,end).
+  /*! The first and last tuple of the range are always included. */
+  void getPolyline(int state, int start, int end,
+		   Polyline & line) const;
+
+  //! Returns the expectation of the pivot as a polyline over [start,end).
+  /*! prob are the transition probabilities of an action, and each
+      point is SGTuple::expectation of the corresponding tuple. The
+      same tuples are used as in SGSolutionLOD::getPolyline. */
+  void getExpectedPolyline(const vector<double> & prob,
+			   int start, int end,
+			   Polyline & line) const;
+
+  //! Index of the tuple in [start,end) whose pivot in state is closest to point.
+  /*! Ties go to the earliest tuple. Returns -1 if the range is
+      empty. */
+  int nearestTuple(const SGPoint & point, int state,
+		   int start, int end) const;
+
+}; // SGSolutionLOD
+
+#endif
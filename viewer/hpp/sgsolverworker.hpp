@@ -23,6 +23,8 @@
 #define SGSOLVERWORKER_HPP
 
 #include <QtWidgets>
+#include <atomic>
+#include <memory>
 #include "sg.hpp"
 #include "sgapprox.hpp"
 
@@ -35,10 +37,16 @@
 
   This class uses SGApprox to calculate the solution. The main program
   assigns this object to a separate thread to preserve responsiveness
-  of the algorithm. After each iteration, control is returned to the
-  main process, which prints a status update if a revolution has been
-  completed and cancels the algorithm if the cancel flag has been
-  thrown. Communication between the SGSolverWorker and SGMainWindow is
+  of the algorithm. Each call to SGSolverWorker::iterate runs a batch
+  of iterations, which ends after SGSolverWorker::batchMilliseconds
+  or SGSolverWorker::batchIterations, whichever comes first, and then
+  returns control to the main process. The progress strings for the
+  revolutions completed during the batch are sent with the
+  revolutionsFinished signal, so the log window is updated at most
+  once per batch rather than once per iteration. The main process
+  can cancel the computation at any time with SGSolverWorker::cancel,
+  which the worker checks before each iteration. Communication
+  between the SGSolverWorker and SGMainWindow is otherwise
   facilitated by signals and slots.
 
   \ingroup viewer
@@ -51,13 +59,27 @@ private:
   //! An environment object to hold settings.
   const SGEnv & env;
   //! Solution object used by SGApprox.
-  SGSolution soln;
+  /*! Held in a shared pointer so that it can be handed to
+      SGSolutionHandler without a copy when the computation ends. */
+  std::shared_ptr<SGSolution> soln;
   //! The main object for performing calculations
   SGApprox approx;
   //! A pointer to the text edit in which to report progress.
   QTextEdit * logTextEdit;
 
+  //! Set by SGSolverWorker::cancel to stop the current batch.
+  std::atomic<bool> cancelFlag;
+  //! Number of iterations completed so far.
+  /*! Updated by the worker thread after each iteration, so the main
+      process can read it while a batch is running. */
+  std::atomic<long> numIterations;
+
 public:
+  //! Maximum wall time of one batch, in milliseconds.
+  static const int batchMilliseconds = 50;
+  //! Maximum number of iterations in one batch.
+  static const int batchIterations = 10000;
+
   //! Code for status at the end of the iteration.
   enum STATUS
     {
@@ -75,8 +97,10 @@ public:
   SGSolverWorker(const SGEnv & _env,
 		 const SGGame & game,
 		 QTextEdit * _logTextEdit):
-    env(_env), soln(game), approx(env,game,soln),
-    logTextEdit(_logTextEdit)
+    env(_env), soln(std::make_shared<SGSolution>(game)),
+    approx(env,game,*soln),
+    logTextEdit(_logTextEdit),
+    cancelFlag(false), numIterations(0)
   {
     approx.initialize();
   } // constructor
@@ -84,57 +108,85 @@ public:
   //! Returns the status of the worker
   STATUS getStatus() const { return status; }
 
+  //! Asks the worker to stop
+  /*! Safe to call from any thread. The current batch ends before its
+      next iteration and emits resultReady with the status
+      NOTCONVERGED. */
+  void cancel() { cancelFlag = true; }
+
+  //! Returns true if SGSolverWorker::cancel has been called.
+  bool canceled() const { return cancelFlag; }
+
+  //! Returns the number of iterations completed so far.
+  /*! Safe to call from any thread. */
+  long getNumIterations() const { return numIterations; }
+
 public slots:
 
   //! Iterates. 
-  /*! Runs one iteration of the twist algorithm and emits the
-      resultReady signal. */
+  /*! Runs a batch of iterations of the twist algorithm and emits the
+      resultReady signal. The batch stops early if the algorithm
+      converges, fails, or is canceled. */
   void iterate()
   {
+    QElapsedTimer batchTimer;
+    batchTimer.start();
+    QStringList progress;
+
     try
       {
-	// Add the extreme tuples array to soln.
-	if (approx.getNumIterations()==0)
-	  {
-	    for (vector<SGTuple>::const_iterator tuple
-	    	   = approx.getExtremeTuples().begin();
-	    	 tuple != approx.getExtremeTuples().end();
-	    	 ++tuple)
-	      soln.push_back(*tuple);
-	  }
-	else
-	  soln.push_back(approx.getExtremeTuples().back());
-	
-	if (approx.generate() > env.getParam(SG::ERRORTOL)
-	    && approx.getNumIterations() < env.getParam(SG::MAXITERATIONS))
-	  {
-	    status = NOTCONVERGED;
-	    emit resultReady(false);
-	  }
-	else
+	status = NOTCONVERGED;
+	for (int iter = 0;
+	     iter < batchIterations
+	       && batchTimer.elapsed() < batchMilliseconds
+	       && !cancelFlag;
+	     iter++)
 	  {
-	    approx.end();
-	    
-	    status = CONVERGED;
-	    emit resultReady(true);
-	  }
+	    // Add the extreme tuples array to soln.
+	    if (approx.getNumIterations()==0)
+	      {
+		for (vector<SGTuple>::const_iterator tuple
+		       = approx.getExtremeTuples().begin();
+		     tuple != approx.getExtremeTuples().end();
+		     ++tuple)
+		  soln->push_back(*tuple);
+	      }
+	    else
+	      soln->push_back(approx.getExtremeTuples().back());
+
+	    double error = approx.generate();
+	    numIterations = approx.getNumIterations();
+
+	    if (error <= env.getParam(SG::ERRORTOL)
+		|| approx.getNumIterations()
+		>= env.getParam(SG::MAXITERATIONS))
+	      {
+		approx.end();
+		status = CONVERGED;
+		break;
+	      }
+
+	    if (approx.passedNorth())
+	      progress << QString(approx.progressString().c_str());
+	  } // for iter
       }
     catch (exception & e)
       {
-	// Add the extreme tuples array to soln.
 	qDebug() << "solve failed" << endl;
 
 	approx.end();
 	
 	status = FAILED;
-	emit resultReady(true);
-	
-	// emit exceptionCaught();
       }
+
+    if (!progress.isEmpty())
+      emit revolutionsFinished(progress.join("\n"));
+    emit resultReady(status != NOTCONVERGED);
   } // iterate
 
   //! Returns the SGSolution object.
-  const SGSolution & getSolution() const
+  /*! Only safe to use once the computation has ended. */
+  std::shared_ptr<const SGSolution> getSolution() const
   { return soln; }
 
   //! Returns the SGApprox object.
@@ -142,8 +194,10 @@ public slots:
   { return approx; }
   
 signals:
-  //! Signal that gets emitted when iteration finishes.
+  //! Signal that gets emitted when a batch of iterations finishes.
   void resultReady(bool);
+  //! Sends the progress strings of the revolutions completed in a batch.
+  void revolutionsFinished(QString);
   //! Signal that gets emitted when an exception is caught.
   /*! Not currently used. */
   void exceptionCaught();  
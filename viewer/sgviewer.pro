@@ -46,11 +46,14 @@ sgprobabilitytablemodel.hpp \
 sgpayofftablemodel.hpp \
 sgsolutionhandler.hpp \
 sgsolverworker.hpp \
+sgsolutionloader.hpp \
 sgcustomplot.hpp \
 sgsimulationhandler.hpp \
+sgsimulationworker.hpp \
 sgsimulationplot.hpp \
 sgsettingshandler.hpp \
 sgplotcontroller.hpp \
+sgsolutionlod.hpp \
 sgstatecombomodel.hpp \
 sgactioncombomodel.hpp \
 sgrisksharinghandler.hpp \
@@ -70,6 +73,7 @@ sgpayofftablemodel.cpp \
 sgsimulationhandler.cpp \
 sgsolutionhandler.cpp \
 sgplotcontroller.cpp \
+sgsolutionlod.cpp \
 sgsettingshandler.cpp \
 sglegend.cpp
 